@@ -0,0 +1,82 @@
+#include "F1_Aero.h"
+#include <cmath>
+
+AeroMap::AeroMap(const std::vector<double>& speeds, const std::vector<double>& ride_heights)
+    : speeds(speeds), heights(ride_heights) {
+    for (std::size_t i = 0; i + 1 < speeds.size(); i++) {
+        inv_speed_step.push_back(1.0 / (speeds[i + 1] - speeds[i]));
+    }
+    for (std::size_t j = 0; j + 1 < heights.size(); j++) {
+        inv_height_step.push_back(1.0 / (heights[j + 1] - heights[j]));
+    }
+    closed.resize(speeds.size() * heights.size());
+    open.resize(speeds.size() * heights.size());
+    closed_balance.resize(speeds.size() * heights.size(), 0.5);
+    open_balance.resize(speeds.size() * heights.size(), 0.5);
+}
+
+void AeroMap::setPoint(int speed_index, int height_index, bool drs_open, const AeroCoefficients& point) {
+    int index = height_index * speedCount() + speed_index;
+    (drs_open ? open : closed)[index] = {point.drag, point.lift};
+    (drs_open ? open_balance : closed_balance)[index] = point.balance;
+}
+
+double AeroMap::balance(double speed, double ride_height, bool drs_open) const {
+    const int row = speedCount();
+    const int last_speed_cell = row - 2;
+    const int last_height_cell = heightCount() - 2;
+    speed = std::min(std::max(speed, speeds[0]), speeds[last_speed_cell + 1]);
+    ride_height = std::min(std::max(ride_height, heights[0]), heights[last_height_cell + 1]);
+    
+    const int i = findCell(speeds, speed, 0, last_speed_cell);
+    const int j = findCell(heights, ride_height, 0, last_height_cell);
+    double u = (speed - speeds[i]) * inv_speed_step[i];
+    double w = (ride_height - heights[j]) * inv_height_step[j];
+    
+    const std::vector<double>& table = drs_open ? open_balance : closed_balance;
+    return (1.0 - u) * (1.0 - w) * table[j * row + i] + u * (1.0 - w) * table[j * row + i + 1]
+         + (1.0 - u) * w * table[(j + 1) * row + i] + u * w * table[(j + 1) * row + i + 1];
+}
+
+AeroMap AeroMap::groundEffectCar(double base_drag, double base_lift, double reference_height) {
+    std::vector<double> speeds, heights;
+    for (int i = 0; i <= 10; i++) {
+        speeds.push_back(10.0 * i);                 // 0..100 м/с
+    }
+    for (int j = 1; j <= 16; j++) {
+        heights.push_back(0.005 * j);               // 5..80 мм
+    }
+    AeroMap map(speeds, heights);
+    
+    // Ниже stall_height поток под днищем срывается и прижим падает
+    const double stall_height = 0.4 * reference_height;
+    auto groundEffect = [&](double h) {
+        double above = 1.0 + 0.5 * (reference_height - std::max(h, stall_height)) / reference_height;
+        double stall = h < stall_height ? 1.0 - 0.5 * (stall_height - h) / stall_height : 1.0;
+        return above * stall;
+    };
+    
+    for (int j = 0; j < map.heightCount(); j++) {
+        double h = heights[j];
+        for (int i = 0; i < map.speedCount(); i++) {
+            // Слабая зависимость от числа Рейнольдса: на малой скорости чуть хуже
+            double gain = groundEffect(h) * (0.97 + 0.03 * speeds[i] / 100.0);
+            
+            AeroCoefficients closed_point;
+            closed_point.lift = base_lift * gain;
+            closed_point.drag = base_drag * (1.0 + 0.2 * (gain - 1.0));
+            closed_point.balance = std::clamp(0.40 + 0.08 * (reference_height - h) / reference_height, 0.30, 0.50);
+            map.setPoint(i, j, false, closed_point);
+            
+            // DRS: заднее крыло теряет треть прижима, сопротивление - на 18% меньше
+            double front = closed_point.lift * closed_point.balance;
+            double rear = closed_point.lift * (1.0 - closed_point.balance) * 0.65;
+            AeroCoefficients open_point;
+            open_point.lift = front + rear;
+            open_point.drag = closed_point.drag * 0.82;
+            open_point.balance = front / open_point.lift;
+            map.setPoint(i, j, true, open_point);
+        }
+    }
+    return map;
+}
@@ -0,0 +1,126 @@
+#ifndef F1_AERO_H
+#define F1_AERO_H
+
+#include <algorithm>
+#include <vector>
+
+// Аэродинамические коэффициенты в узле карты
+struct AeroCoefficients {
+    double drag = 0.0;          // Cd
+    double lift = 0.0;          // Cl (< 0 - прижимная сила)
+    double balance = 0.5;       // Доля прижимной силы на передней оси [0..1]
+};
+
+// То, что нужно шагу физики: Cd и Cl (баланс шаг не читает)
+struct AeroDragLift {
+    double drag = 0.0;
+    double lift = 0.0;
+};
+
+// Аэродинамическая карта: Cd, Cl и баланс по сетке скорость x клиренс,
+// отдельно для закрытого и открытого DRS. Между узлами - билинейно, за
+// краями сетки - значение на краю.
+//
+// Считается заранее для машины; в цикле физики - поиск ячейки от прошлой
+// (Cursor): за шаг скорость и клиренс почти не меняются, и ячейка
+// та же или соседняя, поэтому поиск - одно-два сравнения на ось.
+class AeroMap {
+public:
+    // Ячейка прошлого вычисления. Своя у каждой машины; можно не сбрасывать
+    // при смене карты - индекс только подсказка, поиск его поправит
+    struct Cursor {
+        int speed_cell = 0;
+        int height_cell = 0;
+    };
+    
+    // Оси по возрастанию, не меньше двух узлов на ось [м/с], [м]
+    AeroMap(const std::vector<double>& speeds, const std::vector<double>& ride_heights);
+    
+    // Узел (speed_index, height_index); drs_open - таблица с открытым DRS
+    void setPoint(int speed_index, int height_index, bool drs_open, const AeroCoefficients& point);
+    
+    // Cd и Cl: билинейная интерполяция с поиском ячейки от cursor (cursor обновляется)
+    AeroDragLift evaluate(double speed, double ride_height, bool drs_open, Cursor& cursor) const;
+    
+    // Баланс по запросу (для отображения): та же интерполяция, поиск с начала оси
+    double balance(double speed, double ride_height, bool drs_open) const;
+    
+    int speedCount() const { return static_cast<int>(speeds.size()); }
+    int heightCount() const { return static_cast<int>(heights.size()); }
+    double speedAt(int index) const { return speeds[index]; }
+    double heightAt(int index) const { return heights[index]; }
+    
+    // Типовая карта болида с граунд-эффектом вокруг базовых коэффициентов:
+    // прижим растет при снижении клиренса до срыва потока у самой земли,
+    // сопротивление растет вместе с прижимом (индуктивное), открытый DRS
+    // снимает часть сопротивления и прижима заднего крыла (баланс - вперед).
+    // base_drag/base_lift - коэффициенты на reference_height.
+    static AeroMap groundEffectCar(double base_drag, double base_lift, double reference_height = 0.04);
+
+private:
+    // Ячейка оси для x от подсказки hint: [axis[i], axis[i+1]), x уже внутри
+    // оси; last_cell - последняя ячейка
+    static int findCell(const std::vector<double>& axis, double x, int hint, int last_cell);
+    
+    std::vector<double> speeds;
+    std::vector<double> heights;
+    std::vector<double> inv_speed_step;     // 1 / ширина ячейки по оси
+    std::vector<double> inv_height_step;
+    
+    // Узлы по строкам клиренса: [height_index * speedCount() + speed_index].
+    // Cd и Cl узла рядом - ячейка в одной-двух кэш-линиях; баланс - отдельно,
+    // чтобы не тянуть его в кэш на каждом шаге
+    std::vector<AeroDragLift> closed;
+    std::vector<AeroDragLift> open;
+    std::vector<double> closed_balance;
+    std::vector<double> open_balance;
+};
+
+// === РЕАЛИЗАЦИЯ (горячий путь - в заголовке, чтобы встраивался в шаг) ===
+
+inline int AeroMap::findCell(const std::vector<double>& axis, double x, int hint, int last_cell) {
+    int i = std::min(std::max(hint, 0), last_cell);
+    while (i > 0 && x < axis[i]) {
+        i--;
+    }
+    while (i < last_cell && x >= axis[i + 1]) {
+        i++;
+    }
+    return i;
+}
+
+inline AeroDragLift AeroMap::evaluate(double speed, double ride_height, bool drs_open, Cursor& cursor) const {
+    // За краями сетки - значение на краю: точка прижимается к оси, и доли
+    // внутри ячейки сами остаются в [0, 1]
+    const int row = static_cast<int>(speeds.size());
+    const int last_speed_cell = row - 2;
+    const int last_height_cell = static_cast<int>(heights.size()) - 2;
+    speed = std::min(std::max(speed, speeds[0]), speeds[last_speed_cell + 1]);
+    ride_height = std::min(std::max(ride_height, heights[0]), heights[last_height_cell + 1]);
+    
+    const int i = findCell(speeds, speed, cursor.speed_cell, last_speed_cell);
+    const int j = findCell(heights, ride_height, cursor.height_cell, last_height_cell);
+    cursor.speed_cell = i;
+    cursor.height_cell = j;
+    
+    double u = (speed - speeds[i]) * inv_speed_step[i];
+    double w = (ride_height - heights[j]) * inv_height_step[j];
+    
+    const std::vector<AeroDragLift>& table = drs_open ? open : closed;
+    const AeroDragLift& p00 = table[j * row + i];
+    const AeroDragLift& p10 = table[j * row + i + 1];
+    const AeroDragLift& p01 = table[(j + 1) * row + i];
+    const AeroDragLift& p11 = table[(j + 1) * row + i + 1];
+    
+    double w00 = (1.0 - u) * (1.0 - w);
+    double w10 = u * (1.0 - w);
+    double w01 = (1.0 - u) * w;
+    double w11 = u * w;
+    
+    AeroDragLift result;
+    result.drag = w00 * p00.drag + w10 * p10.drag + w01 * p01.drag + w11 * p11.drag;
+    result.lift = w00 * p00.lift + w10 * p10.lift + w01 * p01.lift + w11 * p11.lift;
+    return result;
+}
+
+#endif // F1_AERO_H
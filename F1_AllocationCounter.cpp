@@ -0,0 +1,89 @@
+#include "F1_AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    // relaxed: счетчики только для статистики, порядок с другими данными не нужен
+    std::atomic<std::uint64_t> allocation_count{0};
+    std::atomic<std::uint64_t> deallocation_count{0};
+    std::atomic<std::uint64_t> allocated_bytes{0};
+    
+    // Считаются только удачные выделения - как и освобождения (countedFree)
+    void* tryAllocate(std::size_t size) {
+        void* p = std::malloc(size ? size : 1);
+        if (p) {
+            allocation_count.fetch_add(1, std::memory_order_relaxed);
+            allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+        return p;
+    }
+    
+    void* tryAllocate(std::size_t size, std::align_val_t align) {
+        std::size_t alignment = static_cast<std::size_t>(align);
+        void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+        if (p) {
+            allocation_count.fetch_add(1, std::memory_order_relaxed);
+            allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+        }
+        return p;
+    }
+    
+    // Обычный new: без памяти - abort (исключений в проекте нет - как new под
+    // -fno-exceptions). nothrow-варианты вместо этого возвращают nullptr
+    void* countedAllocate(std::size_t size) {
+        void* p = tryAllocate(size);
+        if (!p) {
+            std::abort();
+        }
+        return p;
+    }
+    
+    void* countedAllocate(std::size_t size, std::align_val_t align) {
+        void* p = tryAllocate(size, align);
+        if (!p) {
+            std::abort();
+        }
+        return p;
+    }
+    
+    void countedFree(void* p) {
+        if (p) {
+            deallocation_count.fetch_add(1, std::memory_order_relaxed);
+            std::free(p);
+        }
+    }
+}
+
+namespace allocation_counter {
+    std::uint64_t allocations() { return allocation_count.load(std::memory_order_relaxed); }
+    std::uint64_t deallocations() { return deallocation_count.load(std::memory_order_relaxed); }
+    std::uint64_t bytesAllocated() { return allocated_bytes.load(std::memory_order_relaxed); }
+}
+
+// === ЗАМЕНА ГЛОБАЛЬНЫХ operator new/delete ===
+// Включая варианты с выравниванием (align_val_t) - иначе выделения типов
+// с alignas больше max_align_t прошли бы мимо счетчика
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return tryAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return tryAllocate(size); }
+
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { countedFree(p); }
+
+void* operator new(std::size_t size, std::align_val_t align) { return countedAllocate(size, align); }
+void* operator new[](std::size_t size, std::align_val_t align) { return countedAllocate(size, align); }
+void* operator new(std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return tryAllocate(size, align);
+}
+void* operator new[](std::size_t size, std::align_val_t align, const std::nothrow_t&) noexcept {
+    return tryAllocate(size, align);
+}
+void operator delete(void* p, std::align_val_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { countedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { countedFree(p); }
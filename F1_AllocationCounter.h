@@ -0,0 +1,26 @@
+#ifndef F1_ALLOCATION_COUNTER_H
+#define F1_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+// Счетчики обращений к куче всего процесса. F1_AllocationCounter.cpp
+// подменяет глобальные operator new/delete, поэтому его линкуют только в
+// инструменты, которые проверяют путь без выделений (f1_benchmark), а не
+// в библиотеку.
+namespace allocation_counter {
+    std::uint64_t allocations();        // Удачных вызовов operator new с начала процесса
+    std::uint64_t deallocations();
+    std::uint64_t bytesAllocated();
+}
+
+// Выделения внутри области: allocations() при выходе минус при входе
+class AllocationScope {
+public:
+    AllocationScope() : start(allocation_counter::allocations()) {}
+    std::uint64_t count() const { return allocation_counter::allocations() - start; }
+
+private:
+    std::uint64_t start;
+};
+
+#endif // F1_ALLOCATION_COUNTER_H
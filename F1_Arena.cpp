@@ -0,0 +1,46 @@
+#include "F1_Arena.h"
+#include <algorithm>
+
+MonotonicArena::MonotonicArena(std::size_t initial_bytes) {
+    Block block;
+    block.size = std::max<std::size_t>(initial_bytes, 64);
+    block.data.reset(new unsigned char[block.size]);
+    blocks.push_back(std::move(block));
+    upstream_allocations++;
+}
+
+void MonotonicArena::nextBlock(std::size_t bytes, std::size_t align) {
+    used_before += offset;
+    offset = 0;
+    
+    // Уже взятые блоки после reset() используются снова, пока подходят
+    while (++current < blocks.size()) {
+        if (blocks[current].size >= bytes + align) {
+            return;
+        }
+    }
+    
+    Block block;
+    block.size = std::max(blocks.back().size * 2, bytes + align);
+    block.data.reset(new unsigned char[block.size]);
+    blocks.push_back(std::move(block));
+    upstream_allocations++;
+}
+
+void MonotonicArena::reset() {
+    current = 0;
+    offset = 0;
+    used_before = 0;
+}
+
+std::size_t MonotonicArena::bytesUsed() const {
+    return used_before + offset;
+}
+
+std::size_t MonotonicArena::bytesReserved() const {
+    std::size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
@@ -0,0 +1,89 @@
+#ifndef F1_ARENA_H
+#define F1_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Монотонная арена: память выдается сдвигом указателя и не освобождается
+// по одному объекту - reset() возвращает все сразу за O(1). Блоки остаются
+// за ареной, поэтому после первого прогона сценария повторные прогоны не
+// обращаются к куче совсем.
+//
+// Деструкторы не вызываются: в арене живут только тривиально разрушаемые
+// типы (движок, буферы педалей и телеметрии), это проверяется при сборке.
+// Одна арена на поток, без синхронизации.
+class MonotonicArena {
+public:
+    // Первый блок выделяется сразу; если не хватит - следующий, вдвое больше
+    explicit MonotonicArena(std::size_t initial_bytes = 64 * 1024);
+    
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+    MonotonicArena(MonotonicArena&&) = default;
+    MonotonicArena& operator=(MonotonicArena&&) = default;
+    
+    // Сырая память; align - степень двойки
+    void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t));
+    
+    // Объект T в арене
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena never runs destructors");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+    
+    // count объектов T, инициализированных по умолчанию
+    template <typename T>
+    T* createArray(std::size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena never runs destructors");
+        T* data = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        for (std::size_t i = 0; i < count; i++) {
+            new (data + i) T();
+        }
+        return data;
+    }
+    
+    // Все выданное недействительно; блоки остаются для следующего прогона
+    void reset();
+    
+    // === СТАТИСТИКА ===
+    std::size_t bytesUsed() const;          // Выдано с последнего reset()
+    std::size_t bytesReserved() const;      // Сумма блоков
+    std::size_t blockCount() const { return blocks.size(); }
+    std::uint64_t upstreamAllocations() const { return upstream_allocations; }  // Блоков взято из кучи за все время
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        std::size_t size = 0;
+    };
+    
+    // Следующий блок, в который влезет bytes с выравниванием align
+    void nextBlock(std::size_t bytes, std::size_t align);
+    
+    std::vector<Block> blocks;
+    std::size_t current = 0;                // Блок, из которого сейчас выдаем
+    std::size_t offset = 0;                 // Занято в текущем блоке
+    std::size_t used_before = 0;            // Занято в блоках до текущего
+    std::uint64_t upstream_allocations = 0;
+};
+
+// Быстрый путь - в заголовке: выдача из текущего блока - сложение и сравнение
+inline void* MonotonicArena::allocate(std::size_t bytes, std::size_t align) {
+    Block& block = blocks[current];
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data.get());
+    std::size_t start = ((base + offset + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1)) - base;
+    if (start + bytes > block.size) {
+        nextBlock(bytes, align);
+        return allocate(bytes, align);
+    }
+    offset = start + bytes;
+    return block.data.get() + start;
+}
+
+#endif // F1_ARENA_H
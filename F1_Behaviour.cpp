@@ -0,0 +1,284 @@
+#include "F1_Behaviour.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include "F1_Driver.h"
+#include "F1_PhysicsCore.h"
+#include "F1_Race.h"
+
+namespace {
+    constexpr double DT = 0.01;
+    
+    std::string format(const char* pattern, double a = 0.0, double b = 0.0, double c = 0.0, double d = 0.0) {
+        char buffer[256];
+        std::snprintf(buffer, sizeof(buffer), pattern, a, b, c, d);
+        return buffer;
+    }
+    
+    // Заезд автопилота по демо-трассе
+    struct TrackRun {
+        Track track = Track::demoCircuit();
+        F1PhysicsEngine::CarParameters params;
+        SpeedProfile profile;
+        
+        TrackRun() {
+            params.track_length = track.length;
+            profile = SpeedProfile::fromTrack(track, params);
+        }
+    };
+    
+    // Энергия отдачи MGU-K за laps кругов: на участках карты с долей 0 и всего;
+    // max_excess - наибольшее превышение мощности над долей карты [Вт]
+    struct DeploymentTally {
+        double forbidden = 0.0;         // [Дж]
+        double total = 0.0;             // [Дж]
+        double max_excess = 0.0;        // [Вт]
+    };
+    
+    DeploymentTally driveDeployment(const TrackRun& run, const ErsDeploymentMap& map, bool attach, int laps) {
+        F1PhysicsEngine car(run.params);
+        car.enableForceBreakdown(true);
+        if (attach) {
+            car.setDeploymentMap(&map);
+        }
+        SpeedProfileDriver driver(run.profile);
+        DriverState state;
+        DeploymentTally tally;
+        while (car.getState().lap < laps && car.getState().time < laps * 250.0) {
+            // Доля карты - по дистанции до шага (по ней и считает ERS)
+            double fraction = map.deployFraction(car.getState().lap_distance);
+            double battery = car.getState().battery_energy;
+            DriverCommand command = driver.drive(car, state, DT);
+            
+            const F1PhysicsEngine::ForceBreakdown& f = car.getForces();
+            if (f.ers_torque <= 0.0) {
+                continue;
+            }
+            double energy = battery - car.getState().battery_energy;
+            double power = f.ers_torque * car.getState().engine_rpm / f1core::RAD_S_TO_RPM;
+            double allowed = fraction * command.throttle * run.params.ers.mguk_max_power;
+            tally.total += energy;
+            tally.forbidden += fraction <= 0.0 ? energy : 0.0;
+            tally.max_excess = std::max(tally.max_excess, power - allowed);
+        }
+        return tally;
+    }
+    
+    // Переключения по оборотам для прогонов с постоянными педалями
+    void shiftByRpm(F1PhysicsEngine& car) {
+        const F1PhysicsEngine::CarState& s = car.getState();
+        if (s.engine_rpm > 13500.0) {
+            car.shiftUp();
+        }
+    }
+    
+    // Отрыв ведомой от лидера после seconds полного газа по прямой
+    struct PairRun {
+        double gap = 0.0;               // [м]
+        bool leader_drs = false;
+        bool follower_drs = false;
+        double follower_drag_factor = 1.0;
+    };
+    
+    PairRun drivePair(const RaceParameters& race_params, double seconds, const Track* track = nullptr) {
+        F1Race race(2, race_params);
+        race.setTrack(track);
+        std::vector<F1Race::CarControl> controls(2);
+        controls[0].throttle = controls[1].throttle = 1.0;
+        long steps = std::lround(seconds / DT);
+        for (long i = 0; i < steps; i++) {
+            shiftByRpm(race.car(0));
+            shiftByRpm(race.car(1));
+            race.step(DT, controls);
+        }
+        PairRun run;
+        run.gap = race.car(0).getState().position.x - race.car(1).getState().position.x;
+        run.leader_drs = race.car(0).isDrsOpen();
+        run.follower_drs = race.car(1).isDrsOpen();
+        run.follower_drag_factor = race.car(1).getSlipstreamDragFactor();
+        return run;
+    }
+    
+    // Пара без взаимодействий, кроме выбранного. Обгон запрещен: ведомая,
+    // догнав, остается позади на min_gap
+    RaceParameters isolatedPair() {
+        RaceParameters p;
+        p.grid_spacing = 20.0;
+        p.overtake_min_closing_speed = std::numeric_limits<double>::infinity();
+        p.slipstream_max_drag_reduction = 0.0;
+        p.dirty_air_max_downforce_loss = 0.0;
+        p.drs_range = 0.0;
+        return p;
+    }
+}
+
+BehaviourResult checkDeploymentFollowsMap() {
+    TrackRun run;
+    ErsDeploymentMap map = buildDeploymentMap(run.profile, run.params);
+    DeploymentTally mapped = driveDeployment(run, map, true, 3);
+    DeploymentTally unmapped = driveDeployment(run, map, false, 3);
+    
+    BehaviourResult result;
+    result.name = "ers.deployment_map";
+    // Мощность сверяется с оборотами после шага - допуск на их изменение за шаг
+    result.passed = mapped.forbidden == 0.0 && mapped.total > 0.0
+                    && mapped.max_excess <= 0.01 * run.params.ers.mguk_max_power;
+    result.detail = format("3 круга: отдано %.2f МДж, вне карты %.0f Дж, превышение доли %.0f Вт "
+                           "(без карты вне нее %.2f МДж)",
+                           mapped.total * 1e-6, mapped.forbidden, mapped.max_excess, unmapped.forbidden * 1e-6);
+    return result;
+}
+
+BehaviourResult checkRaceOrdering() {
+    TrackRun run;
+    const int car_count = 20;
+    F1Race race(car_count, RaceParameters(), run.params);
+    race.setTrack(&run.track);
+    RaceDrivers drivers(run.track, run.params, car_count);
+    std::vector<F1Race::CarControl> controls;
+    
+    long steps = 0;
+    long violations = 0;
+    std::vector<int> seen(car_count);
+    while (race.car(race.classification()[0]).getState().lap < 2 && steps < 60000) {
+        drivers.control(race, DT, controls);
+        race.step(DT, controls);
+        steps++;
+        
+        const std::vector<int>& order = race.classification();
+        std::fill(seen.begin(), seen.end(), 0);
+        bool ok = static_cast<int>(order.size()) == car_count;
+        for (int k = 0; ok && k < car_count; k++) {
+            ok = order[k] >= 0 && order[k] < car_count && seen[order[k]]++ == 0;
+            if (ok && k > 0) {
+                double ahead = race.car(order[k - 1]).getState().position.x;
+                double here = race.car(order[k]).getState().position.x;
+                ok = here <= ahead && race.gapAhead(order[k]) == ahead - here;
+            }
+        }
+        ok = ok && race.gapAhead(order[0]) == 0.0;
+        violations += ok ? 0 : 1;
+    }
+    
+    BehaviourResult result;
+    result.name = "race.ordering";
+    result.passed = violations == 0 && race.overtakeCount() > 0;
+    result.detail = format("%.0f шагов, 20 машин: нарушений протокола %.0f, обгонов %.0f",
+                           static_cast<double>(steps), static_cast<double>(violations),
+                           static_cast<double>(race.overtakeCount()));
+    return result;
+}
+
+BehaviourResult checkRaceSlipstream() {
+    RaceParameters off = isolatedPair();
+    RaceParameters on = off;
+    on.slipstream_max_drag_reduction = RaceParameters().slipstream_max_drag_reduction;
+    PairRun still_air = drivePair(off, 10.0);
+    PairRun towed = drivePair(on, 10.0);
+    
+    BehaviourResult result;
+    result.name = "race.slipstream";
+    result.passed = std::abs(still_air.gap - off.grid_spacing) < 1e-6 && towed.gap < still_air.gap - 1.0
+                    && towed.follower_drag_factor < 1.0;
+    result.detail = format("10 с газа со старта в %.0f м: отрыв %.2f м в слипстриме (сопротивление x%.2f), "
+                           "%.2f м без него",
+                           off.grid_spacing, towed.gap, towed.follower_drag_factor, still_air.gap);
+    return result;
+}
+
+BehaviourResult checkRaceDrs() {
+    RaceParameters off = isolatedPair();
+    RaceParameters on = off;
+    on.drs_range = RaceParameters().drs_range;
+    PairRun closed = drivePair(off, 10.0);
+    PairRun open = drivePair(on, 10.0);
+    
+    // Та же пара на трассе, где все после первых 100 м - поворот
+    Track cornered;
+    cornered.corners.push_back({100.0, cornered.length - 100.0, 100.0});
+    PairRun in_corner = drivePair(on, 10.0, &cornered);
+    
+    BehaviourResult result;
+    result.name = "race.drs";
+    result.passed = open.follower_drs && !open.leader_drs && open.gap < closed.gap - 1.0 && !in_corner.follower_drs;
+    result.detail = format(in_corner.follower_drs
+                               ? "10 с газа со старта в %.0f м: отрыв %.2f м с DRS, %.2f м без него, в повороте DRS открыт"
+                               : "10 с газа со старта в %.0f м: отрыв %.2f м с DRS, %.2f м без него, в повороте DRS закрыт",
+                           off.grid_spacing, open.gap, closed.gap);
+    return result;
+}
+
+BehaviourResult checkThermalResponse() {
+    F1PhysicsEngine::CarParameters params;
+    params.thermal.enabled = true;
+    params.ers.mguk_max_torque = 0.0;   // Без рекуперации сила торможения - только тормоза
+    F1PhysicsEngine car(params);
+    car.enableForceBreakdown(true);
+    const F1PhysicsEngine::CarState& s = car.getState();
+    const ThermalState& thermal = car.getSlowState().thermal;
+    
+    auto brakeTemperature = [&thermal]() {
+        double sum = 0.0;
+        for (double t : thermal.brake_temperature) {
+            sum += t;
+        }
+        return sum / 4.0;
+    };
+    
+    double min_heating = std::numeric_limits<double>::max();
+    double min_cooling = std::numeric_limits<double>::max();
+    double min_efficiency = thermal.brake_efficiency;
+    double max_efficiency = thermal.brake_efficiency;
+    double min_grip = thermal.grip_factor;
+    double max_grip = thermal.grip_factor;
+    double force_error = 0.0;
+    double grip_error = 0.0;
+    for (int cycle = 0; cycle < 3; cycle++) {
+        double before = brakeTemperature();
+        for (int i = 0; i < 1200; i++) {
+            shiftByRpm(car);
+            car.update(DT, 1.0, 0.0);
+        }
+        double top = brakeTemperature();
+        while (s.velocity.x > 0.0) {
+            // Полная педаль: сила - предел тормозов с эффективностью и фактором
+            // до шага (медленный шаг в его конце пересчитывает их для следующего)
+            double limit = params.max_brake_force * thermal.brake_efficiency;
+            bool full = s.brake_factor >= 1.0f;
+            car.update(DT, 0.0, 1.0);
+            if (full) {
+                force_error = std::max(force_error, std::abs(car.getForces().brake_force + limit));
+            }
+            double grip = params.tire_friction * (1.0 - params.tire_grip_loss * car.getSlowState().tire_wear)
+                          * thermal.grip_factor;
+            grip_error = std::max(grip_error, std::abs(s.tire_grip - grip));
+            min_efficiency = std::min(min_efficiency, thermal.brake_efficiency);
+            max_efficiency = std::max(max_efficiency, thermal.brake_efficiency);
+            min_grip = std::min(min_grip, thermal.grip_factor);
+            max_grip = std::max(max_grip, thermal.grip_factor);
+        }
+        min_cooling = std::min(min_cooling, before - top);
+        min_heating = std::min(min_heating, brakeTemperature() - top);
+        while (s.current_gear > 1) {
+            car.shiftDown();
+        }
+    }
+    
+    BehaviourResult result;
+    result.name = "thermal.response";
+    result.passed = min_heating > 100.0 && min_cooling > 0.0 && max_efficiency - min_efficiency > 0.05
+                    && max_grip - min_grip > 0.01 && force_error <= 1e-6 * params.max_brake_force
+                    && grip_error <= 1e-6;
+    result.detail = format("3 разгона по 12 с до остановки: тормоза +%.0f°C за торможение, -%.0f°C за разгон, "
+                           "эффективность %.2f..%.2f, ",
+                           min_heating, min_cooling, min_efficiency, max_efficiency)
+                    + format("μ шин x%.3f..%.3f (расхождение с шагом: сила %.1e Н, μ %.1e)",
+                             min_grip, max_grip, force_error, grip_error);
+    return result;
+}
+
+std::vector<BehaviourResult> runBehaviourChecks() {
+    return {checkDeploymentFollowsMap(), checkRaceOrdering(), checkRaceSlipstream(), checkRaceDrs(),
+            checkThermalResponse()};
+}
@@ -0,0 +1,45 @@
+#ifndef F1_BEHAVIOUR_H
+#define F1_BEHAVIOUR_H
+
+#include <string>
+#include <vector>
+
+// Проверки поведения: свойства модели, которых эталонные трассы не ловят
+// (трассы сравнивают варианты движка друг с другом, а не с физикой).
+// Каждая проверка - короткий заезд с известным исходом; detail - измеренные
+// числа, чтобы по отчету было видно запас, а не только вердикт.
+
+struct BehaviourResult {
+    std::string name;
+    bool passed = false;
+    std::string detail;
+};
+
+// Отдача MGU-K идет по карте трассы: ни джоуля на участках с долей 0, и
+// мощность нигде не выше доли карты (при той же педали). Для сравнения -
+// сколько тот же заезд без карты отдает на запрещенных участках
+BehaviourResult checkDeploymentFollowsMap();
+
+// Гонка 20 машин под автопилотами, два круга: на каждом шаге протокол -
+// перестановка машин по убыванию дистанции, отставания - разности дистанций;
+// обгоны были
+BehaviourResult checkRaceOrdering();
+
+// Две одинаковые машины на прямой, газ в пол: в слипстриме ведомая
+// сокращает отрыв, без слипстрима отрыв не меняется
+BehaviourResult checkRaceSlipstream();
+
+// То же с DRS вместо слипстрима: открыт только у ведомой, и с ним она
+// сокращает отрыв (DRS действует через аэрокарту гонки). В повороте трассы закрыт
+BehaviourResult checkRaceDrs();
+
+// Температуры: разгон и торможение до остановки, три раза. Тормоза греются
+// на торможении и остывают на разгоне; эффективность тормозов и множитель μ
+// шин меняются с температурой, и сила торможения и сцепление в шаге идут
+// ровно по ним
+BehaviourResult checkThermalResponse();
+
+// Все проверки по порядку
+std::vector<BehaviourResult> runBehaviourChecks();
+
+#endif // F1_BEHAVIOUR_H
@@ -0,0 +1,523 @@
+#include "F1_Benchmark.h"
+#include "F1_AllocationCounter.h"
+#include "F1_Arena.h"
+#include "F1_Driver.h"
+#include "F1_Fleet.h"
+#include "F1_Physics_build_2.h"
+#include "F1_Plot.h"
+#include "F1_Race.h"
+#include "F1_Scenario.h"
+#include "F1_SpecializedEngine.h"
+#include "F1_Telemetry.h"
+#include "F1_TelemetryCodec.h"
+#include "F1_TelemetryLog.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <sstream>
+
+namespace {
+    // Не даем компилятору выбросить результат
+    volatile double benchmark_sink = 0.0;
+    
+    // Сценарий: 15 с газа, 7.5 с тормоза, переключения по оборотам.
+    // on_step(engine) - после каждого шага (запись кадров, истории)
+    template <typename Engine, typename OnStep>
+    void driveScenario(Engine& engine, long steps, OnStep on_step) {
+        const double dt = 0.01;
+        for (long i = 0; i < steps; i++) {
+            bool gas = (i / 750) % 3 != 2;
+            engine.update(dt, gas, !gas);
+            
+            const auto& s = engine.getState();
+            if (s.engine_rpm > 13500.0) {
+                engine.shiftUp();
+            } else if (!gas && s.clutch_locked && s.engine_rpm < 8000.0 && s.current_gear > 1) {
+                engine.shiftDown();
+            }
+            on_step(engine);
+        }
+        benchmark_sink = benchmark_sink + engine.getState().position.x;
+    }
+    
+    template <typename Engine>
+    void driveScenario(Engine& engine, long steps) {
+        driveScenario(engine, steps, [](const Engine&) {});
+    }
+    
+    template <typename Engine>
+    BenchmarkResult benchmarkEngine(const std::string& name, long steps, int repeats) {
+        BenchmarkResult result{name, 0.0, steps};
+        double best = 0.0;
+        for (int r = 0; r < repeats; r++) {
+            Engine engine;
+            auto start = std::chrono::steady_clock::now();
+            driveScenario(engine, steps);
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            best = (r == 0) ? ns : std::min(best, ns);
+        }
+        result.ns_per_op = best / steps;
+        return result;
+    }
+    
+    // Рантайм-движок с аэрокартой граунд-эффекта: цена интерполяции на шаг
+    BenchmarkResult benchmarkAeroMap(const std::string& name, long steps, int repeats) {
+        BenchmarkResult result{name, 0.0, steps};
+        F1PhysicsEngine::CarParameters params;
+        AeroMap map = AeroMap::groundEffectCar(params.drag_coefficient, params.downforce_coefficient);
+        double best = 0.0;
+        for (int r = 0; r < repeats; r++) {
+            F1PhysicsEngine engine(params);
+            engine.setAeroMap(&map);
+            auto start = std::chrono::steady_clock::now();
+            driveScenario(engine, steps);
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            best = (r == 0) ? ns : std::min(best, ns);
+        }
+        result.ns_per_op = best / steps;
+        return result;
+    }
+    
+    // Рантайм-движок с температурами тормозов и шин: цена накопления работы
+    // на шаге и теплового пересчета на грубом шаге
+    BenchmarkResult benchmarkThermal(const std::string& name, long steps, int repeats) {
+        BenchmarkResult result{name, 0.0, steps};
+        F1PhysicsEngine::CarParameters params;
+        params.thermal.enabled = true;
+        double best = 0.0;
+        for (int r = 0; r < repeats; r++) {
+            F1PhysicsEngine engine(params);
+            auto start = std::chrono::steady_clock::now();
+            driveScenario(engine, steps);
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            best = (r == 0) ? ns : std::min(best, ns);
+        }
+        result.ns_per_op = best / steps;
+        return result;
+    }
+    
+    // Рантайм-движок с профилем стадий - для driveScenario
+    struct ProfiledEngine {
+        F1PhysicsEngine engine;
+        F1PhysicsEngine::StageProfile profile;
+        
+        void update(double dt, double throttle, double brake) {
+            engine.updateProfiled(dt, throttle, brake, 0.0, profile);
+        }
+        const F1PhysicsEngine::CarState& getState() const { return engine.getState(); }
+        void shiftUp() { engine.shiftUp(); }
+        void shiftDown() { engine.shiftDown(); }
+    };
+    
+    // Такты на пустой интервал между двумя чтениями счетчика (входят в каждую стадию)
+    double stageClockOverhead() {
+        const int samples = 100000;
+        std::uint64_t best = ~0ull;
+        for (int i = 0; i < samples; i++) {
+            std::uint64_t start = F1PhysicsEngine::stageClock();
+            std::uint64_t end = F1PhysicsEngine::stageClock();
+            best = std::min(best, end - start);
+        }
+        return static_cast<double>(best);
+    }
+    
+    // Парк: та же работа (машино-шаги), что у одиночного движка
+    template <typename Scalar>
+    BenchmarkResult benchmarkFleet(const std::string& name, std::size_t cars, long steps, int repeats) {
+        long fleet_steps = std::max(1L, steps / static_cast<long>(cars));
+        BenchmarkResult result{name, 0.0, fleet_steps * static_cast<long>(cars)};
+        std::vector<std::uint8_t> gas, brake;
+        double best = 0.0;
+        for (int r = 0; r < repeats; r++) {
+            F1Fleet<Scalar> fleet(cars);
+            auto start = std::chrono::steady_clock::now();
+            for (long i = 0; i < fleet_steps; i++) {
+                stepFleetScenario(fleet, i, 0.01, gas, brake);
+            }
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            best = (r == 0) ? ns : std::min(best, ns);
+            benchmark_sink = benchmark_sink + fleet.getPosition(0);
+        }
+        result.ns_per_op = best / result.operations;
+        return result;
+    }
+    
+    // Парк под автопилотом на демо-трассе: шаг пилота + шаг парка на машину
+    template <typename Scalar>
+    BenchmarkResult benchmarkFleetDriver(const std::string& name, std::size_t cars, long steps, int repeats,
+                                         bool thermal = false) {
+        long fleet_steps = std::max(1L, steps / static_cast<long>(cars));
+        BenchmarkResult result{name, 0.0, fleet_steps * static_cast<long>(cars)};
+        Track track = Track::demoCircuit();
+        F1PhysicsEngine::CarParameters params;
+        params.track_length = track.length;
+        params.thermal.enabled = thermal;
+        SpeedProfile profile = SpeedProfile::fromTrack(track, params);
+        SpeedProfileDriver driver(profile);
+        ErsDeploymentMap deployment_map = buildDeploymentMap(profile, params);
+        std::vector<DriverState> states;
+        std::vector<float> throttle, brake;
+        double best = 0.0;
+        for (int r = 0; r < repeats; r++) {
+            F1Fleet<Scalar> fleet(cars, params);
+            fleet.setDeploymentMap(&deployment_map);
+            states.assign(cars, DriverState());
+            auto start = std::chrono::steady_clock::now();
+            for (long i = 0; i < fleet_steps; i++) {
+                driver.driveFleet(fleet, states, throttle, brake, 0.01);
+            }
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            best = (r == 0) ? ns : std::min(best, ns);
+            benchmark_sink = benchmark_sink + fleet.getPosition(0);
+        }
+        result.ns_per_op = best / result.operations;
+        return result;
+    }
+    
+    // Гонка машин под автопилотами на демо-трассе: пилоты, слипстрим, DRS,
+    // блокировки и порядок - время на машино-шаг
+    BenchmarkResult benchmarkRace(const std::string& name, int cars, long steps, int repeats) {
+        long race_steps = std::max(1L, steps / cars);
+        BenchmarkResult result{name, 0.0, race_steps * cars};
+        Track track = Track::demoCircuit();
+        F1PhysicsEngine::CarParameters params;
+        params.track_length = track.length;
+        ErsDeploymentMap deployment_map = buildDeploymentMap(SpeedProfile::fromTrack(track, params), params);
+        std::vector<F1Race::CarControl> controls;
+        double best = 0.0;
+        for (int r = 0; r < repeats; r++) {
+            F1Race race(cars, RaceParameters(), params);
+            race.setDeploymentMap(&deployment_map);
+            race.setTrack(&track);
+            RaceDrivers drivers(track, params, cars);
+            auto start = std::chrono::steady_clock::now();
+            for (long i = 0; i < race_steps; i++) {
+                drivers.control(race, 0.01, controls);
+                race.step(0.01, controls);
+            }
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            best = (r == 0) ? ns : std::min(best, ns);
+            benchmark_sink = benchmark_sink + race.car(0).getState().position.x;
+        }
+        result.ns_per_op = best / result.operations;
+        return result;
+    }
+    
+    // Трасса телеметрии: отсчет на каждый шаг физики
+    struct TelemetryTrace {
+        static constexpr int CHANNELS = 11;
+        std::vector<std::int64_t> timestamps;   // [нс]
+        std::vector<double> values;             // CHANNELS значений на отсчет
+    };
+    
+    TelemetryTrace recordTrace(double dt, double seconds) {
+        TelemetryTrace trace;
+        long steps = static_cast<long>(seconds / dt);
+        long period = static_cast<long>(7.5 / dt);
+        trace.timestamps.reserve(steps);
+        trace.values.reserve(steps * TelemetryTrace::CHANNELS);
+        
+        F1PhysicsEngine engine;
+        for (long i = 0; i < steps; i++) {
+            bool gas = (i / period) % 3 != 2;
+            engine.update(dt, gas, !gas);
+            
+            const auto& s = engine.getState();
+            if (s.engine_rpm > 13500.0) {
+                engine.shiftUp();
+            } else if (!gas && s.clutch_locked && s.engine_rpm < 8000.0 && s.current_gear > 1) {
+                engine.shiftDown();
+            }
+            
+            const auto& slow = engine.getSlowState();
+            const double sample[TelemetryTrace::CHANNELS] = {
+                s.position.x, s.velocity.x, s.engine_rpm, s.battery_energy, s.down_force,
+                s.lap_distance, s.brake_factor, s.mass, s.tire_grip, slow.fuel_mass, slow.tire_wear};
+            trace.timestamps.push_back(std::llround(s.time * 1e9));
+            trace.values.insert(trace.values.end(), sample, sample + TelemetryTrace::CHANNELS);
+        }
+        return trace;
+    }
+    
+    CodecBenchmarkResult benchmarkCodec(const std::string& name, const TelemetryTrace& trace, double rate_hz,
+                                        CodecPredictor predictor, int repeats) {
+        const int channels = TelemetryTrace::CHANNELS;
+        const long samples = static_cast<long>(trace.timestamps.size());
+        CodecBenchmarkResult result;
+        result.name = name;
+        result.rate_hz = rate_hz;
+        result.samples = samples;
+        result.channels = channels;
+        result.raw_bytes = static_cast<std::size_t>(samples) * 8 * (channels + 1);
+        
+        std::vector<std::uint8_t> encoded;
+        std::vector<double> decoded(channels);
+        double best_encode = 0.0, best_decode = 0.0;
+        for (int r = 0; r < repeats; r++) {
+            auto start = std::chrono::steady_clock::now();
+            TelemetryEncoder encoder(channels, predictor);
+            for (long i = 0; i < samples; i++) {
+                encoder.append(trace.timestamps[i], &trace.values[i * channels]);
+            }
+            encoded = encoder.finish();
+            double encode_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            
+            // Первый повтор сверяет все биты, остальные только меряют
+            bool verify = (r == 0);
+            bool lossless = true;
+            start = std::chrono::steady_clock::now();
+            TelemetryDecoder decoder(encoded);
+            std::int64_t timestamp = 0;
+            long i = 0;
+            double sink = 0.0;
+            while (decoder.next(timestamp, decoded.data())) {
+                sink += decoded[0];
+                if (verify) {
+                    lossless = lossless && timestamp == trace.timestamps[i]
+                            && std::memcmp(decoded.data(), &trace.values[i * channels], 8 * channels) == 0;
+                }
+                i++;
+            }
+            double decode_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            benchmark_sink = benchmark_sink + sink;
+            if (verify) {
+                result.lossless = lossless && i == samples;
+            }
+            
+            best_encode = (r == 0) ? encode_ns : std::min(best_encode, encode_ns);
+            best_decode = (r == 0) ? decode_ns : std::min(best_decode, decode_ns);
+        }
+        
+        result.encoded_bytes = encoded.size();
+        result.ratio = static_cast<double>(result.raw_bytes) / encoded.size();
+        result.encode_mb_per_s = result.raw_bytes / best_encode * 1e3;
+        result.decode_mb_per_s = result.raw_bytes / best_decode * 1e3;
+        return result;
+    }
+    
+    // Кадры телеметрии сценария driveScenario, по кадру на шаг
+    std::vector<TelemetryFrame> recordFrames(long frames) {
+        std::vector<TelemetryFrame> result;
+        result.reserve(frames);
+        F1PhysicsEngine engine;
+        driveScenario(engine, frames, [&](const F1PhysicsEngine& e) { result.push_back(makeTelemetryFrame(e)); });
+        return result;
+    }
+    
+    BenchmarkResult benchmarkLogWrite(const std::string& name, const std::vector<TelemetryFrame>& frames,
+                                      const std::string& path, int repeats) {
+        BenchmarkResult result{name, 0.0, static_cast<long>(frames.size())};
+        double best = 0.0;
+        for (int r = 0; r < repeats; r++) {
+            auto start = std::chrono::steady_clock::now();
+            TelemetryLogWriter writer;
+            writer.openCarLog(path, F1PhysicsEngine::CarParameters().track_length);
+            for (const TelemetryFrame& frame : frames) {
+                writer.appendFrame(frame);
+            }
+            writer.close();
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            best = (r == 0) ? ns : std::min(best, ns);
+        }
+        std::remove(path.c_str());
+        result.ns_per_op = best / result.operations;
+        return result;
+    }
+    
+    // Графики F1_Output: первые 30 с сценария, отсчет раз в 0.1 с - позиция,
+    // скорость, сопротивление
+    BenchmarkResult benchmarkPlot(const std::string& name, long plots, int repeats) {
+        BenchmarkResult result{name, 0.0, plots};
+        std::vector<double> time, position, velocity, drag;
+        F1PhysicsEngine engine;
+        engine.enableForceBreakdown(true);
+        long step = 0;
+        driveScenario(engine, 3000, [&](const F1PhysicsEngine& e) {
+            if (++step % 10 == 0) {
+                time.push_back(e.getState().time);
+                position.push_back(e.getState().position.x);
+                velocity.push_back(e.getSpeed() * 3.6);
+                drag.push_back(std::abs(e.getForces().drag_force));
+            }
+        });
+        
+        double best = 0.0;
+        std::ostringstream out;
+        for (int r = 0; r < repeats; r++) {
+            auto start = std::chrono::steady_clock::now();
+            for (long i = 0; i < plots; i += 3) {
+                out.str(std::string());
+                plotGraph(out, time, position, "ПОЗИЦИЯ АВТОМОБИЛЯ", "Время (с)", "Позиция (м)");
+                plotGraph(out, time, velocity, "СКОРОСТЬ АВТОМОБИЛЯ", "Время (с)", "Скорость (км/ч)");
+                plotGraph(out, time, drag, "СОПРОТИВЛЕНИЕ ВОЗДУХА", "Время (с)", "Сила (Н)");
+            }
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            best = (r == 0) ? ns : std::min(best, ns);
+            benchmark_sink = benchmark_sink + out.str().size();
+        }
+        result.ns_per_op = best / ((plots + 2) / 3 * 3);
+        return result;
+    }
+    
+    // Скрипт сценария: 2/3 периода газ, 1/3 тормоз
+    void fillScenarioScript(ScenarioInput* script, std::size_t steps, std::size_t period) {
+        for (std::size_t i = 0; i < steps; i++) {
+            bool gas = (i / period) % 3 != 2;
+            script[i].throttle = gas ? 1.0f : 0.0f;
+            script[i].brake = gas ? 0.0f : 1.0f;
+        }
+    }
+    
+    // Прогон по-старому: движок, скрипт и телеметрия заново в куче на каждый прогон
+    void runHeapScenario(const F1PhysicsEngine::CarParameters& params, const ScenarioConfig& config,
+                         std::uint64_t& step_allocations) {
+        std::unique_ptr<F1PhysicsEngine> engine(new F1PhysicsEngine(params));
+        std::vector<ScenarioInput> script(config.steps);
+        fillScenarioScript(script.data(), config.steps, config.steps / 4);
+        std::vector<ScenarioSample> samples;
+        
+        AllocationScope steps;
+        for (std::size_t i = 0; i < config.steps; i++) {
+            engine->update(config.dt, script[i].throttle, script[i].brake);
+            const F1PhysicsEngine::CarState& s = engine->getState();
+            if (s.engine_rpm > config.upshift_rpm) {
+                engine->shiftUp();
+            } else if (s.clutch_locked && s.engine_rpm < config.downshift_rpm && s.current_gear > 1) {
+                engine->shiftDown();
+            }
+            if ((i + 1) % config.telemetry_every == 0) {
+                ScenarioSample sample;
+                sample.time = s.time;
+                sample.lap_distance = s.lap_distance;
+                sample.velocity = s.velocity.x;
+                sample.engine_rpm = s.engine_rpm;
+                sample.battery_energy = s.battery_energy;
+                sample.lap = s.lap;
+                sample.gear = s.current_gear;
+                samples.push_back(sample);
+            }
+        }
+        step_allocations += steps.count();
+        benchmark_sink = benchmark_sink + samples.back().velocity;
+    }
+    
+    // Прогон в арене потока: reset() и новый контекст
+    void runArenaScenario(MonotonicArena& arena, const F1PhysicsEngine::CarParameters& params,
+                          const ScenarioConfig& config, std::uint64_t& step_allocations) {
+        arena.reset();
+        ScenarioContext context(arena, params, config);
+        fillScenarioScript(context.inputs(), config.steps, config.steps / 4);
+        
+        AllocationScope steps;
+        context.run();
+        step_allocations += steps.count();
+        benchmark_sink = benchmark_sink + context.telemetry()[context.telemetryCount() - 1].velocity;
+    }
+    
+    template <typename Run>
+    ScenarioBenchmarkResult benchmarkScenario(const std::string& name, long runs, std::size_t steps_per_run,
+                                              int repeats, Run run) {
+        ScenarioBenchmarkResult result;
+        result.name = name;
+        double best = 0.0;
+        for (int r = 0; r < repeats; r++) {
+            std::uint64_t step_allocations = 0;
+            AllocationScope total;
+            auto start = std::chrono::steady_clock::now();
+            for (long i = 0; i < runs; i++) {
+                run(step_allocations);
+            }
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            best = (r == 0) ? ns : std::min(best, ns);
+            
+            // Выделения считаются по последнему повтору: арена к нему уже прогрета
+            result.allocations_per_run = static_cast<double>(total.count()) / runs;
+            result.step_allocations = step_allocations;
+        }
+        result.ns_per_run = best / runs;
+        result.ns_per_step = result.ns_per_run / steps_per_run;
+        return result;
+    }
+}
+
+std::vector<BenchmarkResult> runEngineBenchmarks(long steps, int repeats) {
+    std::vector<BenchmarkResult> results;
+    results.push_back(benchmarkEngine<F1PhysicsEngine>("engine.update", steps, repeats));
+    results.push_back(benchmarkAeroMap("engine.update.aeromap", steps, repeats));
+    results.push_back(benchmarkEngine<F1SpecializedEngine<DefaultCarConfig>>("engine.update.specialized", steps, repeats));
+    results.push_back(benchmarkFleet<double>("fleet.update.double", 64, steps, repeats));
+    results.push_back(benchmarkFleet<float>("fleet.update.float", 64, steps, repeats));
+    results.push_back(benchmarkFleetDriver<float>("fleet.driver.float", 64, steps, repeats));
+    results.push_back(benchmarkThermal("engine.update.thermal", steps, repeats));
+    results.push_back(benchmarkFleetDriver<float>("fleet.driver.float.thermal", 64, steps, repeats, true));
+    results.push_back(benchmarkRace("race.step.20", 20, steps, repeats));
+    return results;
+}
+
+std::vector<BenchmarkResult> runStageBenchmarks(long steps, int repeats) {
+    double overhead = stageClockOverhead();
+    std::vector<BenchmarkResult> results;
+    for (int stage = 0; stage < F1PhysicsEngine::STAGE_COUNT; stage++) {
+        results.push_back(BenchmarkResult{std::string("engine.stage.") + F1PhysicsEngine::stageName(stage),
+                                          0.0, steps});
+    }
+    
+    for (int r = 0; r < repeats; r++) {
+        ProfiledEngine engine;
+        std::uint64_t clock_start = F1PhysicsEngine::stageClock();
+        auto start = std::chrono::steady_clock::now();
+        driveScenario(engine, steps);
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        double ns_per_tick = ns / static_cast<double>(F1PhysicsEngine::stageClock() - clock_start);
+        
+        for (int stage = 0; stage < F1PhysicsEngine::STAGE_COUNT; stage++) {
+            double ticks = static_cast<double>(engine.profile.ticks[stage]) / steps - overhead;
+            double stage_ns = std::max(0.0, ticks) * ns_per_tick;
+            BenchmarkResult& result = results[stage];
+            result.ns_per_op = (r == 0) ? stage_ns : std::min(result.ns_per_op, stage_ns);
+        }
+    }
+    return results;
+}
+
+std::vector<BenchmarkResult> runOutputBenchmarks(long frames, int repeats, const std::string& log_path) {
+    std::vector<BenchmarkResult> results;
+    results.push_back(benchmarkLogWrite("telemetry.log.append", recordFrames(frames), log_path, repeats));
+    results.push_back(benchmarkPlot("plot.render", std::max(3L, frames / 2000), repeats));
+    return results;
+}
+
+std::vector<ScenarioBenchmarkResult> runScenarioBenchmarks(long runs, std::size_t steps_per_run, int repeats) {
+    F1PhysicsEngine::CarParameters params;
+    ScenarioConfig config;
+    config.steps = steps_per_run;
+    config.telemetry_every = 10;
+    
+    std::vector<ScenarioBenchmarkResult> results;
+    results.push_back(benchmarkScenario("scenario.heap", runs, steps_per_run, repeats,
+                                        [&](std::uint64_t& step_allocations) {
+                                            runHeapScenario(params, config, step_allocations);
+                                        }));
+    
+    MonotonicArena arena;
+    results.push_back(benchmarkScenario("scenario.arena", runs, steps_per_run, repeats,
+                                        [&](std::uint64_t& step_allocations) {
+                                            runArenaScenario(arena, params, config, step_allocations);
+                                        }));
+    return results;
+}
+
+std::vector<CodecBenchmarkResult> runCodecBenchmarks(double seconds, int repeats) {
+    std::vector<CodecBenchmarkResult> results;
+    const double rates[] = {100.0, 1000.0};
+    for (double rate : rates) {
+        TelemetryTrace trace = recordTrace(1.0 / rate, seconds);
+        std::string suffix = "." + std::to_string(static_cast<int>(rate)) + "hz";
+        results.push_back(benchmarkCodec("codec.gorilla" + suffix, trace, rate, CodecPredictor::Previous, repeats));
+        results.push_back(benchmarkCodec("codec.adaptive" + suffix, trace, rate, CodecPredictor::Adaptive, repeats));
+    }
+    return results;
+}
@@ -0,0 +1,69 @@
+#ifndef F1_BENCHMARK_H
+#define F1_BENCHMARK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Результат одного бенчмарка
+struct BenchmarkResult {
+    std::string name;
+    double ns_per_op = 0.0;     // Лучшее время из повторов [нс на операцию]
+    long operations = 0;        // Операций в одном повторе
+};
+
+// Бенчмарки движка: шаг update() рантайм-движка и специализированного шаблона
+// на одном и том же сценарии (разгон, торможение, переключения), рантайм-
+// движка с аэрокартой (скорость x клиренс), а также
+// парк из 64 машин в double и float (время на машино-шаг) - по сценарию
+// и под автопилотом на демо-трассе, и гонка F1Race из 20 машин под
+// автопилотами (race.step.20, на машино-шаг).
+std::vector<BenchmarkResult> runEngineBenchmarks(long steps, int repeats = 3);
+
+// Стадии шага рантайм-движка на том же сценарии (F1PhysicsEngine::
+// updateProfiled): нс на шаг по стадиям, цена чтения счетчика вычтена.
+// Имена engine.stage.<стадия>
+std::vector<BenchmarkResult> runStageBenchmarks(long steps, int repeats = 3);
+
+// Вывод: запись лога телеметрии (кадр на шаг сценария; нс на кадр, с
+// открытием и закрытием файла) и ASCII-график F1_Plot в память (три графика
+// по 30 с истории, как у F1_Output; нс на график)
+std::vector<BenchmarkResult> runOutputBenchmarks(long frames, int repeats = 3,
+                                                 const std::string& log_path = "/tmp/f1_benchmark.f1log");
+
+// Результат бенчмарка коротких прогонов сценария
+struct ScenarioBenchmarkResult {
+    std::string name;
+    double ns_per_run = 0.0;            // Лучшее из повторов, с созданием движка и буферов
+    double ns_per_step = 0.0;
+    double allocations_per_run = 0.0;   // Обращений к куче на прогон (последний повтор)
+    std::uint64_t step_allocations = 0; // Из них на шагах физики за повтор (должно быть 0)
+};
+
+// Развертка из runs коротких прогонов (разгон/торможение, телеметрия раз в
+// 10 шагов): движок и буферы в куче на каждый прогон против контекста в
+// арене потока. Нужен F1_AllocationCounter.cpp в сборке.
+std::vector<ScenarioBenchmarkResult> runScenarioBenchmarks(long runs = 20000, std::size_t steps_per_run = 500,
+                                                           int repeats = 3);
+
+// Результат бенчмарка кодека телеметрии на одной трассе
+struct CodecBenchmarkResult {
+    std::string name;
+    double rate_hz = 0.0;               // Частота отсчетов трассы
+    long samples = 0;
+    int channels = 0;
+    std::size_t raw_bytes = 0;          // 8 байт времени + 8 байт на канал на отсчет
+    std::size_t encoded_bytes = 0;
+    double ratio = 0.0;                 // raw / encoded
+    double encode_mb_per_s = 0.0;       // По сырым байтам, лучший из повторов
+    double decode_mb_per_s = 0.0;
+    bool lossless = false;              // Декодировано бит в бит
+};
+
+// Бенчмарки кодека: настоящие трассы движка (сценарий разгон/торможение,
+// каналы CarState и медленного состояния) на 100 Гц и 1 кГц, классический
+// Gorilla (предсказание прошлым значением) против адаптивного предсказателя.
+std::vector<CodecBenchmarkResult> runCodecBenchmarks(double seconds = 600.0, int repeats = 5);
+
+#endif // F1_BENCHMARK_H
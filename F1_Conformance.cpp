@@ -0,0 +1,439 @@
+#include "F1_Conformance.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include "F1_Fleet.h"
+#include "F1_SpecializedEngine.h"
+
+namespace {
+    constexpr char GOLDEN_MAGIC[8] = {'F', '1', 'G', 'O', 'L', 'D', '0', '1'};
+    constexpr std::uint32_t VERSION = 1;
+    
+    struct GoldenHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t trace_count;
+        std::uint32_t channel_count;
+        std::uint32_t reserved;
+    };
+    
+    // За именем трассы (u16 длина + байты), затем скрипт и отсчеты как есть
+    struct TraceHeader {
+        double dt;
+        std::uint32_t sample_every;
+        std::uint32_t input_count;
+        std::uint32_t sample_count;
+        std::uint32_t reserved;
+    };
+    
+    static_assert(sizeof(ConformanceInput) == 12, "ConformanceInput is stored as is");
+    
+    // Переключение по оборотам, как у пилотов (и у stepFleetScenario)
+    constexpr double UPSHIFT_RPM = 13500.0;
+    constexpr double DOWNSHIFT_RPM = 8000.0;
+    
+    template <typename Engine>
+    ConformanceSample engineSample(const Engine& engine) {
+        const F1PhysicsEngine::CarState& s = engine.getState();
+        return {s.position.x, s.lap_distance, s.velocity.x, s.engine_rpm, s.battery_energy,
+                engine.getSlowState().fuel_mass, static_cast<double>(s.current_gear), static_cast<double>(s.lap)};
+    }
+    
+    template <typename Engine>
+    void applyShift(Engine& engine, std::int32_t shift) {
+        if (shift > 0) {
+            engine.shiftUp();
+        } else if (shift < 0) {
+            engine.shiftDown();
+        }
+    }
+    
+    // === ЗАПИСЬ СКРИПТОВ ===
+    
+    // Эталонный движок, по которому пишется скрипт: шаг, решение о
+    // переключении по его оборотам, переключение - все попадает в скрипт
+    class ScriptRecorder {
+    public:
+        ScriptRecorder(const char* name, double dt, std::uint32_t sample_every) {
+            trace.name = name;
+            trace.dt = dt;
+            trace.sample_every = sample_every;
+        }
+        
+        // seconds с постоянными педалями; auto_shift - переключения по оборотам
+        void drive(double seconds, float throttle, float brake, bool auto_shift = true) {
+            long steps = std::lround(seconds / trace.dt);
+            for (long i = 0; i < steps; i++) {
+                step(throttle, brake, auto_shift ? 2 : 0);
+            }
+        }
+        
+        // Один шаг; shift = 2 - решение водителя по оборотам
+        void step(float throttle, float brake, std::int32_t shift) {
+            engine.update(trace.dt, throttle, brake);
+            if (shift == 2) {
+                const F1PhysicsEngine::CarState& s = engine.getState();
+                shift = 0;
+                if (s.engine_rpm > UPSHIFT_RPM) {
+                    shift = 1;
+                } else if (brake > 0.0f && s.clutch_locked && s.engine_rpm < DOWNSHIFT_RPM && s.current_gear > 1) {
+                    shift = -1;
+                }
+            }
+            applyShift(engine, shift);
+            trace.inputs.push_back({throttle, brake, shift});
+        }
+        
+        int gear() const { return engine.getState().current_gear; }
+        
+        GoldenTrace finish() {
+            recordGoldenTrace(trace);
+            return std::move(trace);
+        }
+    
+    private:
+        GoldenTrace trace;
+        F1PhysicsEngine engine;
+    };
+    
+    // === ВАРИАНТЫ ===
+    
+    // Прогон варианта: Sim::step(dt, вход), Sim::sample(машина), Sim::LANES машин
+    template <typename Engine>
+    struct EngineSim {
+        static constexpr std::size_t LANES = 1;
+        Engine engine;
+        
+        void step(double dt, const ConformanceInput& input) {
+            engine.update(dt, input.throttle, input.brake);
+            applyShift(engine, input.shift);
+        }
+        ConformanceSample sample(std::size_t) const { return engineSample(engine); }
+    };
+    
+    struct ProfiledSim {
+        static constexpr std::size_t LANES = 1;
+        F1PhysicsEngine engine;
+        F1PhysicsEngine::StageProfile profile;
+        
+        void step(double dt, const ConformanceInput& input) {
+            engine.updateProfiled(dt, input.throttle, input.brake, 0.0, profile);
+            applyShift(engine, input.shift);
+        }
+        ConformanceSample sample(std::size_t) const { return engineSample(engine); }
+    };
+    
+    // Блок парка из одинаковых машин: шаг идет векторным путем
+    template <typename Scalar>
+    struct FleetSim {
+        static constexpr std::size_t LANES = F1Fleet<Scalar>::LANES;
+        F1Fleet<Scalar> fleet{LANES};
+        std::array<float, LANES> throttle{};
+        std::array<float, LANES> brake{};
+        
+        void step(double dt, const ConformanceInput& input) {
+            throttle.fill(input.throttle);
+            brake.fill(input.brake);
+            fleet.update(dt, throttle.data(), brake.data());
+            for (std::size_t i = 0; i < LANES; i++) {
+                if (input.shift > 0) {
+                    fleet.shiftUp(i);
+                } else if (input.shift < 0) {
+                    fleet.shiftDown(i);
+                }
+            }
+        }
+        ConformanceSample sample(std::size_t car) const {
+            return {fleet.getPosition(car), fleet.getLapDistance(car), fleet.getVelocity(car),
+                    fleet.getEngineRPM(car), fleet.getBatteryEnergy(car), fleet.getFuelMass(car),
+                    static_cast<double>(fleet.getGear(car)), static_cast<double>(fleet.getLap(car))};
+        }
+    };
+    
+    template <typename Sim>
+    ConformanceResult runVariant(const char* variant, const GoldenTrace& trace,
+                                 const ConformanceTolerance& tolerance, int repeats) {
+        ConformanceResult result;
+        result.variant = variant;
+        result.trace = trace.name;
+        result.tolerance = tolerance;
+        result.ns_per_step = std::numeric_limits<double>::max();
+        
+        // Отсчеты копятся за прогон и сравниваются после замера
+        const std::uint32_t every = std::max<std::uint32_t>(1, trace.sample_every);
+        std::vector<ConformanceSample> samples;
+        samples.reserve(trace.samples.size() * Sim::LANES);
+        for (int r = 0; r < repeats; r++) {
+            Sim sim;
+            samples.clear();
+            auto start = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < trace.inputs.size(); i++) {
+                sim.step(trace.dt, trace.inputs[i]);
+                if ((i + 1) % every == 0) {
+                    for (std::size_t car = 0; car < Sim::LANES; car++) {
+                        samples.push_back(sim.sample(car));
+                    }
+                }
+            }
+            double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            result.ns_per_step = std::min(result.ns_per_step, ns / (trace.inputs.size() * Sim::LANES));
+        }
+        
+        std::size_t count = std::min(trace.samples.size(), samples.size() / Sim::LANES);
+        for (std::size_t k = 0; k < count; k++) {
+            double time = (k + 1) * every * trace.dt;
+            for (std::size_t car = 0; car < Sim::LANES; car++) {
+                const ConformanceSample& value = samples[k * Sim::LANES + car];
+                for (int c = 0; c < CONF_CHANNEL_COUNT; c++) {
+                    double error = std::abs(value[c] - trace.samples[k][c]);
+                    if (std::isnan(error)) {
+                        error = std::numeric_limits<double>::infinity();
+                    }
+                    if (error > result.max_error[c]) {
+                        result.max_error[c] = error;
+                        result.error_time[c] = time;
+                    }
+                }
+            }
+        }
+        // Вариант не дошел до конца трассы (или трасса длиннее скрипта)
+        if (count < trace.samples.size()) {
+            result.max_error.fill(std::numeric_limits<double>::infinity());
+        }
+        return result;
+    }
+}
+
+const char* conformanceChannelName(int channel) {
+    switch (channel) {
+        case CONF_POSITION: return "position";
+        case CONF_LAP_DISTANCE: return "lap_distance";
+        case CONF_VELOCITY: return "velocity";
+        case CONF_ENGINE_RPM: return "engine_rpm";
+        case CONF_BATTERY_ENERGY: return "battery_energy";
+        case CONF_FUEL_MASS: return "fuel_mass";
+        case CONF_GEAR: return "gear";
+        case CONF_LAP: return "lap";
+    }
+    return "?";
+}
+
+// === КОРПУС ===
+
+std::vector<GoldenTrace> makeConformanceCorpus(double dt, std::uint32_t sample_every) {
+    std::vector<GoldenTrace> corpus;
+    
+    // Старт с места: сцепление, разгон по всем передачам
+    ScriptRecorder launch("launch", dt, sample_every);
+    launch.drive(30.0, 1.0f, 0.0f);
+    corpus.push_back(launch.finish());
+    
+    // Тормоз в пол с высокой скорости: рекуперация, понижения, остановка
+    ScriptRecorder braking("full_braking", dt, sample_every);
+    braking.drive(25.0, 1.0f, 0.0f);
+    braking.drive(8.0, 0.0f, 1.0f);
+    corpus.push_back(braking.finish());
+    
+    // Шквал переключений: два вверх, одно вниз каждые 0.15 с под рваным газом,
+    // затем понижения на каждом шаге торможения - сцепление размыкается и
+    // замыкается снова
+    ScriptRecorder storm("shift_storm", dt, sample_every);
+    storm.drive(8.0, 1.0f, 0.0f);
+    long storm_steps = std::lround(20.0 / dt);
+    long shift_period = std::max(1L, std::lround(0.15 / dt));
+    long pedal_period = std::max(1L, std::lround(0.65 / dt));
+    long shifts = 0;
+    for (long i = 0; i < storm_steps; i++) {
+        float throttle = i % pedal_period < pedal_period * 6 / 10 ? 1.0f : 0.35f;
+        std::int32_t shift = 0;
+        if (i % shift_period == 0) {
+            shift = shifts++ % 3 == 2 ? -1 : 1;
+            if (shift > 0 && storm.gear() >= 8) {
+                shift = -1;
+            }
+        }
+        storm.step(throttle, 0.0f, shift);
+    }
+    long brake_steps = std::lround(6.0 / dt);
+    for (long i = 0; i < brake_steps; i++) {
+        storm.step(0.0f, 0.6f, i % shift_period == 0 && storm.gear() > 1 ? -1 : 0);
+    }
+    corpus.push_back(storm.finish());
+    
+    // Накат: разгон через линию круга, затем без педалей и без переключений -
+    // обороты падают ниже холостых, и сцепление размыкается
+    ScriptRecorder coast("coast_down", dt, sample_every);
+    coast.drive(45.0, 1.0f, 0.0f);
+    coast.drive(60.0, 0.0f, 0.0f, false);
+    corpus.push_back(coast.finish());
+    
+    return corpus;
+}
+
+void recordGoldenTrace(GoldenTrace& trace) {
+    const std::uint32_t every = std::max<std::uint32_t>(1, trace.sample_every);
+    EngineSim<F1PhysicsEngine> reference;
+    trace.samples.clear();
+    trace.samples.reserve(trace.inputs.size() / every);
+    for (std::size_t i = 0; i < trace.inputs.size(); i++) {
+        reference.step(trace.dt, trace.inputs[i]);
+        if ((i + 1) % every == 0) {
+            trace.samples.push_back(reference.sample(0));
+        }
+    }
+}
+
+// === ФАЙЛ КОРПУСА ===
+
+bool writeGoldenTraces(const std::string& path, const std::vector<GoldenTrace>& corpus) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    
+    GoldenHeader header;
+    std::memcpy(header.magic, GOLDEN_MAGIC, 8);
+    header.version = VERSION;
+    header.trace_count = static_cast<std::uint32_t>(corpus.size());
+    header.channel_count = CONF_CHANNEL_COUNT;
+    header.reserved = 0;
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    
+    for (const GoldenTrace& trace : corpus) {
+        std::uint16_t length = static_cast<std::uint16_t>(std::min<std::size_t>(trace.name.size(), 0xFFFF));
+        TraceHeader th;
+        th.dt = trace.dt;
+        th.sample_every = trace.sample_every;
+        th.input_count = static_cast<std::uint32_t>(trace.inputs.size());
+        th.sample_count = static_cast<std::uint32_t>(trace.samples.size());
+        th.reserved = 0;
+        ok = ok && std::fwrite(&length, 2, 1, file) == 1
+                && std::fwrite(trace.name.data(), 1, length, file) == length
+                && std::fwrite(&th, sizeof(th), 1, file) == 1
+                && std::fwrite(trace.inputs.data(), sizeof(ConformanceInput), trace.inputs.size(), file) == trace.inputs.size()
+                && std::fwrite(trace.samples.data(), sizeof(ConformanceSample), trace.samples.size(), file) == trace.samples.size();
+    }
+    
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+}
+
+bool readGoldenTraces(const std::string& path, std::vector<GoldenTrace>& corpus) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    
+    GoldenHeader header;
+    bool ok = std::fread(&header, sizeof(header), 1, file) == 1
+              && std::memcmp(header.magic, GOLDEN_MAGIC, 8) == 0
+              && header.version == VERSION
+              && header.channel_count == CONF_CHANNEL_COUNT;
+    
+    std::vector<GoldenTrace> traces(ok ? header.trace_count : 0);
+    for (GoldenTrace& trace : traces) {
+        std::uint16_t length = 0;
+        TraceHeader th;
+        ok = ok && std::fread(&length, 2, 1, file) == 1;
+        trace.name.resize(ok ? length : 0);
+        ok = ok && std::fread(&trace.name[0], 1, length, file) == length
+                && std::fread(&th, sizeof(th), 1, file) == 1
+                && th.sample_every > 0
+                && th.sample_count == th.input_count / th.sample_every;
+        if (!ok) {
+            break;
+        }
+        trace.dt = th.dt;
+        trace.sample_every = th.sample_every;
+        trace.inputs.resize(th.input_count);
+        trace.samples.resize(th.sample_count);
+        ok = std::fread(trace.inputs.data(), sizeof(ConformanceInput), trace.inputs.size(), file) == trace.inputs.size()
+             && std::fread(trace.samples.data(), sizeof(ConformanceSample), trace.samples.size(), file) == trace.samples.size();
+    }
+    
+    std::fclose(file);
+    if (ok) {
+        corpus = std::move(traces);
+    }
+    return ok;
+}
+
+// === ДОПУСКИ ===
+
+// Допуски - с запасом на порядки над расхождением на корпусе по умолчанию,
+// чтобы другой компилятор или -march их не пересекал, а ошибка в физике - да
+
+ConformanceTolerance engineTolerance() {
+    ConformanceTolerance t{};
+    t[CONF_POSITION] = 1e-9;
+    t[CONF_LAP_DISTANCE] = 1e-9;
+    t[CONF_VELOCITY] = 1e-10;
+    t[CONF_ENGINE_RPM] = 1e-8;
+    t[CONF_BATTERY_ENERGY] = 1e-7;
+    t[CONF_FUEL_MASS] = 1e-12;
+    return t;
+}
+
+ConformanceTolerance fleetDoubleTolerance() {
+    ConformanceTolerance t{};
+    t[CONF_POSITION] = 1e-3;
+    t[CONF_LAP_DISTANCE] = 1e-3;
+    t[CONF_VELOCITY] = 1e-4;
+    t[CONF_ENGINE_RPM] = 0.1;
+    t[CONF_BATTERY_ENERGY] = 1.0;
+    t[CONF_FUEL_MASS] = 1e-7;
+    return t;
+}
+
+ConformanceTolerance fleetFloatTolerance() {
+    ConformanceTolerance t{};
+    t[CONF_POSITION] = 0.01;
+    t[CONF_LAP_DISTANCE] = 0.01;
+    t[CONF_VELOCITY] = 2e-3;
+    t[CONF_ENGINE_RPM] = 0.5;
+    t[CONF_BATTERY_ENERGY] = 100.0;
+    t[CONF_FUEL_MASS] = 1e-5;
+    return t;
+}
+
+// === ПРОГОН ===
+
+bool ConformanceResult::passed() const {
+    for (int c = 0; c < CONF_CHANNEL_COUNT; c++) {
+        if (!(max_error[c] <= tolerance[c])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int ConformanceResult::worstChannel() const {
+    int worst = 0;
+    double worst_share = -1.0;
+    for (int c = 0; c < CONF_CHANNEL_COUNT; c++) {
+        double share = max_error[c] > 0.0 ? (tolerance[c] > 0.0 ? max_error[c] / tolerance[c]
+                                                               : std::numeric_limits<double>::infinity())
+                                          : 0.0;
+        if (share > worst_share) {
+            worst = c;
+            worst_share = share;
+        }
+    }
+    return worst;
+}
+
+std::vector<ConformanceResult> runConformance(const std::vector<GoldenTrace>& corpus, int repeats) {
+    std::vector<ConformanceResult> results;
+    for (const GoldenTrace& trace : corpus) {
+        results.push_back(runVariant<EngineSim<F1PhysicsEngine>>("engine", trace, engineTolerance(), repeats));
+        results.push_back(runVariant<ProfiledSim>("engine.profiled", trace, engineTolerance(), repeats));
+        results.push_back(runVariant<EngineSim<F1SpecializedEngine<DefaultCarConfig>>>(
+            "engine.specialized", trace, engineTolerance(), repeats));
+        results.push_back(runVariant<FleetSim<double>>("fleet.double", trace, fleetDoubleTolerance(), repeats));
+        results.push_back(runVariant<FleetSim<float>>("fleet.float", trace, fleetFloatTolerance(), repeats));
+    }
+    return results;
+}
@@ -0,0 +1,98 @@
+#ifndef F1_CONFORMANCE_H
+#define F1_CONFORMANCE_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Проверка соответствия быстрых путей эталону. Корпус - записанные скрипты
+// педалей и переключений (старт, торможение в пол, шквал переключений,
+// накат) и эталонные трассы состояния F1PhysicsEngine::update по ним.
+// Каждый вариант движка (профилируемый шаг, специализированный шаблон, парк
+// в double и float - векторный путь) прогоняет те же скрипты; отчет - максимум
+// расхождения с эталоном по каждому каналу против допуска и время шага.
+//
+// Переключения - часть скрипта, а не решение варианта по его оборотам:
+// иначе малое расхождение float на пороге дало бы другую передачу, и дальше
+// сравнивались бы разные заезды.
+
+// Каналы трассы
+enum ConformanceChannel {
+    CONF_POSITION,                      // [м]
+    CONF_LAP_DISTANCE,                  // [м]
+    CONF_VELOCITY,                      // [м/с]
+    CONF_ENGINE_RPM,
+    CONF_BATTERY_ENERGY,                // [Дж]
+    CONF_FUEL_MASS,                     // [кг]
+    CONF_GEAR,
+    CONF_LAP,
+    CONF_CHANNEL_COUNT
+};
+
+const char* conformanceChannelName(int channel);
+
+using ConformanceSample = std::array<double, CONF_CHANNEL_COUNT>;
+
+// Вход на один шаг скрипта
+struct ConformanceInput {
+    float throttle = 0.0f;              // 0..1
+    float brake = 0.0f;                 // 0..1
+    std::int32_t shift = 0;             // После шага: +1 - вверх, -1 - вниз
+};
+
+// Скрипт и эталонная трасса по нему
+struct GoldenTrace {
+    std::string name;
+    double dt = 0.01;
+    std::uint32_t sample_every = 10;    // Отсчет после каждого sample_every-го шага
+    std::vector<ConformanceInput> inputs;
+    std::vector<ConformanceSample> samples;
+};
+
+// Корпус по умолчанию: скрипты записываются с водителя, который переключается
+// по оборотам эталонного движка; трассы - тем же эталоном (параметры машины
+// по умолчанию)
+std::vector<GoldenTrace> makeConformanceCorpus(double dt = 0.01, std::uint32_t sample_every = 10);
+
+// Трасса эталона по скрипту trace.inputs
+void recordGoldenTrace(GoldenTrace& trace);
+
+// Файл корпуса: скрипты и трассы бит в бит. false - ошибка файла или формата
+bool writeGoldenTraces(const std::string& path, const std::vector<GoldenTrace>& corpus);
+bool readGoldenTraces(const std::string& path, std::vector<GoldenTrace>& corpus);
+
+// Допуск по каналам (абсолютный). Передача и круг сравниваются точно
+using ConformanceTolerance = std::array<double, CONF_CHANNEL_COUNT>;
+
+// Варианты движка с тем же CarState: расходятся с эталоном только порядком
+// операций (свернутые константы, FMA)
+ConformanceTolerance engineTolerance();
+
+// Парк в double: поля, которые CarState хранит во float (тормозной фактор,
+// энергия ERS за круг, накопители работы), у него в double - расхождение
+// на уровне округления этих полей
+ConformanceTolerance fleetDoubleTolerance();
+
+// Парк во float: ошибка округления всего состояния, накопленная за скрипт
+ConformanceTolerance fleetFloatTolerance();
+
+// Расхождение одного варианта на одной трассе
+struct ConformanceResult {
+    std::string variant;
+    std::string trace;
+    ConformanceSample max_error{};      // Максимум |вариант - эталон| по отсчетам (и машинам парка)
+    ConformanceSample error_time{};     // Время отсчета с этим максимумом [с]
+    ConformanceTolerance tolerance{};
+    double ns_per_step = 0.0;           // Лучшее из повторов (парк - на машино-шаг)
+    
+    bool passed() const;
+    int worstChannel() const;           // Канал с наибольшей долей допуска
+};
+
+// Все варианты на всех трассах корпуса: engine (сам эталон против файла),
+// engine.profiled, engine.specialized, fleet.double, fleet.float.
+// Парк гоняет LANES одинаковых машин, проверяется каждая
+std::vector<ConformanceResult> runConformance(const std::vector<GoldenTrace>& corpus, int repeats = 3);
+
+#endif // F1_CONFORMANCE_H
@@ -0,0 +1,122 @@
+#include "F1_Driver.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "F1_PhysicsCore.h"
+
+// === ПРОФИЛЬ СКОРОСТИ ===
+
+SpeedProfile::SpeedProfile(double track_length, const std::vector<double>& points)
+    : track_length(track_length) {
+    if (points.empty() || track_length <= 0) {
+        this->track_length = 0.0;
+        return;
+    }
+    count = static_cast<int>(points.size());
+    last_index = count - 1;
+    inv_spacing = count / track_length;
+    speeds.assign(points.begin(), points.end());
+    speeds.push_back(speeds.front());
+}
+
+SpeedProfile SpeedProfile::fromTrack(const Track& track, const F1PhysicsEngine::CarParameters& car,
+                                     const SpeedProfileConfig& config) {
+    std::size_t count = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(track.length / config.spacing)));
+    double spacing = track.length / count;
+    std::vector<double> speeds(count, config.max_speed);
+    
+    // 1. Повороты: узлы внутри дуги - на предельной скорости
+    for (std::size_t c = 0; c < track.corners.size(); c++) {
+        const TrackCorner& corner = track.corners[c];
+        double limit = config.corner_margin * track.cornerSpeed(static_cast<int>(c), car.tire_friction);
+        std::size_t first = static_cast<std::size_t>(std::floor(corner.distance / spacing));
+        std::size_t last = static_cast<std::size_t>(std::ceil((corner.distance + corner.length) / spacing));
+        for (std::size_t i = first; i <= last; i++) {
+            double& v = speeds[i % count];
+            v = std::min(v, limit);
+        }
+    }
+    
+    // 2. Торможение: проход назад, v_i <= sqrt(v_{i+1}² + 2·a·Δ). Два круга -
+    // чтобы кривая перед первым поворотом дотянулась через линию старта
+    double full_mass = car.mass + car.fuel_initial_mass;
+    double decel = config.braking_margin * std::min(car.tire_friction * 9.81, car.max_brake_force / full_mass);
+    for (std::size_t k = 2 * count; k-- > 0;) {
+        double next = speeds[(k + 1) % count];
+        double& v = speeds[k % count];
+        v = std::min(v, std::sqrt(next * next + 2.0 * decel * spacing));
+    }
+    
+    return SpeedProfile(track.length, speeds);
+}
+
+ErsDeploymentMap buildDeploymentMap(const SpeedProfile& profile, const F1PhysicsEngine::CarParameters& car,
+                                    double bin_length) {
+    double length = profile.trackLength();
+    int bin_count = std::max(1, static_cast<int>(std::lround(length / bin_length)));
+    ErsDeploymentMap map(length, bin_count);
+    if (profile.empty()) {
+        return map;
+    }
+    
+    // Пиковая мощность ДВС по кривой момента (на полном газу)
+    double engine_power = 0.0;
+    for (int k = 0; k <= 100; k++) {
+        double rpm = car.peak_rpm + (car.max_rpm - car.peak_rpm) * k / 100.0;
+        double torque = f1core::torqueCurve(rpm, car.peak_rpm, car.max_rpm, car.max_torque);
+        engine_power = std::max(engine_power, torque * rpm / f1core::RAD_S_TO_RPM);
+    }
+    double power = engine_power + car.ers.mguk_max_power;
+    double mass = car.mass + car.fuel_initial_mass;
+    
+    // Разгон вперед по узлам профиля, два круга - чтобы выход из последнего
+    // поворота дотянулся через линию старта. Время узла копится в его участок,
+    // отдельно - время на торможении (скорость падает по профилю)
+    int count = profile.pointCount();
+    double spacing = length / count;
+    std::vector<double> bin_time(bin_count, 0.0);
+    std::vector<double> braking_time(bin_count, 0.0);
+    double v = profile.at(0.0);
+    for (int k = 1; k <= 2 * count; k++) {
+        int i = k % count;
+        double accel = std::min(car.tire_friction * 9.81, power / (mass * std::max(v, 1.0)));
+        double next = std::min(profile.at(i * spacing), std::sqrt(v * v + 2.0 * accel * spacing));
+        if (k > count) {
+            int bin = std::min(bin_count - 1, static_cast<int>(i * spacing / map.binLength()));
+            double time = spacing / std::max(next, 1.0);
+            bin_time[bin] += time;
+            braking_time[bin] += next < v ? time : 0.0;
+        }
+        v = next;
+    }
+    
+    // Скорость участка - длина на время (среднее по времени, а не по узлам).
+    // На торможении газа нет и отдавать нечего: такие участки идут в очередь
+    // последними и остаются без отдачи
+    std::vector<double> reference_speed(bin_count);
+    std::vector<bool> braking(bin_count);
+    for (int bin = 0; bin < bin_count; bin++) {
+        braking[bin] = bin_time[bin] <= 0.0 || braking_time[bin] > 0.5 * bin_time[bin];
+        reference_speed[bin] = braking[bin] ? std::numeric_limits<double>::max() : map.binLength() / bin_time[bin];
+    }
+    map.buildFromSpeedProfile(reference_speed, car.ers);
+    for (int bin = 0; bin < bin_count; bin++) {
+        if (braking[bin]) {
+            map.setBin(bin, 0.0);
+        }
+    }
+    return map;
+}
+
+// === ПИЛОТ ===
+
+DriverCommand SpeedProfileDriver::drive(F1PhysicsEngine& car, DriverState& state, double dt) const {
+    DriverCommand command = control(car, state, dt);
+    if (command.shift > 0) {
+        car.shiftUp();
+    } else if (command.shift < 0) {
+        car.shiftDown();
+    }
+    car.update(dt, command.throttle, command.brake);
+    return command;
+}
@@ -0,0 +1,175 @@
+#ifndef F1_DRIVER_H
+#define F1_DRIVER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "F1_Fleet.h"
+#include "F1_Physics_build_2.h"
+#include "F1_Track.h"
+
+// Автопилот для прогонов без клавиатуры: едет по профилю целевой скорости
+// по дистанции круга и выдает аналоговые газ/тормоз и переключения.
+// Профиль считается один раз на трассу и общий для всех машин; у машины
+// свое только состояние регулятора (одно число), поэтому шаг пилота - два
+// чтения профиля и несколько умножений и годится для парка в тысячи машин.
+
+struct SpeedProfileConfig {
+    double spacing = 5.0;               // Шаг сетки профиля [м]
+    double corner_margin = 0.95;        // Доля предельной скорости поворота sqrt(μ·g·R)
+    double braking_margin = 0.6;        // Доля замедления min(μ·g, F_торм/m) на торможении
+    double max_speed = 100.0;           // Потолок профиля [м/с]
+};
+
+// Целевая скорость по дистанции круга: значения на равномерной сетке,
+// между узлами - линейно. Круг замкнут: за последним узлом снова первый.
+class SpeedProfile {
+public:
+    SpeedProfile() = default;
+    
+    // speeds[i] - скорость на дистанции i·track_length/speeds.size() [м/с]
+    SpeedProfile(double track_length, const std::vector<double>& speeds);
+    
+    // Повороты трассы на предельной скорости (с запасом), перед ними - кривые
+    // торможения v² = v_поворота² + 2·a·d. Разгон не ограничивается: его
+    // ограничивает сама машина. Масса - с полным баком.
+    static SpeedProfile fromTrack(const Track& track, const F1PhysicsEngine::CarParameters& car,
+                                  const SpeedProfileConfig& config = SpeedProfileConfig());
+    
+    // [м/с], дистанция в [0, 2·длина круга). Пустой профиль - 0.
+    double at(double lap_distance) const {
+        double x = lap_distance * inv_spacing;
+        x = x >= count ? x - count : x;
+        x = std::min(std::max(x, 0.0), static_cast<double>(count));
+        int i = std::min(static_cast<int>(x), last_index);
+        double fraction = x - i;
+        return speeds[i] + (speeds[i + 1] - speeds[i]) * fraction;
+    }
+    
+    bool empty() const { return count == 0; }
+    double trackLength() const { return track_length; }
+    int pointCount() const { return count; }
+
+private:
+    double track_length = 0.0;
+    double inv_spacing = 0.0;
+    int count = 0;
+    int last_index = 0;                 // count - 1, но не меньше 0
+    std::vector<float> speeds = std::vector<float>(2, 0.0f);   // count + 1 узлов: последний повторяет первый
+};
+
+// Карта отдачи ERS для трассы профиля (ErsDeploymentMap::buildFromSpeedProfile).
+// Профиль ограничивает только повороты и торможения, поэтому эталонная
+// скорость участка - профиль плюс разгон из поворотов с ускорением
+// min(μ·g, P/(m·v)), P - пиковая мощность ДВС и MGU-K. Иначе выходы из
+// поворотов, где энергия дает больше всего, выглядели бы быстрыми.
+ErsDeploymentMap buildDeploymentMap(const SpeedProfile& profile, const F1PhysicsEngine::CarParameters& car,
+                                    double bin_length = 50.0);
+
+struct DriverConfig {
+    // Упреждение: цель - меньшая из скоростей профиля здесь и на v·preview_time
+    // впереди. Покрывает запаздывание тормозной рампы (фактор растет со скоростью
+    // brake_factor_coef) - без него машина въезжает в поворот быстрее профиля.
+    double preview_time = 0.6;          // [с]
+    
+    // ПИ-регулятор скорости: u = kp·e + ∫ki·e dt, u > 0 - газ, u < 0 - тормоз
+    double kp = 0.5;                    // [1/(м/с)]
+    double ki = 0.2;                    // [1/(м/с·с)]
+    
+    // Переключения по оборотам
+    double upshift_rpm = 13500.0;
+    double downshift_rpm = 8000.0;      // Только при замкнутом сцеплении
+};
+
+// Состояние регулятора одной машины
+struct DriverState {
+    float integral = 0.0f;              // Интегральная часть u (обрезана до [-1, 1])
+};
+
+struct DriverCommand {
+    float throttle = 0.0f;              // 0..1
+    float brake = 0.0f;                 // 0..1
+    int shift = 0;                      // +1 - вверх, -1 - вниз, 0 - держать
+};
+
+class SpeedProfileDriver {
+public:
+    // Профиль не копируется и должен жить дольше пилота
+    explicit SpeedProfileDriver(const SpeedProfile& profile, const DriverConfig& config = DriverConfig())
+        : profile(&profile), config(config) {}
+    
+    // Команда на шаг dt по состоянию машины
+    DriverCommand control(double lap_distance, double velocity, double engine_rpm, bool clutch_locked,
+                          DriverState& state, double dt) const;
+    
+    DriverCommand control(const F1PhysicsEngine& car, DriverState& state, double dt) const {
+        const F1PhysicsEngine::CarState& s = car.getState();
+        return control(s.lap_distance, s.velocity.x, s.engine_rpm, s.clutch_locked, state, dt);
+    }
+    
+    // Полный шаг машины: переключение и update() по команде
+    DriverCommand drive(F1PhysicsEngine& car, DriverState& state, double dt) const;
+    
+    // Шаг парка: команда и переключение каждой машине, затем update() парка.
+    // Буферы педалей переиспользуются между шагами.
+    template <typename Scalar>
+    void driveFleet(F1Fleet<Scalar>& fleet, std::vector<DriverState>& states,
+                    std::vector<float>& throttle, std::vector<float>& brake, double dt) const;
+    
+    const SpeedProfile& getProfile() const { return *profile; }
+    const DriverConfig& getConfig() const { return config; }
+
+private:
+    const SpeedProfile* profile;
+    DriverConfig config;
+};
+
+inline DriverCommand SpeedProfileDriver::control(double lap_distance, double velocity, double engine_rpm,
+                                                 bool clutch_locked, DriverState& state, double dt) const {
+    // Цель с упреждением: профиль уже содержит кривые торможения, упреждение
+    // только компенсирует рампу тормоза
+    double target = std::min(profile->at(lap_distance),
+                             profile->at(lap_distance + velocity * config.preview_time));
+    double error = target - velocity;
+    
+    // ПИ: интеграл копится, только пока выход не в насыщении (анти-виндап).
+    // Без ветвлений - у машин парка разные режимы, и переходы плохо предсказываются
+    double proportional = config.kp * error;
+    double integral = state.integral;
+    double accumulated = std::min(std::max(integral + config.ki * error * dt, -1.0), 1.0);
+    integral = std::abs(proportional + integral) < 1.0 ? accumulated : integral;
+    state.integral = static_cast<float>(integral);
+    double output = proportional + integral;
+    
+    DriverCommand command;
+    command.throttle = static_cast<float>(std::min(std::max(output, 0.0), 1.0));
+    command.brake = static_cast<float>(std::min(std::max(-output, 0.0), 1.0));
+    int shift = engine_rpm > config.upshift_rpm ? 1 : 0;
+    shift = clutch_locked && engine_rpm < config.downshift_rpm ? -1 : shift;
+    command.shift = shift;
+    return command;
+}
+
+template <typename Scalar>
+void SpeedProfileDriver::driveFleet(F1Fleet<Scalar>& fleet, std::vector<DriverState>& states,
+                                    std::vector<float>& throttle, std::vector<float>& brake, double dt) const {
+    const std::size_t count = fleet.size();
+    states.resize(count);
+    throttle.resize(count);
+    brake.resize(count);
+    
+    for (std::size_t i = 0; i < count; i++) {
+        DriverCommand command = control(fleet.getLapDistance(i), fleet.getVelocity(i), fleet.getEngineRPM(i),
+                                        fleet.isClutchLocked(i), states[i], dt);
+        throttle[i] = command.throttle;
+        brake[i] = command.brake;
+        if (command.shift > 0) {
+            fleet.shiftUp(i);
+        } else if (command.shift < 0) {
+            fleet.shiftDown(i);
+        }
+    }
+    fleet.update(dt, throttle.data(), brake.data());
+}
+
+#endif // F1_DRIVER_H
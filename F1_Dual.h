@@ -0,0 +1,130 @@
+#ifndef F1_DUAL_H
+#define F1_DUAL_H
+
+#include <array>
+#include <cmath>
+
+// Дуальное число прямого автоматического дифференцирования: значение и
+// производные по N параметрам сразу. Формула, шаблонная по скаляру
+// (шаг f1core), посчитанная на Dual<N>, за один проход дает и результат,
+// и его градиент.
+//
+// Значение считается теми же операциями, что и на double (деление - делением,
+// не умножением на обратное), поэтому совпадает с double бит в бит.
+// Сравнения - только по значению: ветви выбираются как на double, а
+// производная берется у выбранной ветви.
+template <int N>
+struct Dual {
+    double value = 0.0;
+    std::array<double, N> grad{};
+    
+    Dual() = default;
+    Dual(double value) : value(value) {}    // Константа: нулевые производные
+    
+    // Независимая переменная номер index (d/dx_index = 1)
+    static Dual variable(double value, int index) {
+        Dual d(value);
+        d.grad[index] = 1.0;
+        return d;
+    }
+    
+    Dual& operator+=(const Dual& o) {
+        value += o.value;
+        for (int i = 0; i < N; i++) grad[i] += o.grad[i];
+        return *this;
+    }
+    Dual& operator-=(const Dual& o) {
+        value -= o.value;
+        for (int i = 0; i < N; i++) grad[i] -= o.grad[i];
+        return *this;
+    }
+    Dual& operator*=(const Dual& o) {
+        for (int i = 0; i < N; i++) grad[i] = grad[i] * o.value + value * o.grad[i];
+        value *= o.value;
+        return *this;
+    }
+    Dual& operator/=(const Dual& o) {
+        double inv = 1.0 / o.value;
+        value /= o.value;
+        for (int i = 0; i < N; i++) grad[i] = (grad[i] - value * o.grad[i]) * inv;
+        return *this;
+    }
+};
+
+// === АРИФМЕТИКА ===
+
+template <int N> Dual<N> operator+(Dual<N> a, const Dual<N>& b) { return a += b; }
+template <int N> Dual<N> operator-(Dual<N> a, const Dual<N>& b) { return a -= b; }
+template <int N> Dual<N> operator*(Dual<N> a, const Dual<N>& b) { return a *= b; }
+template <int N> Dual<N> operator/(Dual<N> a, const Dual<N>& b) { return a /= b; }
+
+template <int N> Dual<N> operator+(Dual<N> a, double b) { a.value += b; return a; }
+template <int N> Dual<N> operator+(double a, Dual<N> b) { b.value += a; return b; }
+template <int N> Dual<N> operator-(Dual<N> a, double b) { a.value -= b; return a; }
+template <int N> Dual<N> operator-(double a, const Dual<N>& b) { return Dual<N>(a) - b; }
+
+template <int N>
+Dual<N> operator*(Dual<N> a, double b) {
+    a.value *= b;
+    for (int i = 0; i < N; i++) a.grad[i] *= b;
+    return a;
+}
+template <int N> Dual<N> operator*(double a, const Dual<N>& b) { return b * a; }
+template <int N>
+Dual<N> operator/(Dual<N> a, double b) {
+    a.value /= b;
+    for (int i = 0; i < N; i++) a.grad[i] /= b;
+    return a;
+}
+template <int N> Dual<N> operator/(double a, const Dual<N>& b) { return Dual<N>(a) / b; }
+
+template <int N> Dual<N> operator-(const Dual<N>& a) { return a * -1.0; }
+
+// === СРАВНЕНИЯ (по значению) ===
+
+template <int N> bool operator<(const Dual<N>& a, const Dual<N>& b) { return a.value < b.value; }
+template <int N> bool operator>(const Dual<N>& a, const Dual<N>& b) { return a.value > b.value; }
+template <int N> bool operator<=(const Dual<N>& a, const Dual<N>& b) { return a.value <= b.value; }
+template <int N> bool operator>=(const Dual<N>& a, const Dual<N>& b) { return a.value >= b.value; }
+template <int N> bool operator<(const Dual<N>& a, double b) { return a.value < b; }
+template <int N> bool operator>(const Dual<N>& a, double b) { return a.value > b; }
+template <int N> bool operator<=(const Dual<N>& a, double b) { return a.value <= b; }
+template <int N> bool operator>=(const Dual<N>& a, double b) { return a.value >= b; }
+template <int N> bool operator<(double a, const Dual<N>& b) { return a < b.value; }
+template <int N> bool operator>(double a, const Dual<N>& b) { return a > b.value; }
+template <int N> bool operator<=(double a, const Dual<N>& b) { return a <= b.value; }
+template <int N> bool operator>=(double a, const Dual<N>& b) { return a >= b.value; }
+
+// === ФУНКЦИИ (находятся по ADL вместе с std:: для double) ===
+
+template <int N>
+Dual<N> sqrt(const Dual<N>& a) {
+    Dual<N> r(std::sqrt(a.value));
+    double k = 0.5 / r.value;
+    for (int i = 0; i < N; i++) r.grad[i] = a.grad[i] * k;
+    return r;
+}
+
+template <int N>
+Dual<N> abs(const Dual<N>& a) {
+    return a.value < 0 ? -a : a;
+}
+
+template <int N> Dual<N> min(const Dual<N>& a, const Dual<N>& b) { return b < a ? b : a; }
+template <int N> Dual<N> max(const Dual<N>& a, const Dual<N>& b) { return a < b ? b : a; }
+
+// Значение скаляра без производных (для double - он сам)
+inline double scalarValue(double x) { return x; }
+template <int N> double scalarValue(const Dual<N>& x) { return x.value; }
+
+namespace f1core {
+    // Поле float состояния на дуальных числах: значение округляется, как при
+    // записи в float, производные - без изменений
+    template <int N>
+    void storeNarrow(Dual<N>& field, const Dual<N>& value) {
+        field = value;
+        field.value = static_cast<float>(value.value);
+    }
+}
+
+#endif // F1_DUAL_H
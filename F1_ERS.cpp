@@ -0,0 +1,46 @@
+#include "F1_ERS.h"
+#include <algorithm>
+#include <numeric>
+
+ErsDeploymentMap::ErsDeploymentMap(double track_length, int bin_count)
+    : track_length(track_length),
+      inv_bin_length(bin_count / track_length),
+      last_bin(bin_count - 1),
+      deploy(bin_count, 0.0) {
+}
+
+void ErsDeploymentMap::setBin(int bin, double deploy_fraction) {
+    deploy[bin] = std::clamp(deploy_fraction, 0.0, 1.0);
+}
+
+bool ErsDeploymentMap::buildFromSpeedProfile(const std::vector<double>& reference_speed, const ErsParameters& ers) {
+    if (reference_speed.size() != deploy.size()) {
+        return false;
+    }
+    std::fill(deploy.begin(), deploy.end(), 0.0);
+    
+    // Участки по возрастанию скорости
+    std::vector<int> order(deploy.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return reference_speed[a] < reference_speed[b];
+    });
+    
+    double bin_length = binLength();
+    double budget = ers.deploy_limit_per_lap;
+    
+    for (int bin : order) {
+        if (budget <= 0) {
+            break;
+        }
+        
+        // Энергия из батареи на участке при полной мощности: P·t / КПД
+        double speed = std::max(reference_speed[bin], 1.0);
+        double bin_energy = ers.mguk_max_power * (bin_length / speed) / ers.deploy_efficiency;
+        
+        double fraction = std::min(1.0, budget / bin_energy);
+        deploy[bin] = fraction;
+        budget -= fraction * bin_energy;
+    }
+    return true;
+}
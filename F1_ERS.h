@@ -0,0 +1,47 @@
+#ifndef F1_ERS_H
+#define F1_ERS_H
+
+#include <vector>
+
+// Параметры системы рекуперации энергии (MGU-K + батарея)
+struct ErsParameters {
+    double mguk_max_power = 120000.0;      // Макс. мощность MGU-K [Вт]
+    double mguk_max_torque = 200.0;        // Макс. момент MGU-K на коленвале [Н·м]
+    double battery_capacity = 4.0e6;       // Полезная емкость батареи [Дж]
+    double battery_initial_energy = 2.0e6; // Заряд на старте [Дж]
+    double deploy_limit_per_lap = 4.0e6;   // Лимит отдачи энергии за круг [Дж]
+    double harvest_limit_per_lap = 2.0e6;  // Лимит рекуперации за круг [Дж]
+    double deploy_efficiency = 0.95;       // КПД батарея -> колеса
+    double harvest_efficiency = 0.8;       // КПД колеса -> батарея
+};
+
+// Карта отдачи энергии по дистанции круга.
+// Считается заранее для трассы, в цикле физики - один поиск по таблице за шаг.
+class ErsDeploymentMap {
+public:
+    ErsDeploymentMap(double track_length, int bin_count);
+    
+    // Доля мощности MGU-K [0..1] для участка
+    void setBin(int bin, double deploy_fraction);
+    
+    // Раскладка лимита отдачи по эталонному профилю скорости (по одной скорости на участок):
+    // энергия отдается на самых медленных участках, где она дает больше всего времени.
+    // false - скоростей не binCount(), карта не меняется
+    bool buildFromSpeedProfile(const std::vector<double>& reference_speed, const ErsParameters& ers);
+    
+    double deployFraction(double lap_distance) const {
+        int bin = static_cast<int>(lap_distance * inv_bin_length);
+        return deploy[bin < last_bin ? bin : last_bin];
+    }
+    
+    int binCount() const { return static_cast<int>(deploy.size()); }
+    double binLength() const { return track_length / deploy.size(); }
+
+private:
+    double track_length;
+    double inv_bin_length;
+    int last_bin;
+    std::vector<double> deploy;
+};
+
+#endif // F1_ERS_H
@@ -0,0 +1,62 @@
+#include "F1_Fleet.h"
+#include <cmath>
+
+// Оба варианта точности собираются здесь один раз. Этот файл собирать с
+// -O3 -fno-trapping-math (и -march под целевую машину): без -fno-trapping-math
+// GCC не выносит деления из условных веток и цикл шага не векторизуется.
+// Результаты флаг не меняет - он только разрешает считать обе ветки.
+template class F1Fleet<float>;
+template class F1Fleet<double>;
+
+FleetDriftReport runFleetDriftReport(std::size_t car_count, double duration, double dt, double tolerance,
+                                     const F1PhysicsEngine::CarParameters& params) {
+    F1Fleet<double> reference(car_count, params);
+    F1Fleet<float> fleet(car_count, params);
+    std::vector<std::uint8_t> gas, brake;
+    
+    FleetDriftReport report;
+    report.car_count = car_count;
+    report.duration = duration;
+    report.tolerance = tolerance;
+    
+    bool within_tolerance = true;
+    long steps = static_cast<long>(duration / dt);
+    for (long step = 0; step < steps; step++) {
+        stepFleetScenario(reference, step, dt, gas, brake);
+        stepFleetScenario(fleet, step, dt, gas, brake);
+        
+        double step_position_error = 0.0;
+        for (std::size_t i = 0; i < car_count; i++) {
+            double position_error = std::abs(fleet.getPosition(i) - reference.getPosition(i));
+            step_position_error = std::max(step_position_error, position_error);
+            report.max_velocity_error = std::max(report.max_velocity_error,
+                                                 std::abs(fleet.getVelocity(i) - reference.getVelocity(i)));
+            report.max_battery_error = std::max(report.max_battery_error,
+                                                std::abs(fleet.getBatteryEnergy(i) - reference.getBatteryEnergy(i)));
+            report.max_fuel_error = std::max(report.max_fuel_error,
+                                             std::abs(fleet.getFuelMass(i) - reference.getFuelMass(i)));
+            if (fleet.getLap(i) == reference.getLap(i) && reference.getLap(i) > 0) {
+                report.max_lap_time_error = std::max(report.max_lap_time_error,
+                                                     std::abs(fleet.getLastLapTime(i) - reference.getLastLapTime(i)));
+            }
+        }
+        
+        report.max_position_error = std::max(report.max_position_error, step_position_error);
+        if (within_tolerance && step_position_error > tolerance) {
+            within_tolerance = false;
+        }
+        if (within_tolerance) {
+            report.safe_horizon = reference.getTime();
+        }
+        if (step == steps - 1) {
+            report.final_position_error = step_position_error;
+        }
+    }
+    
+    for (std::size_t i = 0; i < car_count; i++) {
+        if (fleet.getLap(i) != reference.getLap(i)) {
+            report.lap_count_mismatches++;
+        }
+    }
+    return report;
+}
@@ -0,0 +1,556 @@
+#ifndef F1_FLEET_H
+#define F1_FLEET_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "F1_Physics_build_2.h"
+#include "F1_PhysicsCore.h"
+
+// Парк одинаковых машин для массовых прогонов.
+// Scalar задает точность состояния: float вдвое шире по SIMD и вдвое легче
+// по памяти, double - эталон.
+//
+// Машины лежат блоками по LANES (массивы полей внутри блока): у полей блока
+// разные смещения, поэтому компилятор векторизует шаг без проверок алиасинга.
+// Ветвлений в шаге нет - обе ветки считаются и выбираются по маске.
+//
+// Позиция и дистанция круга копятся в double при любом Scalar: ULP float
+// на 300 км - 3 см, и приращение v·dt за шаг терялось бы целиком.
+// Скорость копится с компенсацией Кэхэна: без нее округление почти
+// одинакового приращения за шаг смещает float-скорость в одну сторону.
+//
+// Физика - формулы f1core::step (шаг F1PhysicsEngine::update), переписанные
+// на маски по блоку: общий шаг ветвится по машине и не векторизуется. От него
+// парк отличается порядком операций (обратные величины вместо делений) - это
+// расхождение держит в допуске f1_conformance. Аэродинамики соседей нет.
+// Медленные величины обновляются для всего парка сразу (шаг общий), там же -
+// температуры тормозов и шин (params.thermal), если они включены.
+template <typename Scalar>
+class F1Fleet {
+public:
+    using CarParameters = F1PhysicsEngine::CarParameters;
+    
+    static constexpr std::size_t LANES = 16;
+    
+    explicit F1Fleet(std::size_t car_count, const CarParameters& car_params = CarParameters());
+    
+    void reset();
+    
+    // Шаг всего парка: gas/brake - по байту на машину (0 или 1)
+    void update(double dt, const std::uint8_t* gas, const std::uint8_t* brake);
+    
+    // То же с аналоговыми педалями 0..1 (как у F1PhysicsEngine::update)
+    void update(double dt, const float* throttle, const float* brake);
+    
+    void shiftUp(std::size_t car);
+    void shiftDown(std::size_t car);
+    
+    // Карта отдачи ERS, общая для парка (должна жить дольше парка)
+    void setDeploymentMap(const ErsDeploymentMap* map);
+    
+    // === ГЕТТЕРЫ ===
+    std::size_t size() const { return car_count; }
+    double getTime() const { return time; }
+    const CarParameters& getParameters() const { return params; }
+    
+    double getPosition(std::size_t car) const { return block(car).position[car % LANES]; }
+    double getLapDistance(std::size_t car) const { return block(car).lap_distance[car % LANES]; }
+    double getVelocity(std::size_t car) const { return block(car).velocity[car % LANES]; }
+    double getEngineRPM(std::size_t car) const { return block(car).engine_rpm[car % LANES]; }
+    double getBatteryEnergy(std::size_t car) const { return block(car).battery_energy[car % LANES]; }
+    bool isClutchLocked(std::size_t car) const { return block(car).clutch_locked[car % LANES] != 0; }
+    double getFuelMass(std::size_t car) const { return fuel_mass[car]; }
+    double getLastLapTime(std::size_t car) const { return last_lap_time[car]; }
+    const ThermalState& getThermalState(std::size_t car) const { return thermal[car]; }
+    int getLap(std::size_t car) const { return lap[car]; }
+    int getGear(std::size_t car) const { return current_gear[car]; }
+
+private:
+    // Горячие данные LANES машин. Флаги (0 или 1) и педали (0..1) - тоже Scalar,
+    // чтобы все поля шага имели одну ширину
+    struct Block {
+        double position[LANES];
+        double lap_distance[LANES];
+        Scalar velocity[LANES];
+        Scalar velocity_carry[LANES];       // Потерянные младшие разряды скорости (Кэхэн)
+        Scalar engine_rpm[LANES];
+        Scalar down_force[LANES];
+        Scalar brake_factor[LANES];
+        Scalar battery_energy[LANES];
+        Scalar lap_deployed_energy[LANES];
+        Scalar lap_harvested_energy[LANES];
+        Scalar mass[LANES];
+        Scalar tire_grip[LANES];
+        Scalar pending_engine_work[LANES];
+        Scalar pending_tire_work[LANES];
+        Scalar pending_brake_work[LANES];   // Работа тормозов (для их температуры)
+        Scalar pending_distance[LANES];     // Путь с медленного шага (охлаждение)
+        Scalar brake_force_limit[LANES];    // max_brake_force · эффективность тормозов
+        Scalar gear_factor[LANES];          // Кэш текущей передачи: i_передачи · i_главной
+        Scalar inertia_mass[LANES];         // и I·(i/r)²
+        Scalar deploy_fraction[LANES];      // Доля отдачи ERS на текущем участке
+        Scalar throttle[LANES];
+        Scalar brake[LANES];
+        Scalar clutch_locked[LANES];
+        Scalar rev_limiter_active[LANES];
+        Scalar out_of_fuel[LANES];
+    };
+    
+    Block& block(std::size_t car) { return blocks[car / LANES]; }
+    const Block& block(std::size_t car) const { return blocks[car / LANES]; }
+    
+    void step(double dt);
+    void stepBlock(Block& b, double dt) const;
+    void updateGearCache(std::size_t car);
+    void updateSlowState();
+    
+    CarParameters params;
+    const ErsDeploymentMap* deployment_map = nullptr;
+    std::size_t car_count;
+    
+    // === КОНСТАНТЫ В ТОЧНОСТИ ПАРКА ===
+    std::array<Scalar, 8> gear_factor{};          // i_передачи · i_главной
+    std::array<Scalar, 8> inertia_mass{};         // I·(i/r)²
+    Scalar speed_to_wheel_rpm;
+    Scalar inv_wheel_radius;
+    Scalar friction_per_rpm;
+    Scalar inv_launch_range;
+    Scalar torque_to_rpm_rate;
+    Scalar drag_constant;
+    Scalar downforce_constant;
+    
+    // === СОСТОЯНИЕ ===
+    double time = 0.0;
+    double slow_timer = 0.0;
+    std::vector<Block> blocks;
+    
+    // Холодные данные (по машине): меняются при переключении, на круге или на медленном шаге
+    std::vector<std::int32_t> lap;
+    std::vector<std::int32_t> current_gear;
+    std::vector<double> fuel_mass;
+    std::vector<double> tire_wear;
+    std::vector<double> lap_start_time;
+    std::vector<double> last_lap_time;
+    std::vector<ThermalState> thermal;
+};
+
+// === РЕАЛИЗАЦИЯ ===
+
+template <typename Scalar>
+F1Fleet<Scalar>::F1Fleet(std::size_t car_count, const CarParameters& car_params)
+    : params(car_params), car_count(car_count) {
+    for (int g = 0; g < params.gear_count; g++) {
+        double factor = params.gear_ratios[g] * params.final_drive;
+        double per_torque = factor / params.wheel_radius;
+        gear_factor[g] = static_cast<Scalar>(factor);
+        inertia_mass[g] = static_cast<Scalar>(params.engine_inertia * per_torque * per_torque);
+    }
+    speed_to_wheel_rpm = static_cast<Scalar>(f1core::RAD_S_TO_RPM / params.wheel_radius);
+    inv_wheel_radius = static_cast<Scalar>(1.0 / params.wheel_radius);
+    friction_per_rpm = static_cast<Scalar>(params.engine_friction_torque / params.max_rpm);
+    inv_launch_range = static_cast<Scalar>(1.0 / (params.launch_rpm - params.null_rpm));
+    torque_to_rpm_rate = static_cast<Scalar>(f1core::RAD_S_TO_RPM / params.engine_inertia);
+    drag_constant = static_cast<Scalar>(-0.5 * params.air_density * params.drag_coefficient * params.frontal_area);
+    downforce_constant = static_cast<Scalar>(0.5 * params.air_density * params.downforce_coefficient *
+                                             params.frontal_area);
+    
+    blocks.resize((car_count + LANES - 1) / LANES);
+    lap.resize(car_count);
+    current_gear.resize(car_count);
+    fuel_mass.resize(car_count);
+    tire_wear.resize(car_count);
+    lap_start_time.resize(car_count);
+    last_lap_time.resize(car_count);
+    thermal.resize(car_count);
+    reset();
+}
+
+template <typename Scalar>
+void F1Fleet<Scalar>::reset() {
+    time = 0.0;
+    
+    // Хвост последнего блока - пустые машины: педали не нажаты, стоят на месте
+    for (Block& b : blocks) {
+        b = Block();
+        for (std::size_t j = 0; j < LANES; j++) {
+            b.engine_rpm[j] = static_cast<Scalar>(params.null_rpm);
+            b.battery_energy[j] = static_cast<Scalar>(params.ers.battery_initial_energy);
+            b.mass[j] = static_cast<Scalar>(params.mass);
+            b.gear_factor[j] = gear_factor[0];
+            b.inertia_mass[j] = inertia_mass[0];
+            b.deploy_fraction[j] = Scalar(1);
+            b.brake_force_limit[j] = static_cast<Scalar>(params.max_brake_force);
+        }
+    }
+    
+    std::fill(lap.begin(), lap.end(), 0);
+    std::fill(current_gear.begin(), current_gear.end(), 1);
+    std::fill(fuel_mass.begin(), fuel_mass.end(), params.fuel_initial_mass);
+    std::fill(tire_wear.begin(), tire_wear.end(), 0.0);
+    std::fill(lap_start_time.begin(), lap_start_time.end(), 0.0);
+    std::fill(last_lap_time.begin(), last_lap_time.end(), 0.0);
+    for (ThermalState& t : thermal) {
+        resetThermal(t, params.thermal);
+    }
+    updateSlowState();
+}
+
+template <typename Scalar>
+void F1Fleet<Scalar>::setDeploymentMap(const ErsDeploymentMap* map) {
+    deployment_map = map;
+    if (!map) {
+        for (Block& b : blocks) {
+            std::fill(std::begin(b.deploy_fraction), std::end(b.deploy_fraction), Scalar(1));
+        }
+    }
+}
+
+template <typename Scalar>
+void F1Fleet<Scalar>::updateGearCache(std::size_t car) {
+    Block& b = block(car);
+    b.gear_factor[car % LANES] = gear_factor[current_gear[car] - 1];
+    b.inertia_mass[car % LANES] = inertia_mass[current_gear[car] - 1];
+}
+
+template <typename Scalar>
+void F1Fleet<Scalar>::shiftUp(std::size_t car) {
+    if (current_gear[car] < params.gear_count) {
+        current_gear[car]++;
+        updateGearCache(car);
+        Block& b = block(car);
+        std::size_t j = car % LANES;
+        if (b.clutch_locked[j] != 0) {
+            b.engine_rpm[j] = b.velocity[j] * speed_to_wheel_rpm * b.gear_factor[j];
+        }
+    }
+}
+
+template <typename Scalar>
+void F1Fleet<Scalar>::shiftDown(std::size_t car) {
+    if (current_gear[car] > 1) {
+        Block& b = block(car);
+        std::size_t j = car % LANES;
+        Scalar drivetrain_rpm = b.velocity[j] * speed_to_wheel_rpm * gear_factor[current_gear[car] - 2];
+        if (drivetrain_rpm <= static_cast<Scalar>(params.max_rpm)) {
+            current_gear[car]--;
+            updateGearCache(car);
+            if (b.clutch_locked[j] != 0) {
+                b.engine_rpm[j] = drivetrain_rpm;
+            }
+        }
+    }
+}
+
+template <typename Scalar>
+void F1Fleet<Scalar>::update(double dt, const std::uint8_t* gas, const std::uint8_t* brake) {
+    for (std::size_t car = 0; car < car_count; car++) {
+        Block& b = block(car);
+        b.throttle[car % LANES] = gas[car] ? Scalar(1) : Scalar(0);
+        b.brake[car % LANES] = brake[car] ? Scalar(1) : Scalar(0);
+    }
+    step(dt);
+}
+
+template <typename Scalar>
+void F1Fleet<Scalar>::update(double dt, const float* throttle, const float* brake) {
+    for (std::size_t car = 0; car < car_count; car++) {
+        Block& b = block(car);
+        b.throttle[car % LANES] = static_cast<Scalar>(std::clamp(throttle[car], 0.0f, 1.0f));
+        b.brake[car % LANES] = static_cast<Scalar>(std::clamp(brake[car], 0.0f, 1.0f));
+    }
+    step(dt);
+}
+
+template <typename Scalar>
+void F1Fleet<Scalar>::step(double dt) {
+    time += dt;
+    
+    // 1. Карта ERS - в блоки (поиск по карте в векторный цикл не ложится)
+    if (deployment_map) {
+        for (std::size_t car = 0; car < car_count; car++) {
+            Block& b = block(car);
+            std::size_t j = car % LANES;
+            b.deploy_fraction[j] = static_cast<Scalar>(deployment_map->deployFraction(b.lap_distance[j]));
+        }
+    }
+    
+    // 2. Физика - блок за блоком
+    for (Block& b : blocks) {
+        stepBlock(b, dt);
+    }
+    
+    // 3. Пересечение линии - редкое событие, считаем отдельно
+    for (std::size_t car = 0; car < car_count; car++) {
+        Block& b = block(car);
+        std::size_t j = car % LANES;
+        if (b.lap_distance[j] >= params.track_length) {
+            b.lap_distance[j] -= params.track_length;
+            b.lap_deployed_energy[j] = Scalar(0);
+            b.lap_harvested_energy[j] = Scalar(0);
+            lap[car]++;
+            last_lap_time[car] = time - lap_start_time[car];
+            lap_start_time[car] = time;
+        }
+    }
+    
+    // 4. Медленные величины - на грубом шаге
+    slow_timer += dt;
+    if (slow_timer >= params.slow_update_interval) {
+        updateSlowState();
+    }
+}
+
+template <typename Scalar>
+void F1Fleet<Scalar>::stepBlock(Block& b, double dt) const {
+    // Все константы - в локальные переменные: так компилятор знает,
+    // что записи в блок их не меняют
+    const Scalar h = static_cast<Scalar>(dt);
+    const Scalar null_rpm = static_cast<Scalar>(params.null_rpm);
+    const Scalar peak_rpm = static_cast<Scalar>(params.peak_rpm);
+    const Scalar max_rpm = static_cast<Scalar>(params.max_rpm);
+    const Scalar max_torque = static_cast<Scalar>(params.max_torque);
+    const Scalar limiter_release_rpm = static_cast<Scalar>(params.max_rpm - params.rev_limiter_hysteresis);
+    const Scalar clutch_max_torque = static_cast<Scalar>(params.clutch_max_torque);
+    const Scalar clutch_lock_rpm = static_cast<Scalar>(params.clutch_lock_rpm);
+    const Scalar brake_step = static_cast<Scalar>(params.brake_factor_coef * dt);
+    const Scalar gravity = Scalar(9.81);
+    const Scalar to_wheel_rpm = speed_to_wheel_rpm;
+    const Scalar inv_radius = inv_wheel_radius;
+    const Scalar friction = friction_per_rpm;
+    const Scalar launch = inv_launch_range;
+    const Scalar rpm_rate = torque_to_rpm_rate;
+    const Scalar drag_k = drag_constant;
+    const Scalar downforce_k = downforce_constant;
+    
+    const ErsParameters& ers = params.ers;
+    const Scalar mguk_max_torque = static_cast<Scalar>(ers.mguk_max_torque);
+    const Scalar mguk_max_power = static_cast<Scalar>(ers.mguk_max_power);
+    const Scalar battery_capacity = static_cast<Scalar>(ers.battery_capacity);
+    const Scalar deploy_limit = static_cast<Scalar>(ers.deploy_limit_per_lap);
+    const Scalar harvest_limit = static_cast<Scalar>(ers.harvest_limit_per_lap);
+    const Scalar inv_deploy_efficiency = static_cast<Scalar>(1.0 / ers.deploy_efficiency);
+    const Scalar harvest_efficiency = static_cast<Scalar>(ers.harvest_efficiency);
+    const Scalar rpm_to_omega = static_cast<Scalar>(1.0 / f1core::RAD_S_TO_RPM);
+    
+    // Тело цикла без ветвлений: каждая величина считается всегда, а условия
+    // накладываются цепочкой выборов по одному сравнению (x = cond ? a : x).
+    // Составные bool-условия (&&, ||, &) GCC в этом цикле не векторизует.
+    for (std::size_t j = 0; j < LANES; j++) {
+        const Scalar throttle = b.throttle[j];
+        const Scalar brake_pedal = b.brake[j];
+        const bool gas = throttle > 0;
+        const bool brake = brake_pedal > 0;
+        const Scalar gf = b.gear_factor[j];
+        const Scalar v0 = b.velocity[j];
+        const Scalar rpm0 = b.engine_rpm[j];
+        const Scalar brake_factor = b.brake_factor[j];
+        const Scalar battery = b.battery_energy[j];
+        const Scalar mass = b.mass[j];
+        
+        // 1. Момент ДВС
+        Scalar engine_torque = throttle * f1core::torqueCurve(rpm0, peak_rpm, max_rpm, max_torque);
+        engine_torque = gas ? engine_torque : Scalar(0);
+        engine_torque = b.rev_limiter_active[j] != 0 ? Scalar(0) : engine_torque;
+        engine_torque = b.out_of_fuel[j] != 0 ? Scalar(0) : engine_torque;
+        engine_torque = rpm0 < null_rpm ? Scalar(0) : engine_torque;
+        
+        // 2. Сцепление: считаем и проскальзывание, и жесткую связь, затем выбираем
+        Scalar drivetrain_rpm = v0 * to_wheel_rpm * gf;
+        Scalar net_torque = engine_torque - friction * rpm0;
+        bool drivetrain_running = drivetrain_rpm >= null_rpm;   // Выше холостых сцепление включено полностью
+        
+        Scalar launch_engagement = std::clamp((rpm0 - null_rpm) * launch, Scalar(0), Scalar(1));
+        Scalar engagement = gas ? launch_engagement : Scalar(0);
+        engagement = drivetrain_running ? Scalar(1) : engagement;
+        Scalar slip_rpm = rpm0 - drivetrain_rpm;
+        Scalar engaged_torque = engagement * clutch_max_torque;
+        Scalar slip_torque = slip_rpm < 0 ? -engaged_torque : engaged_torque;
+        Scalar free_rpm = std::max(rpm0 + (net_torque - slip_torque) * rpm_rate * h, null_rpm);
+        Scalar new_slip_rpm = free_rpm - drivetrain_rpm;
+        
+        // Замыкание: обороты сравнялись или проскочили синхронные (только выше холостых)
+        Scalar lock = b.clutch_locked[j];
+        lock = std::abs(new_slip_rpm) < clutch_lock_rpm ? Scalar(1) : lock;
+        lock = slip_rpm >= 0 ? (new_slip_rpm < 0 ? Scalar(1) : lock) : (new_slip_rpm >= 0 ? Scalar(1) : lock);
+        lock = drivetrain_running ? lock : Scalar(0);
+        
+        Scalar rpm = lock != 0 ? drivetrain_rpm : free_rpm;
+        Scalar clutch_torque = lock != 0 ? net_torque : slip_torque;
+        
+        Scalar limiter = b.rev_limiter_active[j];
+        limiter = rpm < limiter_release_rpm ? Scalar(0) : limiter;
+        limiter = rpm >= max_rpm ? Scalar(1) : limiter;
+        
+        b.pending_engine_work[j] += engine_torque * rpm * h;
+        
+        // 3. Тормоз и ERS (отдача на газу, рекуперация части тормозной силы).
+        // MGU-K работает только при замкнутом сцеплении
+        Scalar pedal_brake_force = -brake_factor * b.brake_force_limit[j];
+        Scalar brake_force = brake ? pedal_brake_force : Scalar(0);
+        Scalar omega = rpm * rpm_to_omega;
+        Scalar power_torque = mguk_max_power / omega;
+        
+        Scalar available = std::min(battery, deploy_limit - b.lap_deployed_energy[j]);
+        Scalar deploy_fraction = b.deploy_fraction[j] * throttle;
+        Scalar deploy_torque = std::min(mguk_max_torque, deploy_fraction * power_torque);
+        Scalar deploy_energy = deploy_torque * omega * h * inv_deploy_efficiency;
+        Scalar deploy_limited = deploy_torque * (available / deploy_energy);
+        deploy_torque = deploy_energy > available ? deploy_limited : deploy_torque;
+        Scalar deployed = std::min(deploy_energy, available);
+        deployed = gas ? deployed : Scalar(0);
+        deployed = deploy_fraction > 0 ? deployed : Scalar(0);
+        deployed = available > 0 ? deployed : Scalar(0);
+        deployed = lock != 0 ? deployed : Scalar(0);
+        deployed = rpm > 0 ? deployed : Scalar(0);
+        deployed = limiter != 0 ? Scalar(0) : deployed;
+        
+        Scalar room = std::min(battery_capacity - battery, harvest_limit - b.lap_harvested_energy[j]);
+        Scalar torque_from_brakes = -brake_force / (gf * inv_radius);
+        Scalar harvest_torque = std::min(std::min(mguk_max_torque, power_torque), torque_from_brakes);
+        Scalar harvest_energy = harvest_torque * omega * h * harvest_efficiency;
+        Scalar harvest_limited = harvest_torque * (room / harvest_energy);
+        harvest_torque = harvest_energy > room ? harvest_limited : harvest_torque;
+        Scalar harvest_force = harvest_torque * gf * inv_radius;
+        Scalar harvested = std::min(harvest_energy, room);
+        harvested = gas ? Scalar(0) : harvested;
+        harvested = brake_force < 0 ? harvested : Scalar(0);
+        harvested = room > 0 ? harvested : Scalar(0);
+        harvested = lock != 0 ? harvested : Scalar(0);
+        harvested = rpm > 0 ? harvested : Scalar(0);
+        
+        // Ненулевая энергия <=> режим включен (момент и omega при этом > 0)
+        Scalar ers_torque = harvested > 0 ? -harvest_torque : Scalar(0);
+        ers_torque = deployed > 0 ? deploy_torque : ers_torque;
+        b.battery_energy[j] = battery - deployed + harvested;
+        b.lap_deployed_energy[j] += deployed;
+        b.lap_harvested_energy[j] += harvested;
+        brake_force += harvested > 0 ? harvest_force : Scalar(0);
+        
+        // 4. Силы
+        Scalar wheel_torque = clutch_torque * gf + ers_torque * gf;
+        Scalar max_traction = b.tire_grip[j] * (mass * gravity - b.down_force[j]);
+        Scalar traction_force = std::clamp(wheel_torque * inv_radius, -max_traction, max_traction);
+        Scalar drag_force = f1core::aeroForce(drag_k, v0);
+        b.down_force[j] = f1core::aeroForce(downforce_k, v0);
+        
+        Scalar brake_rising = std::min(brake_factor + brake_step, brake_pedal);
+        Scalar brake_falling = std::max(brake_factor - brake_step, brake_pedal);
+        b.brake_factor[j] = brake_factor < brake_pedal ? brake_rising : brake_falling;
+        
+        // 5. Движение (скорость - с компенсацией, позиция - в double)
+        Scalar inertia_mass = b.inertia_mass[j];
+        Scalar effective_mass = mass + (lock != 0 ? inertia_mass : Scalar(0));
+        Scalar dv = (traction_force + drag_force + brake_force) / effective_mass * h - b.velocity_carry[j];
+        Scalar v = v0 + dv;
+        Scalar carry = (v - v0) - dv;
+        b.position[j] += static_cast<double>(v) * dt;
+        bool stopped = v < 0;
+        v = stopped ? Scalar(0) : v;
+        b.velocity_carry[j] = stopped ? Scalar(0) : carry;
+        b.pending_tire_work[j] += std::abs(traction_force + brake_force) * v * h;
+        b.pending_brake_work[j] -= brake_force * v * h;
+        b.pending_distance[j] += v * h;
+        b.lap_distance[j] += static_cast<double>(v) * dt;
+        
+        b.velocity[j] = v;
+        b.engine_rpm[j] = rpm;
+        b.clutch_locked[j] = lock;
+        b.rev_limiter_active[j] = limiter;
+    }
+}
+
+template <typename Scalar>
+void F1Fleet<Scalar>::updateSlowState() {
+    const double fuel_per_work = 1.0 / (f1core::RAD_S_TO_RPM * params.fuel_work_per_kg);
+    for (std::size_t car = 0; car < car_count; car++) {
+        Block& b = block(car);
+        std::size_t j = car % LANES;
+        
+        fuel_mass[car] = std::max(0.0, fuel_mass[car] - b.pending_engine_work[j] * fuel_per_work);
+        b.out_of_fuel[j] = fuel_mass[car] <= 0.0 ? Scalar(1) : Scalar(0);
+        b.mass[j] = static_cast<Scalar>(params.mass + fuel_mass[car]);
+        
+        tire_wear[car] = std::min(1.0, tire_wear[car] + b.pending_tire_work[j] * params.tire_wear_per_joule);
+        double grip = params.tire_friction * (1.0 - params.tire_grip_loss * tire_wear[car]);
+        double brake_force_limit = params.max_brake_force;
+        
+        if (params.thermal.enabled) {
+            ThermalState& t = thermal[car];
+            accumulateThermal(t, b.pending_brake_work[j], b.pending_tire_work[j], b.pending_distance[j],
+                              slow_timer);
+            updateThermal(t, params.thermal);
+            grip *= t.grip_factor;
+            brake_force_limit *= t.brake_efficiency;
+        }
+        b.tire_grip[j] = static_cast<Scalar>(grip);
+        b.brake_force_limit[j] = static_cast<Scalar>(brake_force_limit);
+        
+        b.pending_engine_work[j] = Scalar(0);
+        b.pending_tire_work[j] = Scalar(0);
+        b.pending_brake_work[j] = Scalar(0);
+        b.pending_distance[j] = Scalar(0);
+    }
+    slow_timer = 0.0;
+}
+
+// Оба варианта собираются один раз в F1_Fleet.cpp (см. флаги там)
+extern template class F1Fleet<float>;
+extern template class F1Fleet<double>;
+
+// === СЦЕНАРИЙ И ОТЧЕТ О ТОЧНОСТИ ===
+
+// Шаг типового сценария: у каждой машины свой цикл газ/тормоз, передачи по
+// оборотам. Вход зависит только от номера шага, поэтому float- и double-парк
+// получают одинаковые педали (передачи - по собственным оборотам).
+template <typename Scalar>
+void stepFleetScenario(F1Fleet<Scalar>& fleet, long step, double dt,
+                       std::vector<std::uint8_t>& gas, std::vector<std::uint8_t>& brake) {
+    const std::size_t count = fleet.size();
+    gas.resize(count);
+    brake.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        long period = static_cast<long>((12.0 + i % 8) / dt);
+        long braking = static_cast<long>((2.0 + 0.5 * (i % 3)) / dt);
+        bool braking_now = step % period >= period - braking;
+        gas[i] = !braking_now;
+        brake[i] = braking_now;
+    }
+    
+    fleet.update(dt, gas.data(), brake.data());
+    
+    for (std::size_t i = 0; i < count; i++) {
+        double rpm = fleet.getEngineRPM(i);
+        if (rpm > 13500.0) {
+            fleet.shiftUp(i);
+        } else if (brake[i] && fleet.isClutchLocked(i) && rpm < 8000.0 && fleet.getGear(i) > 1) {
+            fleet.shiftDown(i);
+        }
+    }
+}
+
+// Расхождение float-парка с double-эталоном на типовом сценарии
+struct FleetDriftReport {
+    std::size_t car_count = 0;
+    double duration = 0.0;              // Время прогона [с]
+    double tolerance = 0.0;             // Допуск по позиции [м]
+    double max_position_error = 0.0;    // Максимум |x_float - x_double| по машинам и времени [м]
+    double final_position_error = 0.0;  // Максимум по машинам в конце прогона [м]
+    double max_velocity_error = 0.0;    // [м/с]
+    double max_battery_error = 0.0;     // [Дж]
+    double max_fuel_error = 0.0;        // [кг]
+    double max_lap_time_error = 0.0;    // По кругам, завершенным обоими парками [с]
+    int lap_count_mismatches = 0;       // Машин, у которых к концу разошлось число кругов
+    double safe_horizon = 0.0;          // До этого времени все машины в допуске [с]
+    
+    bool safe() const { return max_position_error <= tolerance; }
+};
+
+FleetDriftReport runFleetDriftReport(std::size_t car_count, double duration, double dt = 0.01,
+                                     double tolerance = 0.01,
+                                     const F1PhysicsEngine::CarParameters& params = F1PhysicsEngine::CarParameters());
+
+#endif // F1_FLEET_H
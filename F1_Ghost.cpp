@@ -0,0 +1,99 @@
+#include "F1_Ghost.h"
+#include <algorithm>
+#include <cmath>
+#include "F1_TelemetryQuery.h"
+
+bool GhostLap::load(const TelemetryLog& log, int lap) {
+    samples.clear();
+    cursor = 0;
+    lap_number = -1;
+    
+    int lap_channel = log.channelIndex("lap");
+    int distance_channel = log.channelIndex("lap_distance");
+    int velocity_channel = log.channelIndex("velocity");
+    if (lap_channel < 0 || distance_channel < 0 || velocity_channel < 0 || log.trackLength() <= 0.0) {
+        return false;
+    }
+    
+    // Начало и время круга - из разбивки по кругам (пересечение линии
+    // интерполировано между отсчетами)
+    LapQuery query;
+    const LapReport* reference = nullptr;
+    std::vector<LapReport> reports = queryLaps(log, query);
+    for (const LapReport& report : reports) {
+        if (report.complete && (lap < 0 ? reference == nullptr || report.lap_time < reference->lap_time
+                                        : report.lap == lap)) {
+            reference = &report;
+        }
+    }
+    if (reference == nullptr) {
+        return false;
+    }
+    
+    // Отсчеты круга: только блоки, которые он накрывает
+    track_length = log.trackLength();
+    lap_time = reference->lap_time;
+    samples.push_back({0.0, 0.0, 0.0});
+    auto toLogTime = [](double seconds) { return static_cast<std::int64_t>(std::llround(seconds * 1e9)); };
+    std::size_t first = log.findBlock(toLogTime(reference->start_time));
+    std::size_t last = log.findBlock(toLogTime(reference->start_time + lap_time));
+    TelemetryColumns columns;
+    for (std::size_t b = first; b <= last; b++) {
+        if (!log.decodeBlock(b, columns)) {
+            samples.clear();
+            return false;
+        }
+        for (std::size_t i = 0; i < columns.size(); i++) {
+            double distance = columns.channels[distance_channel][i];
+            if (static_cast<int>(columns.channels[lap_channel][i]) != reference->lap
+                || distance < samples.back().distance || distance > track_length) {
+                continue;
+            }
+            samples.push_back({distance, columns.timestamps[i] / 1e9 - reference->start_time,
+                               columns.channels[velocity_channel][i]});
+        }
+    }
+    if (samples.size() < 2) {
+        samples.clear();
+        return false;
+    }
+    
+    // Края круга: на линии время 0 и lap_time, скорость - ближайшего отсчета
+    samples.front().velocity = samples[1].velocity;
+    samples.push_back({track_length, lap_time, samples.back().velocity});
+    lap_number = reference->lap;
+    return true;
+}
+
+bool GhostLap::load(const std::string& path, int lap) {
+    TelemetryLog log;
+    return log.open(path) && load(log, lap);
+}
+
+GhostDelta GhostLap::compare(double lap_distance, double lap_time, double velocity) {
+    GhostDelta result;
+    if (samples.size() < 2) {
+        return result;
+    }
+    double distance = std::min(std::max(lap_distance, 0.0), track_length);
+    
+    // Курсор: вперед по одному отсчету, назад - заново бинарным поиском
+    if (distance < samples[cursor].distance) {
+        auto it = std::upper_bound(samples.begin(), samples.end(), distance,
+                                   [](double d, const GhostSample& s) { return d < s.distance; });
+        cursor = it == samples.begin() ? 0 : static_cast<std::size_t>(it - samples.begin()) - 1;
+        cursor = std::min(cursor, samples.size() - 2);
+    }
+    while (cursor + 2 < samples.size() && samples[cursor + 1].distance <= distance) {
+        cursor++;
+    }
+    
+    const GhostSample& a = samples[cursor];
+    const GhostSample& b = samples[cursor + 1];
+    double fraction = b.distance > a.distance ? (distance - a.distance) / (b.distance - a.distance) : 0.0;
+    result.ghost_time = a.time + (b.time - a.time) * fraction;
+    result.ghost_velocity = a.velocity + (b.velocity - a.velocity) * fraction;
+    result.delta_time = lap_time - result.ghost_time;
+    result.velocity_delta = velocity - result.ghost_velocity;
+    return result;
+}
@@ -0,0 +1,57 @@
+#ifndef F1_GHOST_H
+#define F1_GHOST_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "F1_TelemetryLog.h"
+
+// Машина-призрак: опорный круг из лога телеметрии, индексированный по
+// дистанции круга. Для живой машины на каждом кадре - разница по времени с
+// опорным кругом в той же точке трассы и разница скоростей.
+//
+// Поиск точки - курсором, который идет только вперед вместе с машиной:
+// за круг он проходит опорные отсчеты один раз, O(1) на кадр в среднем.
+// Назад (новый круг, сброс) - бинарный поиск заново.
+
+// Опорный отсчет
+struct GhostSample {
+    double distance = 0.0;              // Дистанция круга [м]
+    double time = 0.0;                  // Время от линии старта [с]
+    double velocity = 0.0;              // [м/с]
+};
+
+// Сравнение с опорным кругом в точке живой машины
+struct GhostDelta {
+    double ghost_time = 0.0;            // Время опорного круга до этой точки [с]
+    double delta_time = 0.0;            // Живое время круга - опорное: > 0 - медленнее призрака
+    double ghost_velocity = 0.0;        // [м/с]
+    double velocity_delta = 0.0;        // Живая скорость - опорная [м/с]
+};
+
+class GhostLap {
+public:
+    // Круг lap из лога (-1 - самый быстрый полный). Нужны каналы lap,
+    // lap_distance, velocity. false - нет полного круга или нужных каналов
+    bool load(const TelemetryLog& log, int lap = -1);
+    bool load(const std::string& path, int lap = -1);
+    
+    bool loaded() const { return !samples.empty(); }
+    int lap() const { return lap_number; }
+    double lapTime() const { return lap_time; }
+    double trackLength() const { return track_length; }
+    std::size_t size() const { return samples.size(); }
+    
+    // Живая машина: дистанция круга, время с начала круга, скорость
+    GhostDelta compare(double lap_distance, double lap_time, double velocity);
+
+private:
+    // Отсчеты по возрастанию дистанции, от 0 до track_length
+    std::vector<GhostSample> samples;
+    std::size_t cursor = 0;             // samples[cursor].distance <= дистанция прошлого кадра
+    int lap_number = -1;
+    double lap_time = 0.0;
+    double track_length = 0.0;
+};
+
+#endif // F1_GHOST_H
@@ -0,0 +1,356 @@
+#include "F1_Input.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <poll.h>
+#include <unistd.h>
+
+// === ОЧЕРЕДЬ СОБЫТИЙ ===
+
+bool InputEventQueue::push(const InputEvent& event) {
+    std::size_t t = tail.load(std::memory_order_relaxed);
+    if (t - head.load(std::memory_order_acquire) == CAPACITY) {
+        return false;
+    }
+    events[t & (CAPACITY - 1)] = event;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+bool InputEventQueue::pop(InputEvent& event) {
+    std::size_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    event = events[h & (CAPACITY - 1)];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+// === ГИСТОГРАММА ЗАДЕРЖЕК ===
+
+void LatencyHistogram::record(std::int64_t latency_ns) {
+    latency_ns = std::max<std::int64_t>(latency_ns, 0);
+    
+    // Номер корзины - число значащих бит в микросекундах
+    std::uint64_t us = static_cast<std::uint64_t>(latency_ns) / 1000;
+    int bucket = 0;
+    while (us > 0 && bucket < BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    
+    if (latency_ns > max_ns.load(std::memory_order_relaxed)) {
+        max_ns.store(latency_ns, std::memory_order_relaxed);
+    }
+}
+
+std::uint64_t LatencyHistogram::count() const {
+    std::uint64_t total = 0;
+    for (const auto& b : buckets) {
+        total += b.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+double LatencyHistogram::percentileMs(double p) const {
+    std::uint64_t total = count();
+    if (total == 0) {
+        return 0.0;
+    }
+    
+    std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * total)));
+    std::uint64_t seen = 0;
+    for (int k = 0; k < BUCKETS; k++) {
+        seen += buckets[k].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            // Последняя корзина открыта сверху - ее граница это максимум
+            return k == BUCKETS - 1 ? maxNs() / 1e6 : static_cast<double>(1ULL << k) / 1000.0;
+        }
+    }
+    return maxNs() / 1e6;
+}
+
+void LatencyHistogram::print(std::ostream& out) const {
+    std::uint64_t total = count();
+    out << "Задержка нажатие -> физика: " << total << " нажатий";
+    if (total == 0) {
+        out << "\n";
+        return;
+    }
+    out << std::fixed << std::setprecision(3)
+        << ", P50 <= " << percentileMs(0.5) << " мс, P99 <= " << percentileMs(0.99)
+        << " мс, max " << maxNs() / 1e6 << " мс\n";
+    
+    std::uint64_t peak = 0;
+    for (const auto& b : buckets) {
+        peak = std::max(peak, b.load(std::memory_order_relaxed));
+    }
+    
+    const int bar_width = 40;
+    for (int k = 0; k < BUCKETS; k++) {
+        std::uint64_t n = buckets[k].load(std::memory_order_relaxed);
+        if (n == 0) {
+            continue;
+        }
+        double low_ms = k == 0 ? 0.0 : static_cast<double>(1ULL << (k - 1)) / 1000.0;
+        double high_ms = static_cast<double>(1ULL << k) / 1000.0;
+        out << "  " << std::setw(9) << low_ms << " - ";
+        if (k == BUCKETS - 1) {
+            out << std::setw(9) << "..." << " мс ";
+        } else {
+            out << std::setw(9) << high_ms << " мс ";
+        }
+        out << std::setw(8) << n << " " << std::string(n * bar_width / peak, '#') << "\n";
+    }
+}
+
+// === ПОТОК КЛАВИАТУРЫ ===
+
+KeyboardInput::KeyboardInput(InputEventQueue& queue, KeyboardInputConfig config)
+    : queue(queue), config(config) {}
+
+KeyboardInput::~KeyboardInput() {
+    stop();
+}
+
+std::int64_t KeyboardInput::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool KeyboardInput::start() {
+    if (thread.joinable()) {
+        return true;
+    }
+    if (pipe(wake_pipe) != 0) {
+        wake_pipe[0] = wake_pipe[1] = -1;
+        return false;
+    }
+    
+    // Сырой режим на все время работы: без построчной буферизации и эха.
+    // ISIG не трогаем - Ctrl+C продолжает работать.
+    if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &saved_termios) == 0) {
+        termios raw = saved_termios;
+        raw.c_lflag &= ~(ICANON | ECHO);
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+        termios_saved = true;
+    }
+    
+    held_count = 0;
+    thread = std::thread(&KeyboardInput::run, this);
+    return true;
+}
+
+void KeyboardInput::stop() {
+    if (thread.joinable()) {
+        char byte = 0;
+        while (write(wake_pipe[1], &byte, 1) < 0 && errno == EINTR) {}
+        thread.join();
+    }
+    if (termios_saved) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+        termios_saved = false;
+    }
+    for (int& fd : wake_pipe) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+void KeyboardInput::emit(int key, InputEvent::Type type, std::int64_t timestamp_ns) {
+    InputEvent event;
+    event.key = key;
+    event.type = type;
+    event.timestamp_ns = timestamp_ns;
+    if (!queue.push(event)) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void KeyboardInput::keyHit(int key, std::int64_t now_ns) {
+    for (int i = 0; i < held_count; i++) {
+        if (held[i].key == key) {
+            held[i].release_deadline_ns = now_ns + config.repeat_timeout_ms * 1000000LL;
+            emit(key, InputEvent::Repeat, now_ns);
+            return;
+        }
+    }
+    
+    // Таблица полна - отпускаем клавишу, которая отпустится раньше всех
+    if (held_count == MAX_HELD) {
+        int oldest = 0;
+        for (int i = 1; i < held_count; i++) {
+            if (held[i].release_deadline_ns < held[oldest].release_deadline_ns) {
+                oldest = i;
+            }
+        }
+        emit(held[oldest].key, InputEvent::Release, now_ns);
+        held[oldest] = held[--held_count];
+    }
+    
+    held[held_count].key = key;
+    held[held_count].release_deadline_ns = now_ns + config.first_repeat_timeout_ms * 1000000LL;
+    held_count++;
+    emit(key, InputEvent::Press, now_ns);
+}
+
+void KeyboardInput::releaseExpired(std::int64_t now_ns) {
+    for (int i = 0; i < held_count;) {
+        if (held[i].release_deadline_ns <= now_ns) {
+            emit(held[i].key, InputEvent::Release, now_ns);
+            held[i] = held[--held_count];
+        } else {
+            i++;
+        }
+    }
+}
+
+// Разбирает одну клавишу с начала буфера. Возвращает число байт или 0, если
+// ESC-последовательность еще не дочитана. key < 0 - последовательность без клавиши.
+std::size_t KeyboardInput::parseKey(const unsigned char* bytes, std::size_t length,
+                                    bool escape_expired, int& key) const {
+    key = -1;
+    if (bytes[0] != InputKey::Escape) {
+        key = bytes[0];
+        return 1;
+    }
+    
+    // Одиночный ESC отличаем от начала последовательности по таймауту
+    auto incomplete = [&]() -> std::size_t {
+        if (escape_expired) {
+            key = InputKey::Escape;
+            return 1;
+        }
+        return 0;
+    };
+    
+    if (length < 2) {
+        return incomplete();
+    }
+    
+    auto arrow = [](unsigned char final_byte) {
+        switch (final_byte) {
+            case 'A': return InputKey::Up;
+            case 'B': return InputKey::Down;
+            case 'C': return InputKey::Right;
+            case 'D': return InputKey::Left;
+            default: return -1;
+        }
+    };
+    
+    if (bytes[1] == '[') {
+        // CSI: параметры 0x30-0x3F (например, "1;5" для Ctrl+стрелки) и финальный байт
+        std::size_t i = 2;
+        while (i < length && bytes[i] >= 0x30 && bytes[i] <= 0x3F) {
+            i++;
+        }
+        if (i == length) {
+            return incomplete();
+        }
+        key = arrow(bytes[i]);
+        return i + 1;
+    }
+    
+    if (bytes[1] == 'O') {
+        // SS3: стрелки в режиме приложения
+        if (length < 3) {
+            return incomplete();
+        }
+        key = arrow(bytes[2]);
+        return 3;
+    }
+    
+    // ESC перед обычной клавишей (Alt+клавиша) - это ESC, клавиша разберется следующей
+    key = InputKey::Escape;
+    return 1;
+}
+
+void KeyboardInput::run() {
+    std::array<unsigned char, 64> pending;
+    std::size_t pending_length = 0;
+    std::int64_t escape_deadline_ns = 0;    // 0 - недочитанной последовательности нет
+    
+    while (true) {
+        // Спим до ближайшего события: байта, отпускания клавиши или таймаута ESC
+        std::int64_t now_ns = nowNs();
+        std::int64_t deadline_ns = std::numeric_limits<std::int64_t>::max();
+        for (int i = 0; i < held_count; i++) {
+            deadline_ns = std::min(deadline_ns, held[i].release_deadline_ns);
+        }
+        if (escape_deadline_ns != 0) {
+            deadline_ns = std::min(deadline_ns, escape_deadline_ns);
+        }
+        int timeout_ms = -1;
+        if (deadline_ns != std::numeric_limits<std::int64_t>::max()) {
+            timeout_ms = static_cast<int>(std::max<std::int64_t>(0, (deadline_ns - now_ns + 999999) / 1000000));
+        }
+        
+        pollfd fds[2] = {{STDIN_FILENO, POLLIN, 0}, {wake_pipe[0], POLLIN, 0}};
+        int ready = poll(fds, 2, timeout_ms);
+        now_ns = nowNs();
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents != 0) {
+            break;
+        }
+        
+        if (fds[0].revents & POLLIN) {
+            ssize_t n = read(STDIN_FILENO, pending.data() + pending_length, pending.size() - pending_length);
+            if (n == 0 || (n < 0 && errno != EINTR && errno != EAGAIN)) {
+                break;  // stdin закрыт
+            }
+            if (n > 0) {
+                pending_length += static_cast<std::size_t>(n);
+            }
+        } else if (fds[0].revents & (POLLHUP | POLLERR | POLLNVAL)) {
+            break;
+        }
+        
+        // Разбор прочитанного; переполненный буфер считаем истекшим ESC
+        bool escape_expired = (escape_deadline_ns != 0 && now_ns >= escape_deadline_ns)
+                           || pending_length == pending.size();
+        std::size_t consumed = 0;
+        while (consumed < pending_length) {
+            int key = -1;
+            std::size_t used = parseKey(pending.data() + consumed, pending_length - consumed, escape_expired, key);
+            if (used == 0) {
+                break;
+            }
+            if (key >= 0) {
+                keyHit(key, now_ns);
+            }
+            consumed += used;
+        }
+        std::memmove(pending.data(), pending.data() + consumed, pending_length - consumed);
+        pending_length -= consumed;
+        if (pending_length == 0) {
+            escape_deadline_ns = 0;
+        } else if (escape_deadline_ns == 0) {
+            escape_deadline_ns = now_ns + config.escape_timeout_ms * 1000000LL;
+        }
+        
+        // Повтор пришел раньше проверки таймаута - удерживаемая клавиша не мигает
+        releaseExpired(now_ns);
+    }
+    
+    // Поток остановлен - все клавиши отпущены
+    std::int64_t now_ns = nowNs();
+    for (int i = 0; i < held_count; i++) {
+        emit(held[i].key, InputEvent::Release, now_ns);
+    }
+    held_count = 0;
+}
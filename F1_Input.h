@@ -0,0 +1,121 @@
+#ifndef F1_INPUT_H
+#define F1_INPUT_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <thread>
+#include <termios.h>
+
+// Коды клавиш без собственного символа (ASCII-клавиши приходят своим кодом)
+namespace InputKey {
+    constexpr int Escape = 27;
+    constexpr int Up = 0x100;
+    constexpr int Down = 0x101;
+    constexpr int Right = 0x102;
+    constexpr int Left = 0x103;
+}
+
+struct InputEvent {
+    enum Type : std::uint8_t {
+        Press,                          // Клавиша нажата
+        Repeat,                         // Автоповтор удерживаемой клавиши
+        Release                         // Автоповтор прекратился - клавиша отпущена
+    };
+    
+    int key = 0;
+    Type type = Press;
+    std::int64_t timestamp_ns = 0;      // steady_clock: байт прочитан из терминала (для Release - истек таймаут)
+};
+
+// Кольцо один писатель - один читатель без блокировок: поток ввода кладет,
+// физический поток забирает в начале шага
+class InputEventQueue {
+public:
+    bool push(const InputEvent& event);  // false - очередь полна, событие потеряно
+    bool pop(InputEvent& event);
+
+private:
+    static constexpr std::size_t CAPACITY = 256;   // Степень двойки
+    
+    std::array<InputEvent, CAPACITY> events;
+    alignas(64) std::atomic<std::size_t> head{0};   // Двигает читатель
+    alignas(64) std::atomic<std::size_t> tail{0};   // Двигает писатель
+};
+
+// Гистограмма задержек по степеням двойки микросекунд.
+// Пишет один поток, читать можно из любого.
+class LatencyHistogram {
+public:
+    static constexpr int BUCKETS = 24;  // Корзина k: [2^(k-1), 2^k) мкс, последняя - все больше
+    
+    void record(std::int64_t latency_ns);
+    
+    std::uint64_t count() const;
+    std::int64_t maxNs() const { return max_ns.load(std::memory_order_relaxed); }
+    double percentileMs(double p) const;   // Верхняя граница корзины квантиля, p в [0, 1]
+    void print(std::ostream& out) const;
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKETS> buckets{};
+    std::atomic<std::int64_t> max_ns{0};
+};
+
+struct KeyboardInputConfig {
+    // Терминал не сообщает об отпускании клавиши: клавиша считается нажатой,
+    // пока идут автоповторы. До первого автоповтора ждем дольше.
+    int first_repeat_timeout_ms = 550;  // Типичная задержка автоповтора 250-500 мс
+    int repeat_timeout_ms = 120;        // Типичный период автоповтора 30-50 мс
+    int escape_timeout_ms = 25;         // Одиночный ESC против начала ESC-последовательности
+};
+
+// Поток чтения клавиатуры. Переводит терминал в сырой режим один раз, спит в
+// poll() на stdin и отдает события с временем чтения в очередь.
+// Терминал повторяет только последнюю нажатую клавишу: при двух зажатых
+// клавишах первая через repeat_timeout_ms считается отпущенной.
+class KeyboardInput {
+public:
+    explicit KeyboardInput(InputEventQueue& queue, KeyboardInputConfig config = KeyboardInputConfig());
+    ~KeyboardInput();
+    
+    KeyboardInput(const KeyboardInput&) = delete;
+    KeyboardInput& operator=(const KeyboardInput&) = delete;
+    
+    bool start();                       // false - не удалось создать канал пробуждения
+    void stop();                        // Будит поток, ждет его и возвращает режим терминала
+    
+    std::uint64_t droppedEvents() const { return dropped.load(std::memory_order_relaxed); }
+    
+    // Время для timestamp_ns
+    static std::int64_t nowNs();
+
+private:
+    static constexpr int MAX_HELD = 8;
+    
+    struct HeldKey {
+        int key = 0;
+        std::int64_t release_deadline_ns = 0;
+    };
+    
+    void run();
+    void emit(int key, InputEvent::Type type, std::int64_t timestamp_ns);
+    void keyHit(int key, std::int64_t now_ns);
+    void releaseExpired(std::int64_t now_ns);
+    std::size_t parseKey(const unsigned char* bytes, std::size_t length, bool escape_expired, int& key) const;
+    
+    InputEventQueue& queue;
+    KeyboardInputConfig config;
+    
+    std::thread thread;
+    int wake_pipe[2] = {-1, -1};
+    termios saved_termios{};
+    bool termios_saved = false;
+    
+    std::array<HeldKey, MAX_HELD> held{};
+    int held_count = 0;
+    std::atomic<std::uint64_t> dropped{0};
+};
+
+#endif // F1_INPUT_H
@@ -0,0 +1,216 @@
+#include "F1_MonteCarlo.h"
+#include "F1_Driver.h"
+#include "F1_ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// === ГЕНЕРАТОР ===
+
+double CounterRng::normal() {
+    double u1 = uniform();
+    double u2 = uniform();
+    if (u1 < 1e-300) {
+        u1 = 1e-300;
+    }
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+}
+
+// === НАКОПИТЕЛЬ РАСПРЕДЕЛЕНИЯ ===
+
+namespace {
+    StreamStatsConfig histogramConfig(double low, double high, int bins) {
+        StreamStatsConfig config;
+        config.histogram_low = low;
+        config.histogram_high = high;
+        config.histogram_bins = bins;
+        return config;
+    }
+}
+
+DistributionAccumulator::DistributionAccumulator(double low, double high, int bins)
+    : StreamingStats(histogramConfig(low, high, bins)) {
+}
+
+// === ОДНА ГОНКА ===
+
+namespace {
+    const double LAP_TIME_LOW = 50.0;
+    const double LAP_TIME_HIGH = 250.0;
+    
+    // Простой пилот: тормозит так, чтобы войти в поворот на предельной скорости,
+    // в остальное время - газ. Ошибки пилота - сдвиг точки торможения и
+    // недожатые педали: на каждый поворот свой уровень газа и тормоза
+    // 1 - |N(0, σ)|, так что разброс не усредняется по шагам.
+    struct SimpleDriver {
+        int corner = -1;
+        double braking_offset = 0.0;
+        double throttle_level = 1.0;
+        double brake_level = 1.0;
+        
+        void control(const Track& track, const F1PhysicsEngine& car, double speed_limit,
+                     const MonteCarloConfig& config, CounterRng& rng, double& throttle, double& brake) {
+            const F1PhysicsEngine::CarState& s = car.getState();
+            const F1PhysicsEngine::CarParameters& p = car.getParameters();
+            
+            int next = track.nextCorner(s.lap_distance);
+            if (next != corner) {
+                corner = next;
+                braking_offset = rng.normal() * config.braking_noise;
+                throttle_level = std::max(0.5, 1.0 - std::abs(rng.normal()) * config.pedal_noise);
+                brake_level = std::max(0.5, 1.0 - std::abs(rng.normal()) * config.pedal_noise);
+            }
+            
+            double corner_speed = track.cornerSpeed(corner, s.tire_grip);
+            double distance = track.distanceTo(corner, s.lap_distance) - braking_offset;
+            
+            // Допустимая скорость с учетом торможения до поворота: v² = v_c² + 2·a·d
+            // (замедление берем с запасом - тормозной фактор нарастает не сразу)
+            double decel = 0.5 * std::min(s.tire_grip * 9.81, p.max_brake_force / s.mass);
+            double target = std::sqrt(corner_speed * corner_speed + 2.0 * decel * std::max(0.0, distance));
+            target = std::min(target, speed_limit);
+            
+            throttle = s.velocity.x < target ? throttle_level : 0.0;
+            brake = s.velocity.x > target + 1.0 ? brake_level : 0.0;
+        }
+    };
+    
+    void shiftGears(F1PhysicsEngine& car) {
+        const F1PhysicsEngine::CarState& s = car.getState();
+        if (s.engine_rpm > 13500.0) {
+            car.shiftUp();
+        } else if (s.clutch_locked && s.engine_rpm < 8000.0 && s.current_gear > 1) {
+            car.shiftDown();
+        }
+    }
+}
+
+RaceOutcome simulateRace(const Track& track, const F1PhysicsEngine::CarParameters& car_params,
+                         const PitStrategy& strategy, const MonteCarloConfig& config,
+                         std::uint64_t sample, std::vector<double>& lap_times) {
+    // Один и тот же поток случайных чисел для всех стратегий этой выборки
+    CounterRng rng(config.seed, sample);
+    
+    F1PhysicsEngine::CarParameters params = car_params;
+    params.track_length = track.length;
+    
+    // Карта отдачи ERS - по трассе и машине без разброса: одна на все выборки.
+    // Строится за микросекунды, гонка считается миллисекунды
+    ErsDeploymentMap deployment_map = buildDeploymentMap(SpeedProfile::fromTrack(track, params), params);
+    params.tire_wear_per_joule *= std::max(0.2, 1.0 + config.tire_wear_sigma * rng.normal());
+    
+    F1PhysicsEngine car(params);
+    car.setDeploymentMap(&deployment_map);
+    car.setFuelLoad(strategy.start_fuel);
+    
+    SimpleDriver driver;
+    RaceOutcome outcome;
+    size_t next_pit = 0;
+    int safety_car_laps = 0;
+    int lap = 0;
+    double time_penalty = 0.0;
+    double max_time = config.laps * LAP_TIME_HIGH;
+    
+    while (lap < config.laps) {
+        double throttle, brake;
+        double speed_limit = safety_car_laps > 0 ? config.safety_car_speed
+                                                 : std::numeric_limits<double>::infinity();
+        driver.control(track, car, speed_limit, config, rng, throttle, brake);
+        car.update(config.dt, throttle, brake);
+        shiftGears(car);
+        
+        const F1PhysicsEngine::CarState& s = car.getState();
+        if (s.lap == lap) {
+            if (s.time > max_time || (s.out_of_fuel && s.velocity.x < 1.0)) {
+                return outcome;  // Сход
+            }
+            continue;
+        }
+        
+        // Пересекли линию
+        double lap_time = car.getSlowState().last_lap_time;
+        if (next_pit < strategy.pit_laps.size() && strategy.pit_laps[next_pit] == lap + 1) {
+            double loss = safety_car_laps > 0 ? config.pit_loss_safety_car : config.pit_loss;
+            lap_time += loss;
+            time_penalty += loss;
+            car.changeTires();
+            next_pit++;
+        }
+        lap_times.push_back(lap_time);
+        lap = s.lap;
+        
+        // Машина безопасности на следующий круг
+        if (safety_car_laps > 0) {
+            safety_car_laps--;
+        } else if (rng.uniform() < config.safety_car_probability) {
+            int span = config.safety_car_max_laps - config.safety_car_min_laps + 1;
+            safety_car_laps = config.safety_car_min_laps + static_cast<int>(rng.uniform() * span);
+        }
+    }
+    
+    outcome.finished = true;
+    outcome.race_time = car.getState().time + time_penalty;
+    return outcome;
+}
+
+// === МОНТЕ-КАРЛО ===
+
+std::vector<StrategyResult> emptyStrategyResults(const std::vector<PitStrategy>& strategies,
+                                                 const MonteCarloConfig& config) {
+    // Границы гистограммы времени гонки - по границам времени круга
+    double race_low = config.laps * LAP_TIME_LOW;
+    double race_high = config.laps * LAP_TIME_HIGH;
+    
+    std::vector<StrategyResult> empty;
+    for (const PitStrategy& strategy : strategies) {
+        StrategyResult result{strategy,
+                              DistributionAccumulator(race_low, race_high, 10000),
+                              DistributionAccumulator(LAP_TIME_LOW, LAP_TIME_HIGH, 2000)};
+        empty.push_back(result);
+    }
+    return empty;
+}
+
+std::vector<StrategyResult> runMonteCarlo(const Track& track,
+                                          const F1PhysicsEngine::CarParameters& car,
+                                          const std::vector<PitStrategy>& strategies,
+                                          const MonteCarloConfig& config) {
+    WorkStealingPool pool(config.threads);
+    std::vector<StrategyResult> empty = emptyStrategyResults(strategies, config);
+    
+    // Накопители на поток: память не растет с числом выборок
+    std::vector<std::vector<StrategyResult>> per_thread(pool.threadCount(), empty);
+    
+    std::vector<std::vector<double>> lap_buffers(pool.threadCount());
+    pool.parallelFor(config.samples, 4, [&](std::size_t begin, std::size_t end, int worker) {
+        std::vector<StrategyResult>& results = per_thread[worker];
+        std::vector<double>& lap_times = lap_buffers[worker];
+        for (std::size_t sample = begin; sample < end; sample++) {
+            for (size_t k = 0; k < strategies.size(); k++) {
+                lap_times.clear();
+                RaceOutcome outcome = simulateRace(track, car, strategies[k], config, sample, lap_times);
+                for (double lap_time : lap_times) {
+                    results[k].lap_time.add(lap_time);
+                }
+                if (outcome.finished) {
+                    results[k].race_time.add(outcome.race_time);
+                    results[k].finished++;
+                } else {
+                    results[k].dnf++;
+                }
+            }
+        }
+    });
+    
+    // Слияние по потокам
+    std::vector<StrategyResult> total = empty;
+    for (const auto& results : per_thread) {
+        for (size_t k = 0; k < total.size(); k++) {
+            total[k].race_time.merge(results[k].race_time);
+            total[k].lap_time.merge(results[k].lap_time);
+            total[k].finished += results[k].finished;
+            total[k].dnf += results[k].dnf;
+        }
+    }
+    return total;
+}
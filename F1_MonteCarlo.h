@@ -0,0 +1,109 @@
+#ifndef F1_MONTE_CARLO_H
+#define F1_MONTE_CARLO_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "F1_Physics_build_2.h"
+#include "F1_StreamStats.h"
+#include "F1_Track.h"
+
+// Генератор на счетчике: число = hash(ключ, номер). Ключ строится из seed и
+// номера выборки, поэтому случайность гонки не зависит от того, какой поток
+// и в каком порядке ее считает.
+class CounterRng {
+public:
+    CounterRng(std::uint64_t seed, std::uint64_t stream)
+        : key(mix(seed ^ mix(stream + 0x632BE59BD9B4E019ULL))) {}
+    
+    std::uint64_t next() { return mix(key + (++counter) * 0x9E3779B97F4A7C15ULL); }
+    
+    // Равномерное [0, 1)
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+    
+    // Нормальное N(0, 1), Бокс-Мюллер
+    double normal();
+
+private:
+    static std::uint64_t mix(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+    
+    std::uint64_t key;
+    std::uint64_t counter = 0;
+};
+
+// Распределение в постоянной памяти: потоковая статистика с гистограммой
+// [low, high) для квантилей. Сливается между потоками.
+class DistributionAccumulator : public StreamingStats {
+public:
+    DistributionAccumulator(double low = 0.0, double high = 1.0, int bins = 100);
+};
+
+// Стратегия пит-стопов: на каких кругах менять шины и сколько топлива залить на старте
+struct PitStrategy {
+    std::string name;
+    std::vector<int> pit_laps;          // Пит-стоп в конце этих кругов
+    double start_fuel = 110.0;          // [кг]
+};
+
+struct MonteCarloConfig {
+    std::uint64_t seed = 1;
+    int samples = 1000;                 // Случайных гонок на стратегию
+    int laps = 50;
+    double dt = 0.02;                   // Шаг физики [с]
+    int threads = 0;                    // 0 - все ядра
+    
+    // Машина безопасности
+    double safety_car_probability = 0.03; // Вероятность выезда на круге
+    int safety_car_min_laps = 3;
+    int safety_car_max_laps = 5;
+    double safety_car_speed = 50.0;     // [м/с]
+    
+    // Пит-лейн
+    double pit_loss = 22.0;             // Потеря времени на пит-стоп [с]
+    double pit_loss_safety_car = 12.0;  // То же под машиной безопасности [с]
+    
+    // Разброс
+    double tire_wear_sigma = 0.15;      // Относительный разброс скорости износа
+    double braking_noise = 8.0;         // Разброс точки торможения пилота [м]
+    double pedal_noise = 0.05;          // Разброс недожатия педалей (σ доли хода, на поворот)
+};
+
+// Результат одной стратегии по всем выборкам
+struct StrategyResult {
+    PitStrategy strategy;
+    DistributionAccumulator race_time;  // Время гонки [с]
+    DistributionAccumulator lap_time;   // Время круга [с]
+    long finished = 0;
+    long dnf = 0;                       // Кончилось топливо
+};
+
+// Исход одной случайной гонки
+struct RaceOutcome {
+    bool finished = false;              // false - сход (кончилось топливо или время)
+    double race_time = 0.0;             // С потерями на пит-стопах [с]
+};
+
+// Гонка выборки sample по стратегии: результат зависит только от аргументов,
+// а не от того, какой поток или процесс ее считает. Времена кругов (с потерей
+// на пит-стопе) дописываются в lap_times.
+RaceOutcome simulateRace(const Track& track, const F1PhysicsEngine::CarParameters& car,
+                         const PitStrategy& strategy, const MonteCarloConfig& config,
+                         std::uint64_t sample, std::vector<double>& lap_times);
+
+// Пустые накопители по стратегиям (границы гистограмм - по числу кругов)
+std::vector<StrategyResult> emptyStrategyResults(const std::vector<PitStrategy>& strategies,
+                                                 const MonteCarloConfig& config);
+
+// Прогоняет samples случайных гонок для каждой стратегии на всех ядрах.
+// Для одной выборки все стратегии видят одни и те же машины безопасности,
+// износ и ошибки пилота - сравнение стратегий меньше шумит.
+std::vector<StrategyResult> runMonteCarlo(const Track& track,
+                                          const F1PhysicsEngine::CarParameters& car,
+                                          const std::vector<PitStrategy>& strategies,
+                                          const MonteCarloConfig& config);
+
+#endif // F1_MONTE_CARLO_H
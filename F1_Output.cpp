@@ -1,37 +1,52 @@
+#include "F1_Plot.h"
 #include <iostream>
 #include <iomanip>
 #include <cmath>
 #include <unistd.h>
 #include <termios.h>
-#include <fcntl.h>
+#include <poll.h>
 #include <cstdlib>
 #include <vector>
 #include <algorithm>
 
-// Функция для проверки нажатия клавиши (неблокирующий ввод)
-int kbhit() {
-    struct termios oldt, newt;
-    int ch;
-    int oldf;
-
-    tcgetattr(STDIN_FILENO, &oldt);
-    newt = oldt;
-    newt.c_lflag &= ~(ICANON | ECHO);
-    tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-    oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
-    fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
-
-    ch = getchar();
+// Сырой режим терминала на время симуляции: переключается один раз,
+// а не на каждую проверку клавиши
+class RawTerminal {
+public:
+    RawTerminal() {
+        if (tcgetattr(STDIN_FILENO, &saved) == 0) {
+            termios raw = saved;
+            raw.c_lflag &= ~(ICANON | ECHO);
+            raw.c_cc[VMIN] = 1;
+            raw.c_cc[VTIME] = 0;
+            active = tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0;
+        }
+    }
+    
+    ~RawTerminal() { restore(); }
+    
+    void restore() {
+        if (active) {
+            tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+            active = false;
+        }
+    }
 
-    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-    fcntl(STDIN_FILENO, F_SETFL, oldf);
+private:
+    termios saved{};
+    bool active = false;
+};
 
-    if (ch != EOF) {
-        ungetc(ch, stdin);
-        return 1;
-    }
+// Функция для проверки нажатия клавиши (неблокирующий ввод): один poll() без ожидания
+int kbhit() {
+    pollfd fd = {STDIN_FILENO, POLLIN, 0};
+    return poll(&fd, 1, 0) > 0 && (fd.revents & POLLIN) ? 1 : 0;
+}
 
-    return 0;
+// Чтение одного байта мимо буфера stdio, иначе poll() не видит уже прочитанное в буфер
+char readKey() {
+    char ch = 0;
+    return read(STDIN_FILENO, &ch, 1) == 1 ? ch : 0;
 }
 
 class SimpleF1Car {
@@ -63,13 +78,13 @@ public:
     double total_force = 0.0;        // Суммарная сила [Н]
     double down_force = 0.0;         // Прижимная сила [Н]
     double brake_force = 0.0;        // Сила торможения [Н]
-
-    // История для графиков
-    std::vector<double> time_history;
-    std::vector<double> position_history;
-    std::vector<double> velocity_history;
-    std::vector<double> drag_history;
-
+    
+    // Ряды для графиков: память постоянная при любой длине заезда, шаг
+    // симуляции ничего не выделяет
+    PlotSeries position_history;
+    PlotSeries velocity_history;
+    PlotSeries drag_history;
+    
     // Основной метод обновления физики
     void update(double dt, double throttle, double brake, double simulation_time) {
         // 1. Расчет сил
@@ -86,10 +101,9 @@ public:
         updateParameters();
         
         // 5. Сохранение истории для графиков
-        time_history.push_back(simulation_time);
-        position_history.push_back(position);
-        velocity_history.push_back(velocity * 3.6); // в км/ч
-        drag_history.push_back(std::abs(drag_force));
+        position_history.add(simulation_time, position);
+        velocity_history.add(simulation_time, velocity * 3.6); // в км/ч
+        drag_history.add(simulation_time, std::abs(drag_force));
     }
     
     void calculateForces(double throttle, double brake) {
@@ -162,80 +176,14 @@ public:
     }
 };
 
-// Функция для построения ASCII графика
-void plotGraph(const std::vector<double>& x, const std::vector<double>& y, 
-               const std::string& title, const std::string& xlabel, const std::string& ylabel,
-               int width = 60, int height = 20) {
-    
-    if (x.empty() || y.empty()) return;
-    
-    // Находим min и max значения
-    double min_x = *std::min_element(x.begin(), x.end());
-    double max_x = *std::max_element(x.begin(), x.end());
-    double min_y = *std::min_element(y.begin(), y.end());
-    double max_y = *std::max_element(y.begin(), y.end());
-    
-    // Добавляем немного места сверху
-    max_y *= 1.1;
-    if (min_y > 0) min_y = 0;
-    
-    std::cout << "\n" << title << "\n";
-    std::cout << std::string(title.length(), '=') << "\n";
-    
-    // Создаем сетку
-    std::vector<std::vector<char>> grid(height, std::vector<char>(width, ' '));
-    
-    // Рисуем оси
-    int zero_y = (int)((0 - min_y) / (max_y - min_y) * (height - 1));
-    zero_y = std::min(height - 1, std::max(0, zero_y));
-    
-    for (int i = 0; i < width; i++) {
-        grid[zero_y][i] = '-'; // Ось X
-    }
-    for (int i = 0; i < height; i++) {
-        grid[i][0] = '|'; // Ось Y
-    }
-    grid[zero_y][0] = '+'; // Начало координат
-    
-    // Рисуем данные
-    for (size_t i = 0; i < x.size(); i++) {
-        int plot_x = (int)((x[i] - min_x) / (max_x - min_x) * (width - 1));
-        int plot_y = (int)((y[i] - min_y) / (max_y - min_y) * (height - 1));
-        
-        plot_x = std::min(width - 1, std::max(0, plot_x));
-        plot_y = std::min(height - 1, std::max(0, plot_y));
-        
-        // Инвертируем Y для правильного отображения (0 внизу)
-        plot_y = height - 1 - plot_y;
-        
-        grid[plot_y][plot_x] = '*';
-    }
-    
-    // Выводим сетку
-    for (int i = 0; i < height; i++) {
-        std::cout << " ";
-        for (int j = 0; j < width; j++) {
-            std::cout << grid[i][j];
-        }
-        std::cout << "\n";
-    }
-    
-    // Подписи осей
-    std::cout << " " << std::string(width, ' ') << "^\n";
-    std::cout << " " << std::string(width, ' ') << "| " << ylabel << " (max: " << std::fixed << std::setprecision(1) << max_y << ")\n";
-    std::cout << " +";
-    for (int i = 0; i < width - 1; i++) std::cout << "-";
-    std::cout << "> " << xlabel << " (0-" << (int)max_x << " сек)\n\n";
-}
-
 // Функция для очистки экрана
 void clearScreen() {
     std::cout << "\033[2J\033[H";
 }
 
 int main() {
-    SimpleF1Car car;
     double dt = 0.1; // шаг времени 100 мс
+    SimpleF1Car car;
     double simulation_time = 0.0;
     
     // Настройки управления
@@ -247,6 +195,8 @@ int main() {
     std::cout << "Нажмите любую клавишу для начала..." << std::endl;
     std::cin.get();
     
+    RawTerminal raw_terminal;
+    
     // Основной цикл симуляции (30 секунд)
     while (simulation_time <= 30.0) {
         // Очищаем экран и выводим обновленную таблицу
@@ -260,7 +210,7 @@ int main() {
         
         // Проверяем нажатие клавиши
         if (kbhit()) {
-            key = getchar();
+            key = readKey();
             
             switch (key) {
                 case '1': // Газ
@@ -293,20 +243,21 @@ int main() {
     }
     
     // После завершения симуляции рисуем графики
+    raw_terminal.restore();
     clearScreen();
     std::cout << "=== РЕЗУЛЬТАТЫ СИМУЛЯЦИИ (30 секунд) ===" << std::endl;
     std::cout << "========================================" << std::endl;
     
     // График позиции
-    plotGraph(car.time_history, car.position_history,
+    plotGraph(std::cout, car.position_history,
               "ПОЗИЦИЯ АВТОМОБИЛЯ", "Время (с)", "Позиция (м)");
     
     // График скорости
-    plotGraph(car.time_history, car.velocity_history,
+    plotGraph(std::cout, car.velocity_history,
               "СКОРОСТЬ АВТОМОБИЛЯ", "Время (с)", "Скорость (км/ч)");
     
     // График сопротивления воздуха
-    plotGraph(car.time_history, car.drag_history,
+    plotGraph(std::cout, car.drag_history,
               "СОПРОТИВЛЕНИЕ ВОЗДУХА", "Время (с)", "Сила (Н)");
     
     std::cout << "Нажмите любую клавишу для выхода...";
@@ -0,0 +1,66 @@
+#include "F1_PerfCounters.h"
+
+const char* perfStageName(int stage) {
+    switch (stage) {
+        case PERF_INPUT: return "input";
+        case PERF_PHYSICS: return "physics";
+        case PERF_TELEMETRY: return "telemetry";
+        case PERF_RENDER: return "render";
+    }
+    return "?";
+}
+
+// === СЧЕТЧИК СТАДИИ ===
+
+void StageCounter::record(std::int64_t ns) {
+    samples.fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(static_cast<std::uint64_t>(ns > 0 ? ns : 0), std::memory_order_relaxed);
+    
+    // Читатель обнуляет максимум обменом, поэтому сравнение с обменом, а не
+    // load/store: иначе обнуление между ними затерло бы больший замер
+    std::int64_t current = max_ns.load(std::memory_order_relaxed);
+    while (ns > current && !max_ns.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {
+    }
+}
+
+// === ОКНО ===
+
+bool PerfSampler::sample(SimulatorPerfCounters& counters, std::int64_t now_ns, PerfSnapshot& snapshot) {
+    Totals current;
+    current.time_ns = now_ns;
+    current.steps = counters.steps.load(std::memory_order_relaxed);
+    current.late_steps = counters.late_steps.load(std::memory_order_relaxed);
+    current.dropped_steps = counters.dropped_steps.load(std::memory_order_relaxed);
+    current.simulated_ns = counters.simulated_ns.load(std::memory_order_relaxed);
+    current.frames = counters.frames.load(std::memory_order_relaxed);
+    std::array<std::int64_t, PERF_STAGE_COUNT> max_ns{};
+    for (int s = 0; s < PERF_STAGE_COUNT; s++) {
+        current.stage_count[s] = counters.stages[s].count();
+        current.stage_ns[s] = counters.stages[s].totalNs();
+        max_ns[s] = counters.stages[s].takeMaxNs();
+    }
+    
+    bool ready = started && current.time_ns > previous.time_ns;
+    if (ready) {
+        double interval = (current.time_ns - previous.time_ns) / 1e9;
+        snapshot.interval = interval;
+        snapshot.steps_per_second = (current.steps - previous.steps) / interval;
+        snapshot.target_steps_per_second = target;
+        snapshot.real_time_factor = (current.simulated_ns - previous.simulated_ns) / 1e9 / interval;
+        snapshot.frames_per_second = (current.frames - previous.frames) / interval;
+        for (int s = 0; s < PERF_STAGE_COUNT; s++) {
+            std::uint64_t count = current.stage_count[s] - previous.stage_count[s];
+            // Сумма и число читаются не атомарно вместе - среднее может сдвинуться на замер
+            snapshot.average_us[s] = count > 0 ? (current.stage_ns[s] - previous.stage_ns[s]) / 1e3 / count : 0.0;
+            snapshot.max_us[s] = max_ns[s] / 1e3;
+        }
+        snapshot.late_steps = current.late_steps - previous.late_steps;
+        snapshot.dropped_steps = current.dropped_steps - previous.dropped_steps;
+        snapshot.total_late_steps = current.late_steps;
+        snapshot.total_dropped_steps = current.dropped_steps;
+    }
+    
+    previous = current;
+    started = true;
+    return ready;
+}
@@ -0,0 +1,95 @@
+#ifndef F1_PERF_COUNTERS_H
+#define F1_PERF_COUNTERS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Счетчики здоровья симулятора для панели производительности. Каждый
+// счетчик пишет один поток (физика или вывод) relaxed-атомиками без
+// блокировок, панель читает их из потока вывода: замер не ждет читателя и
+// не меняет расписание шагов. Счетчики накопительные; окно (скорости,
+// средние) считает PerfSampler по разности двух чтений.
+
+// Стадии, время которых меряется
+enum PerfStage {
+    PERF_INPUT,                         // События клавиатуры в начале шага
+    PERF_PHYSICS,                       // engine.update
+    PERF_TELEMETRY,                     // Публикация кадра на шину
+    PERF_RENDER,                        // Кадр панели (поток вывода)
+    PERF_STAGE_COUNT
+};
+
+const char* perfStageName(int stage);
+
+// Время стадии: сумма и число замеров, максимум с прошлого takeMaxNs().
+// Своя кэш-линия: стадии разных потоков не делят строку кэша
+class alignas(64) StageCounter {
+public:
+    void record(std::int64_t ns);
+    
+    std::uint64_t count() const { return samples.load(std::memory_order_relaxed); }
+    std::uint64_t totalNs() const { return total_ns.load(std::memory_order_relaxed); }
+    std::int64_t takeMaxNs() { return max_ns.exchange(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> samples{0};
+    std::atomic<std::uint64_t> total_ns{0};
+    std::atomic<std::int64_t> max_ns{0};
+};
+
+struct SimulatorPerfCounters {
+    std::array<StageCounter, PERF_STAGE_COUNT> stages{};
+    
+    // Пишет физический поток
+    alignas(64) std::atomic<std::uint64_t> steps{0};
+    std::atomic<std::uint64_t> late_steps{0};       // Шаг закончился позже своего срока
+    std::atomic<std::uint64_t> dropped_steps{0};    // Пропущено при сбросе расписания после долгой паузы
+    std::atomic<std::int64_t> simulated_ns{0};      // Сумма dt (reset машины не сбрасывает)
+    
+    // Пишет поток вывода
+    alignas(64) std::atomic<std::uint64_t> frames{0};
+};
+
+// Окно между двумя чтениями счетчиков
+struct PerfSnapshot {
+    double interval = 0.0;              // Длина окна [с]
+    double steps_per_second = 0.0;
+    double target_steps_per_second = 0.0;
+    double real_time_factor = 0.0;      // Симулированное время / реальное
+    double frames_per_second = 0.0;
+    std::array<double, PERF_STAGE_COUNT> average_us{};
+    std::array<double, PERF_STAGE_COUNT> max_us{};
+    std::uint64_t late_steps = 0;       // За окно
+    std::uint64_t dropped_steps = 0;
+    std::uint64_t total_late_steps = 0; // С начала
+    std::uint64_t total_dropped_steps = 0;
+};
+
+// Читатель: один на счетчики (забирает максимумы стадий)
+class PerfSampler {
+public:
+    explicit PerfSampler(double target_steps_per_second) : target(target_steps_per_second) {}
+    
+    // Окно с прошлого вызова; первый вызов только запоминает точку отсчета
+    // и возвращает false
+    bool sample(SimulatorPerfCounters& counters, std::int64_t now_ns, PerfSnapshot& snapshot);
+
+private:
+    struct Totals {
+        std::int64_t time_ns = 0;
+        std::uint64_t steps = 0;
+        std::uint64_t late_steps = 0;
+        std::uint64_t dropped_steps = 0;
+        std::int64_t simulated_ns = 0;
+        std::uint64_t frames = 0;
+        std::array<std::uint64_t, PERF_STAGE_COUNT> stage_count{};
+        std::array<std::uint64_t, PERF_STAGE_COUNT> stage_ns{};
+    };
+    
+    double target;
+    Totals previous;
+    bool started = false;
+};
+
+#endif // F1_PERF_COUNTERS_H
@@ -0,0 +1,488 @@
+#include "F1_PerfGate.h"
+#include "F1_Benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace {
+    const char* const REPORT_FORMAT = "f1-perf-1";
+    const char* const STAGE_PREFIX = "engine.stage.";
+    
+    // Двусторонний 95% квантиль t Стьюдента; дробные степени свободы (Уэлч) -
+    // интерполяция по таблице, выше 30 - по 1/df
+    double studentT95(double df) {
+        static const double small[30] = {
+            12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+            2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+            2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+        static const double large_df[] = {30.0, 40.0, 60.0, 120.0};
+        static const double large_t[] = {2.042, 2.021, 2.000, 1.980};
+        
+        if (!(df >= 1.0)) {
+            return small[0];
+        }
+        if (df <= 30.0) {
+            int lo = static_cast<int>(df);
+            double frac = df - lo;
+            return lo >= 30 ? small[29] : small[lo - 1] + (small[lo] - small[lo - 1]) * frac;
+        }
+        double inv = 1.0 / df;
+        for (int i = 0; i < 3; i++) {
+            if (df <= large_df[i + 1]) {
+                double a = 1.0 / large_df[i];
+                double b = 1.0 / large_df[i + 1];
+                return large_t[i] + (large_t[i + 1] - large_t[i]) * (a - inv) / (a - b);
+            }
+        }
+        double a = 1.0 / 120.0;
+        return large_t[3] + (1.960 - large_t[3]) * (a - inv) / a;
+    }
+    
+    void addResults(PerfReport& report, const std::vector<BenchmarkResult>& results) {
+        for (const BenchmarkResult& r : results) {
+            auto it = std::find_if(report.series.begin(), report.series.end(),
+                                   [&](const PerfSeries& s) { return s.name == r.name; });
+            if (it == report.series.end()) {
+                report.series.push_back(PerfSeries{r.name, {}});
+                it = report.series.end() - 1;
+            }
+            it->samples.push_back(r.ns_per_op);
+        }
+    }
+    
+    bool isStage(const std::string& name) {
+        return name.compare(0, std::strlen(STAGE_PREFIX), STAGE_PREFIX) == 0;
+    }
+    
+    std::string jsonEscape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out;
+    }
+    
+    // Разбор JSON отчета: нужные поля читаются, остальные значения пропускаются
+    class ReportParser {
+    public:
+        explicit ReportParser(const std::string& text) : p(text.c_str()), end(text.c_str() + text.size()) {}
+        
+        bool parse(PerfReport& report) {
+            report = PerfReport();
+            bool ok = parseObject([&](const std::string& key) {
+                double number = 0.0;
+                if (key == "runs" && parseNumber(number)) {
+                    report.runs = static_cast<int>(number);
+                    return true;
+                }
+                if (key == "steps" && parseNumber(number)) {
+                    report.steps = static_cast<long>(number);
+                    return true;
+                }
+                if (key == "benchmarks") {
+                    return parseArray([&]() {
+                        PerfSeries series;
+                        if (!parseSeries(series)) {
+                            return false;
+                        }
+                        report.series.push_back(series);
+                        return true;
+                    });
+                }
+                return skipValue();
+            });
+            skipSpace();
+            return ok && p == end;
+        }
+    
+    private:
+        void skipSpace() {
+            while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) {
+                p++;
+            }
+        }
+        
+        bool consume(char c) {
+            skipSpace();
+            if (p < end && *p == c) {
+                p++;
+                return true;
+            }
+            return false;
+        }
+        
+        // { "ключ": значение, ... }: member(ключ) читает значение
+        template <typename Member>
+        bool parseObject(Member member) {
+            if (!consume('{')) {
+                return false;
+            }
+            if (consume('}')) {
+                return true;
+            }
+            do {
+                std::string key;
+                if (!parseString(key) || !consume(':') || !member(key)) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume('}');
+        }
+        
+        template <typename Item>
+        bool parseArray(Item item) {
+            if (!consume('[')) {
+                return false;
+            }
+            if (consume(']')) {
+                return true;
+            }
+            do {
+                if (!item()) {
+                    return false;
+                }
+            } while (consume(','));
+            return consume(']');
+        }
+        
+        bool parseString(std::string& out) {
+            if (!consume('"')) {
+                return false;
+            }
+            out.clear();
+            while (p < end && *p != '"') {
+                if (*p == '\\') {
+                    if (++p == end) {
+                        return false;
+                    }
+                    switch (*p) {
+                        case 'n': out += '\n'; break;
+                        case 't': out += '\t'; break;
+                        case 'r': out += '\r'; break;
+                        case 'b': out += '\b'; break;
+                        case 'f': out += '\f'; break;
+                        case 'u':                   // Имена бенчмарков - ASCII, код не раскрываем
+                            if (end - p < 5) {
+                                return false;
+                            }
+                            out += '?';
+                            p += 4;
+                            break;
+                        default: out += *p; break;
+                    }
+                    p++;
+                } else {
+                    out += *p++;
+                }
+            }
+            return p < end && *p++ == '"';
+        }
+        
+        bool parseNumber(double& out) {
+            skipSpace();
+            char* number_end = nullptr;
+            out = std::strtod(p, &number_end);
+            if (number_end == p) {
+                return false;
+            }
+            p = number_end;
+            return true;
+        }
+        
+        bool parseSeries(PerfSeries& series) {
+            return parseObject([&](const std::string& key) {
+                if (key == "name") {
+                    return parseString(series.name);
+                }
+                if (key == "samples") {
+                    return parseArray([&]() {
+                        double value = 0.0;
+                        if (!parseNumber(value)) {
+                            return false;
+                        }
+                        series.samples.push_back(value);
+                        return true;
+                    });
+                }
+                return skipValue();
+            });
+        }
+        
+        bool skipLiteral(const char* literal) {
+            std::size_t n = std::strlen(literal);
+            if (static_cast<std::size_t>(end - p) < n || std::strncmp(p, literal, n) != 0) {
+                return false;
+            }
+            p += n;
+            return true;
+        }
+        
+        bool skipValue() {
+            skipSpace();
+            if (p == end) {
+                return false;
+            }
+            std::string text;
+            double number = 0.0;
+            switch (*p) {
+                case '{': return parseObject([&](const std::string&) { return skipValue(); });
+                case '[': return parseArray([&]() { return skipValue(); });
+                case '"': return parseString(text);
+                case 't': return skipLiteral("true");
+                case 'f': return skipLiteral("false");
+                case 'n': return skipLiteral("null");
+                default: return parseNumber(number);
+            }
+        }
+        
+        const char* p;
+        const char* end;
+    };
+}
+
+// === ПРОГОН ===
+
+const PerfSeries* PerfReport::find(const std::string& name) const {
+    for (const PerfSeries& s : series) {
+        if (s.name == name) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+PerfReport runPerfSuite(const PerfGateConfig& config) {
+    PerfReport report;
+    report.runs = config.runs;
+    report.steps = config.steps;
+    for (int run = 0; run < config.runs; run++) {
+        addResults(report, runEngineBenchmarks(config.steps, 1));
+        addResults(report, runStageBenchmarks(config.steps, 1));
+        addResults(report, runOutputBenchmarks(config.frames, 1, config.log_path));
+    }
+    return report;
+}
+
+// === JSON ===
+
+bool writePerfReport(const std::string& path, const PerfReport& report) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << std::setprecision(9);
+    out << "{\n  \"format\": \"" << REPORT_FORMAT << "\",\n  \"runs\": " << report.runs
+        << ",\n  \"steps\": " << report.steps << ",\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < report.series.size(); i++) {
+        const PerfSeries& s = report.series[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << jsonEscape(s.name)
+            << "\", \"unit\": \"ns/op\", \"mean\": " << perfStats(s.samples).mean << ", \"samples\": [";
+        for (std::size_t k = 0; k < s.samples.size(); k++) {
+            out << (k == 0 ? "" : ", ") << s.samples[k];
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+bool readPerfReport(const std::string& path, PerfReport& report) {
+    std::ifstream in(path);
+    if (!in) {
+        return false;
+    }
+    std::stringstream text;
+    text << in.rdbuf();
+    return ReportParser(text.str()).parse(report);
+}
+
+// === СТАТИСТИКА ===
+
+PerfStats perfStats(const std::vector<double>& samples) {
+    PerfStats stats;
+    stats.count = static_cast<int>(samples.size());
+    if (stats.count == 0) {
+        return stats;
+    }
+    for (double x : samples) {
+        stats.mean += x;
+    }
+    stats.mean /= stats.count;
+    if (stats.count < 2) {
+        stats.ci_low = -std::numeric_limits<double>::infinity();
+        stats.ci_high = std::numeric_limits<double>::infinity();
+        return stats;
+    }
+    
+    double sum_squares = 0.0;
+    for (double x : samples) {
+        sum_squares += (x - stats.mean) * (x - stats.mean);
+    }
+    stats.stddev = std::sqrt(sum_squares / (stats.count - 1));
+    double half_width = studentT95(stats.count - 1) * stats.stddev / std::sqrt(static_cast<double>(stats.count));
+    stats.ci_low = stats.mean - half_width;
+    stats.ci_high = stats.mean + half_width;
+    return stats;
+}
+
+std::vector<PerfComparison> comparePerfReports(const PerfReport& baseline, const PerfReport& current,
+                                               double threshold) {
+    std::vector<PerfComparison> comparisons;
+    auto compare = [&](const std::string& name, const PerfSeries* base, const PerfSeries* now) {
+        PerfComparison c;
+        c.name = name;
+        if (base == nullptr || now == nullptr || base->samples.empty() || now->samples.empty()) {
+            if (base != nullptr) {
+                c.baseline = perfStats(base->samples);
+            }
+            if (now != nullptr) {
+                c.current = perfStats(now->samples);
+            }
+            c.verdict = PerfVerdict::Missing;
+            comparisons.push_back(c);
+            return;
+        }
+        c.baseline = perfStats(base->samples);
+        c.current = perfStats(now->samples);
+        double diff = c.current.mean - c.baseline.mean;
+        c.change = diff / c.baseline.mean;
+        
+        // Интервал разности средних по Уэлчу (дисперсии не предполагаются равными)
+        if (c.baseline.count < 2 || c.current.count < 2) {
+            c.change_low = -std::numeric_limits<double>::infinity();
+            c.change_high = std::numeric_limits<double>::infinity();
+        } else {
+            double vb = c.baseline.stddev * c.baseline.stddev / c.baseline.count;
+            double vc = c.current.stddev * c.current.stddev / c.current.count;
+            double se = std::sqrt(vb + vc);
+            double df = se > 0 ? (vb + vc) * (vb + vc) /
+                                 (vb * vb / (c.baseline.count - 1) + vc * vc / (c.current.count - 1))
+                               : std::numeric_limits<double>::infinity();
+            double half_width = studentT95(df) * se;
+            c.change_low = (diff - half_width) / c.baseline.mean;
+            c.change_high = (diff + half_width) / c.baseline.mean;
+        }
+        
+        if (c.change_low > threshold) {
+            c.verdict = PerfVerdict::Slower;
+        } else if (c.change_high < -threshold) {
+            c.verdict = PerfVerdict::Faster;
+        }
+        comparisons.push_back(c);
+    };
+    
+    for (const PerfSeries& s : current.series) {
+        compare(s.name, baseline.find(s.name), &s);
+    }
+    for (const PerfSeries& s : baseline.series) {
+        if (current.find(s.name) == nullptr) {
+            compare(s.name, &s, nullptr);
+        }
+    }
+    return comparisons;
+}
+
+// === ТАБЛИЦА ===
+
+namespace {
+    const char* verdictLabel(PerfVerdict verdict) {
+        switch (verdict) {
+            case PerfVerdict::Slower: return "РЕГРЕССИЯ";
+            case PerfVerdict::Faster: return "быстрее";
+            case PerfVerdict::Missing: return "нет пары";
+            case PerfVerdict::Same: break;
+        }
+        return "";
+    }
+    
+    // Дополнение пробелами до width символов (не байт: в подписях UTF-8)
+    std::string pad(const std::string& s, std::size_t width, bool left) {
+        std::size_t chars = 0;
+        for (char c : s) {
+            chars += (static_cast<unsigned char>(c) & 0xC0) != 0x80 ? 1 : 0;
+        }
+        std::string fill(width > chars ? width - chars : 0, ' ');
+        return left ? s + fill : fill + s;
+    }
+    
+    // "24.10 ±0.30": среднее и полуширина 95% интервала
+    std::string formatStats(const PerfStats& s) {
+        if (s.count == 0) {
+            return "-";
+        }
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(2) << s.mean;
+        if (s.count >= 2) {
+            out << " ±" << (s.ci_high - s.mean);
+        }
+        return out.str();
+    }
+    
+    std::string formatPercent(double x) {
+        if (std::isinf(x)) {
+            return x > 0 ? "+inf" : "-inf";
+        }
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(1) << std::showpos << x * 100.0 << "%";
+        return out.str();
+    }
+    
+    void printRow(std::ostream& out, const PerfComparison& c, const std::string& label,
+                  const std::string& base_extra, const std::string& now_extra) {
+        out << pad(label, 30, true) << pad(formatStats(c.baseline) + base_extra, 20, false)
+            << pad(formatStats(c.current) + now_extra, 20, false);
+        if (c.verdict != PerfVerdict::Missing) {
+            out << pad(formatPercent(c.change), 10, false)
+                << "  [" << formatPercent(c.change_low) << ", " << formatPercent(c.change_high) << "]";
+        }
+        out << "  " << verdictLabel(c.verdict) << "\n";
+    }
+}
+
+bool printPerfComparison(std::ostream& out, const std::vector<PerfComparison>& comparisons, double threshold) {
+    out << pad("Бенчмарк [нс/оп]", 30, true) << pad("База", 20, false) << pad("Сейчас", 20, false)
+        << pad("Разница", 10, false) << "  95% интервал\n";
+    int regressions = 0;
+    for (const PerfComparison& c : comparisons) {
+        if (!isStage(c.name)) {
+            printRow(out, c, c.name, "", "");
+        }
+        regressions += c.verdict == PerfVerdict::Slower ? 1 : 0;
+    }
+    
+    // Стадии update(): доля стадии в сумме стадий - видно, какая часть шага выросла
+    double base_total = 0.0, now_total = 0.0;
+    for (const PerfComparison& c : comparisons) {
+        if (isStage(c.name)) {
+            base_total += c.baseline.mean;
+            now_total += c.current.mean;
+        }
+    }
+    if (base_total > 0 || now_total > 0) {
+        out << "\nСтадии F1PhysicsEngine::update() [нс/шаг, доля шага]:\n";
+        for (const PerfComparison& c : comparisons) {
+            if (!isStage(c.name)) {
+                continue;
+            }
+            auto share = [](double part, double total) {
+                std::ostringstream s;
+                s << " (" << std::fixed << std::setprecision(0) << (total > 0 ? part / total * 100.0 : 0.0) << "%)";
+                return s.str();
+            };
+            printRow(out, c, "  " + c.name.substr(std::strlen(STAGE_PREFIX)), share(c.baseline.mean, base_total),
+                     share(c.current.mean, now_total));
+        }
+    }
+    
+    out << "\nРегрессий: " << regressions << " (порог " << std::fixed << std::setprecision(1)
+        << threshold * 100.0 << "% на нижней границе 95% интервала)\n";
+    return regressions == 0;
+}
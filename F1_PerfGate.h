@@ -0,0 +1,81 @@
+#ifndef F1_PERF_GATE_H
+#define F1_PERF_GATE_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Порог регрессий производительности. Набор бенчмарков (движок, стадии
+// update(), парк, запись телеметрии, график) прогоняется runs раз подряд -
+// каждый прогон дает по отсчету на бенчмарк, так что дрейф машины ложится на
+// все бенчмарки одинаково. Отчет с отсчетами пишется в JSON; сравнение с
+// базовым отчетом - доверительный интервал разности средних (Уэлч, 95%).
+// Регрессия - бенчмарк, который медленнее базы больше чем на threshold
+// даже на нижней границе интервала: и значимо, и заметно.
+
+struct PerfGateConfig {
+    int runs = 7;                       // Отсчетов на бенчмарк
+    long steps = 1000000;               // Шагов движка в бенчмарке
+    long frames = 200000;               // Кадров телеметрии в бенчмарке записи
+    std::string log_path = "/tmp/f1_perfgate.f1log";   // Временный лог для записи телеметрии
+};
+
+// Отсчеты одного бенчмарка по прогонам [нс на операцию]
+struct PerfSeries {
+    std::string name;
+    std::vector<double> samples;
+};
+
+struct PerfReport {
+    int runs = 0;
+    long steps = 0;
+    std::vector<PerfSeries> series;
+    
+    const PerfSeries* find(const std::string& name) const;
+};
+
+PerfReport runPerfSuite(const PerfGateConfig& config);
+
+// JSON: {"format": "f1-perf-1", "runs", "steps", "benchmarks": [{"name", "unit",
+// "mean", "samples": [...]}]}. Читаются только name и samples, остальное -
+// для человека. false - ошибка файла или формата
+bool writePerfReport(const std::string& path, const PerfReport& report);
+bool readPerfReport(const std::string& path, PerfReport& report);
+
+// Среднее и 95% интервал среднего (t Стьюдента)
+struct PerfStats {
+    int count = 0;
+    double mean = 0.0;
+    double stddev = 0.0;
+    double ci_low = 0.0;
+    double ci_high = 0.0;
+};
+
+PerfStats perfStats(const std::vector<double>& samples);
+
+enum class PerfVerdict {
+    Same,                               // Разница не значима или меньше порога
+    Slower,
+    Faster,
+    Missing,                            // Есть только в одном из отчетов
+};
+
+struct PerfComparison {
+    std::string name;
+    PerfStats baseline;
+    PerfStats current;
+    double change = 0.0;                // Изменение среднего, доля базы (+ - медленнее)
+    double change_low = 0.0;            // 95% интервал изменения
+    double change_high = 0.0;
+    PerfVerdict verdict = PerfVerdict::Same;
+};
+
+// Все бенчмарки обоих отчетов в порядке текущего (потом - пропавшие из базы)
+std::vector<PerfComparison> comparePerfReports(const PerfReport& baseline, const PerfReport& current,
+                                               double threshold);
+
+// Таблица сравнения; стадии движка (engine.stage.*) - отдельным блоком с
+// долей стадии в шаге. true - регрессий нет
+bool printPerfComparison(std::ostream& out, const std::vector<PerfComparison>& comparisons, double threshold);
+
+#endif // F1_PERF_GATE_H
@@ -0,0 +1,384 @@
+#ifndef F1_PHYSICS_CORE_H
+#define F1_PHYSICS_CORE_H
+
+#include <cmath>
+#include <type_traits>
+#include <utility>
+#include "F1_Dual.h"
+
+// Общие формулы физики для всех вариантов движка (рантайм, специализированный).
+// Шаблоны по скалярному типу, чтобы варианты считали одно и то же
+// (в том числе на дуальных числах - настройка машины, F1_Tuning.h).
+
+namespace f1core {
+    constexpr double RAD_S_TO_RPM = 30.0 / 3.14159265358979323846; // [рад/с] -> [об/мин]
+    
+    // Кривая момента ДВС на полном газу: линейный рост до peak_rpm, спад на 40% к max_rpm.
+    // Обе ветви считаются всегда и выбираются в конце - так цикл по парку машин
+    // векторизуется (условные деления компилятор не выносит из ветки)
+    template <typename T>
+    constexpr T torqueCurve(T rpm, T peak_rpm, T max_rpm, T max_torque) {
+        T rising = max_torque * (rpm / peak_rpm);
+        T drop_factor = T(1.0) - T(0.4) * (rpm - peak_rpm) / (max_rpm - peak_rpm);
+        T falling = max_torque * drop_factor;
+        return rpm <= peak_rpm ? rising : falling;
+    }
+    
+    // Квадратичная аэродинамическая сила: F = k·v·|v|, k = ±0.5·ρ·C·A
+    template <typename T>
+    constexpr T aeroForce(T coefficient, T speed) {
+        return coefficient * speed * (speed < T(0) ? -speed : speed);
+    }
+    
+    // === ВЫБОР ВЕТВИ (как у std::, и для Dual) ===
+    
+    template <typename T>
+    T minOf(const T& a, const T& b) {
+        return b < a ? b : a;
+    }
+    
+    template <typename T>
+    T maxOf(const T& a, const T& b) {
+        return a < b ? b : a;
+    }
+    
+    template <typename T>
+    T clampTo(const T& value, const T& low, const T& high) {
+        return value < low ? low : high < value ? high : value;
+    }
+    
+    // Запись в поле float состояния - с тем же округлением, что у присваивания
+    // (перегрузка для Dual - в F1_Dual.h)
+    inline void storeNarrow(float& field, double value) {
+        field = static_cast<float>(value);
+    }
+    
+    // === ШАГ ДВИЖКА ===
+    // Тело F1PhysicsEngine::update, одно на все варианты: рантайм-движок,
+    // специализированный (параметры constexpr - компилятор сворачивает
+    // константы) и настройка машины на Dual<N> (F1_Tuning). От порядка
+    // операций зависят последние биты результата - варианты совпадают, пока
+    // его не трогают.
+    //
+    // State - поля CarState, Forces - поля ForceBreakdown (на скаляре State).
+    // Car - политика машины:
+    //   c.p                     параметры (поля CarParameters: скаляр или double)
+    //   c.slow                  медленное состояние (fuel_mass, tire_wear, lap_start_time, last_lap_time)
+    //   c.gearFactor(g)         передаточное число передачи g (с нуля) с главной парой
+    //   c.inertiaMass(g)        инерция ДВС, приведенная к массе автомобиля, на передаче g
+    //   c.brakeForceLimit()     предел силы торможения (с учетом температуры)
+    //   c.deployFraction(s)     доля отдачи MGU-K по карте трассы
+    //   c.aeroCoefficients(s, f, drag, lift)  коэффициенты по аэрокарте (без карты - не трогает)
+    //   c.dragFactor(), c.downforceFactor()   слипстрим и грязный воздух
+    //   c.brakeWork(work)       работа тормозов за шаг [Дж] (для температур)
+    //   c.travel(distance)      путь за шаг [м] (охлаждение температур)
+    //   c.recordForces(f)       разбивка сил шага (для тех, кто ее читает)
+    //   c.updateBrakes(s)       медленный шаг: предел тормозов и температуры
+    
+    // Стадии шага: Clock::mark(стадия) после каждой (F1PhysicsEngine::UpdateStage)
+    enum StepStage { STEP_ENGINE, STEP_FORCES, STEP_MOTION, STEP_SLOW };
+    
+    struct NoStageClock {
+        void mark(int) {}
+    };
+    
+    template <typename State>
+    using ScalarOf = std::decay_t<decltype(std::declval<State&>().engine_rpm)>;
+    
+    // Обороты колес: колеса катятся без проскальзывания
+    template <typename Parameters, typename State>
+    ScalarOf<State> wheelRpm(const Parameters& p, const State& s) {
+        return s.velocity.x / p.wheel_radius * RAD_S_TO_RPM;
+    }
+    
+    // 1. Двигатель и трансмиссия: момент ДВС, сцепление, обороты, момент на колесах
+    template <typename Car, typename State, typename Forces>
+    void engineStage(Car& c, State& s, Forces& f, const ScalarOf<State>& throttle, double dt) {
+        using T = ScalarOf<State>;
+        using std::abs;
+        const auto& p = c.p;
+        const int gear = s.current_gear - 1;
+        T wheel_rpm = wheelRpm(p, s);
+        
+        // Без газа, на отсечке или без топлива двигатель момент не развивает.
+        // Педаль задает долю момента по кривой (электронная дроссельная заслонка)
+        if (throttle <= 0 || s.rev_limiter_active || s.out_of_fuel || s.engine_rpm < p.null_rpm) {
+            f.engine_torque = 0.0;
+        } else {
+            f.engine_torque = throttle * torqueCurve<T>(s.engine_rpm, p.peak_rpm, p.max_rpm, p.max_torque);
+        }
+        
+        // Обороты на выходе сцепления (со стороны коробки)
+        T drivetrain_rpm = wheel_rpm * c.gearFactor(gear);
+        
+        // Момент на коленвалу за вычетом трения
+        T friction_torque = p.engine_friction_torque * s.engine_rpm / p.max_rpm;
+        T net_torque = f.engine_torque - friction_torque;
+        
+        // Ниже холостых оборотов трансмиссии сцепление выжимается, чтобы двигатель не заглох
+        if (s.clutch_locked && drivetrain_rpm < p.null_rpm) {
+            s.clutch_locked = false;
+        }
+        
+        if (s.clutch_locked) {
+            // Жесткая связь: двигатель крутится вместе с колесами
+            s.engine_rpm = drivetrain_rpm;
+            f.clutch_torque = net_torque;
+        } else {
+            // Проскальзывание: сцепление передает момент в сторону меньших оборотов
+            T engagement;
+            if (drivetrain_rpm >= p.null_rpm) {
+                engagement = 1.0;
+            } else if (throttle > 0) {
+                // Старт: сцепление замыкается по мере роста оборотов до launch_rpm
+                engagement = (s.engine_rpm - p.null_rpm) / (p.launch_rpm - p.null_rpm);
+                engagement = clampTo<T>(engagement, 0.0, 1.0);
+            } else {
+                engagement = 0.0;
+            }
+            
+            T slip_rpm = s.engine_rpm - drivetrain_rpm;
+            T clutch_torque = engagement * p.clutch_max_torque;
+            if (slip_rpm < 0) {
+                clutch_torque = -clutch_torque;
+            }
+            
+            // Инерция ДВС: dω/dt = (M_дв - M_тр - M_сц) / I
+            s.engine_rpm += (net_torque - clutch_torque) / p.engine_inertia * dt * RAD_S_TO_RPM;
+            if (s.engine_rpm < p.null_rpm) {
+                s.engine_rpm = p.null_rpm;  // Регулятор холостого хода
+            }
+            
+            // Обороты сравнялись (или проскочили синхронные) - замыкаем сцепление
+            T new_slip_rpm = s.engine_rpm - drivetrain_rpm;
+            bool crossed = (slip_rpm >= 0) != (new_slip_rpm >= 0);
+            if (engagement > 0 && drivetrain_rpm >= p.null_rpm &&
+                (crossed || abs(new_slip_rpm) < p.clutch_lock_rpm)) {
+                s.clutch_locked = true;
+                s.engine_rpm = drivetrain_rpm;
+                f.clutch_torque = net_torque;
+            } else {
+                f.clutch_torque = clutch_torque;
+            }
+        }
+        
+        // Ограничитель оборотов с гистерезисом
+        if (s.engine_rpm >= p.max_rpm) {
+            s.rev_limiter_active = true;
+        } else if (s.engine_rpm < p.max_rpm - p.rev_limiter_hysteresis) {
+            s.rev_limiter_active = false;
+        }
+        
+        // Момент и сила на колесах
+        f.wheel_torque = f.clutch_torque * c.gearFactor(gear);
+        f.traction_force = f.wheel_torque / p.wheel_radius;
+        
+        // Расход топлива считается по работе ДВС
+        storeNarrow(s.pending_engine_work, s.pending_engine_work + f.engine_torque * s.engine_rpm * dt);
+    }
+    
+    // ERS: отдача MGU-K на газу, рекуперация части тормозной силы
+    template <typename Car, typename State, typename Forces>
+    void ersStage(Car& c, State& s, Forces& f, const ScalarOf<State>& throttle, double dt) {
+        using T = ScalarOf<State>;
+        const auto& p = c.p;
+        const auto& ers = p.ers;
+        const int gear = s.current_gear - 1;
+        f.ers_torque = 0.0;
+        
+        // MGU-K сидит на коленвале - работает только при замкнутом сцеплении
+        if (!s.clutch_locked || s.engine_rpm <= 0) {
+            return;
+        }
+        T engine_omega = s.engine_rpm / RAD_S_TO_RPM;
+        
+        if (throttle > 0) {
+            // На отсечке ДВС молчит - и MGU-K тоже, иначе он один разгоняет
+            // машину и обороты за max_rpm
+            if (s.rev_limiter_active) {
+                return;
+            }
+            // Отдача по карте трассы, пропорционально педали
+            T fraction = c.deployFraction(s);
+            fraction *= throttle;
+            T available = minOf<T>(s.battery_energy, ers.deploy_limit_per_lap - s.lap_deployed_energy);
+            if (fraction <= 0 || available <= 0) {
+                return;
+            }
+            
+            T torque = minOf<T>(ers.mguk_max_torque, fraction * ers.mguk_max_power / engine_omega);
+            T energy = torque * engine_omega * dt / ers.deploy_efficiency;
+            if (energy > available) {
+                torque *= available / energy;
+                energy = available;
+            }
+            
+            f.ers_torque = torque;
+            s.battery_energy -= energy;
+            storeNarrow(s.lap_deployed_energy, s.lap_deployed_energy + energy);
+        }
+        else if (f.brake_force < 0) {
+            // Рекуперация: MGU-K забирает часть тормозного момента (brake-by-wire,
+            // суммарное замедление не меняется)
+            T room = minOf<T>(ers.battery_capacity - s.battery_energy,
+                              ers.harvest_limit_per_lap - s.lap_harvested_energy);
+            if (room <= 0) {
+                return;
+            }
+            
+            T gear_factor = c.gearFactor(gear);
+            T max_torque_from_brakes = -f.brake_force * p.wheel_radius / gear_factor;
+            T torque = minOf<T>(minOf<T>(ers.mguk_max_torque, ers.mguk_max_power / engine_omega),
+                                max_torque_from_brakes);
+            T energy = torque * engine_omega * dt * ers.harvest_efficiency;
+            if (energy > room) {
+                torque *= room / energy;
+                energy = room;
+            }
+            
+            f.ers_torque = -torque;
+            f.brake_force += torque * gear_factor / p.wheel_radius;
+            s.battery_energy += energy;
+            storeNarrow(s.lap_harvested_energy, s.lap_harvested_energy + energy);
+        }
+        
+        // Момент MGU-K идет на колеса через ту же передачу
+        f.wheel_torque += f.ers_torque * c.gearFactor(gear);
+        f.traction_force = f.wheel_torque / p.wheel_radius;
+    }
+    
+    // 2. Силы: тормоза, ERS, предел сцепления, аэродинамика, тормозной фактор
+    template <typename Car, typename State, typename Forces>
+    void forcesStage(Car& c, State& s, Forces& f, const ScalarOf<State>& throttle,
+                     const ScalarOf<State>& brake, double dt) {
+        using T = ScalarOf<State>;
+        const auto& p = c.p;
+        
+        // Сила торможения (только при нажатом тормозе)
+        f.brake_force = brake > 0 ? -s.brake_factor * c.brakeForceLimit() : T(0.0);
+        
+        ersStage(c, s, f, throttle, dt);
+        
+        // Сила тяги (и торможение двигателем) не больше силы сцепления.
+        // Прижимная сила отрицательная (вниз) - увеличивает нагрузку на шины
+        T max_traction = s.tire_grip * (s.mass * 9.81 - s.down_force);
+        f.traction_force = clampTo<T>(f.traction_force, -max_traction, max_traction);
+        
+        // Аэродинамические коэффициенты: постоянные или из карты
+        T drag_coefficient = p.drag_coefficient;
+        T downforce_coefficient = p.downforce_coefficient;
+        c.aeroCoefficients(s, f, drag_coefficient, downforce_coefficient);
+        
+        // Сопротивление воздуха: F = -0.5·ρ·v²·C_d·A (скорость не бывает отрицательной)
+        T drag_k = -0.5 * p.air_density * drag_coefficient * p.frontal_area * c.dragFactor();
+        f.drag_force = aeroForce<T>(drag_k, s.velocity.x);
+        
+        // Прижимная сила: F = 0.5·ρ·v²·C_l·A, всегда вниз (лимит сцепления следующего шага)
+        T down_k = 0.5 * p.air_density * downforce_coefficient * p.frontal_area * c.downforceFactor();
+        f.down_force = aeroForce<T>(down_k, s.velocity.x);
+        s.down_force = f.down_force;
+        
+        // Фактор идет к положению педали и упирается в него: без этого последний шаг
+        // рампы зависел от округления суммы шагов, и полное торможение могло не достигаться
+        T brake_step = p.brake_factor_coef * dt;
+        T factor = s.brake_factor < brake ? minOf<T>(s.brake_factor + brake_step, brake)
+                                          : maxOf<T>(s.brake_factor - brake_step, brake);
+        storeNarrow(s.brake_factor, factor);
+    }
+    
+    // 3. Движение: Эйлер по продольной силе, работа в пятне контакта, круг
+    template <typename Car, typename State, typename Forces>
+    void motionStage(Car& c, State& s, Forces& f, double dt) {
+        using T = ScalarOf<State>;
+        using std::abs;
+        const auto& p = c.p;
+        
+        // Второй закон Ньютона; при замкнутом сцеплении разгоняем и маховик
+        T total_force = f.traction_force + f.drag_force + f.brake_force;
+        T effective_mass = s.mass;
+        if (s.clutch_locked) {
+            effective_mass += c.inertiaMass(s.current_gear - 1);
+        }
+        f.acceleration = total_force / effective_mass;
+        
+        s.velocity.x += f.acceleration * dt;
+        s.position.x += s.velocity.x * dt;
+        
+        // Задней передачи нет, тормоза не разгоняют назад
+        if (s.velocity.x < 0) {
+            s.velocity.x = 0.0;
+        }
+        
+        // Работа в пятне контакта (износ шин) и тормозов, путь (их температура)
+        T travelled = s.velocity.x * dt;
+        storeNarrow(s.pending_tire_work,
+                    s.pending_tire_work + abs(f.traction_force + f.brake_force) * s.velocity.x * dt);
+        if (f.brake_force < 0) {
+            c.brakeWork(-f.brake_force * s.velocity.x * dt);
+        }
+        c.travel(travelled);
+        
+        // Дистанция круга (лимиты ERS считаются на круг)
+        s.lap_distance += travelled;
+        if (s.lap_distance >= p.track_length) {
+            s.lap_distance -= p.track_length;
+            s.lap++;
+            c.slow.last_lap_time = s.time - c.slow.lap_start_time;
+            c.slow.lap_start_time = s.time;
+            s.lap_deployed_energy = 0.0f;
+            s.lap_harvested_energy = 0.0f;
+        }
+    }
+    
+    // 4. Медленные величины: топливо -> масса, износ -> сцепление, тормоза
+    template <typename Car, typename State>
+    void slowStage(Car& c, State& s) {
+        using T = ScalarOf<State>;
+        const auto& p = c.p;
+        auto& slow = c.slow;
+        
+        // Топливо: работа ДВС -> сожженная масса
+        T fuel_used = s.pending_engine_work / RAD_S_TO_RPM / p.fuel_work_per_kg;
+        slow.fuel_mass = maxOf<T>(0.0, slow.fuel_mass - fuel_used);
+        s.out_of_fuel = slow.fuel_mass <= 0.0;
+        s.mass = p.mass + slow.fuel_mass;
+        
+        // Шины: износ пропорционален работе в пятне контакта, сцепление падает линейно
+        slow.tire_wear = minOf<T>(1.0, slow.tire_wear + s.pending_tire_work * p.tire_wear_per_joule);
+        s.tire_grip = p.tire_friction * (1.0 - p.tire_grip_loss * slow.tire_wear);
+        c.updateBrakes(s);
+        
+        s.pending_engine_work = 0.0f;
+        s.pending_tire_work = 0.0f;
+        s.slow_timer = 0.0;
+    }
+    
+    // Полный шаг. Педали аналоговые, 0..1 (вне диапазона обрезаются)
+    template <typename Car, typename State, typename Forces, typename Clock>
+    void step(Car& c, State& s, Forces& f, ScalarOf<State> throttle, ScalarOf<State> brake, double dt,
+              Clock& clock) {
+        using T = ScalarOf<State>;
+        s.time += dt;
+        throttle = clampTo<T>(throttle, 0.0, 1.0);
+        brake = clampTo<T>(brake, 0.0, 1.0);
+        
+        engineStage(c, s, f, throttle, dt);
+        clock.mark(STEP_ENGINE);
+        
+        forcesStage(c, s, f, throttle, brake, dt);
+        clock.mark(STEP_FORCES);
+        
+        motionStage(c, s, f, dt);
+        c.recordForces(f);
+        clock.mark(STEP_MOTION);
+        
+        // Медленные величины - на грубом шаге
+        s.slow_timer += dt;
+        if (s.slow_timer >= c.p.slow_update_interval) {
+            slowStage(c, s);
+        }
+        clock.mark(STEP_SLOW);
+    }
+}
+
+#endif // F1_PHYSICS_CORE_H
@@ -1,6 +1,32 @@
 #include "F1_Physics_build_2.h"
+#include "F1_PhysicsCore.h"
 #include <cmath>
 #include <algorithm>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using f1core::RAD_S_TO_RPM;
+
+namespace {
+    // Отметки updateProfiled(): такты с прошлой отметки - в стадию
+    struct ProfileStageClock {
+        F1PhysicsEngine::StageProfile& profile;
+        std::uint64_t last;
+        
+        void mark(int stage) {
+            std::uint64_t now = F1PhysicsEngine::stageClock();
+            profile.ticks[stage] += now - last;
+            last = now;
+        }
+    };
+    
+    static_assert(int(F1PhysicsEngine::STAGE_ENGINE) == f1core::STEP_ENGINE &&
+                  int(F1PhysicsEngine::STAGE_FORCES) == f1core::STEP_FORCES &&
+                  int(F1PhysicsEngine::STAGE_MOTION) == f1core::STEP_MOTION &&
+                  int(F1PhysicsEngine::STAGE_SLOW) == f1core::STEP_SLOW, "stage order must match f1core::step");
+}
 
 // === КОНСТРУКТОР И СБРОС ===
 
@@ -8,34 +34,117 @@ F1PhysicsEngine::F1PhysicsEngine() {
     reset();
 }
 
+F1PhysicsEngine::F1PhysicsEngine(const CarParameters& car_params) : params(car_params) {
+    reset();
+}
+
 void F1PhysicsEngine::reset() {
     current_state = CarState();  // Обнуляем всё состояние
     current_state.current_gear = 1;
-    calculateWheelPositions();   // Рассчитываем начальные позиции колес
+    current_state.engine_rpm = params.null_rpm;  // Двигатель на холостых
+    current_state.battery_energy = params.ers.battery_initial_energy;
+    slow_state = SlowState();
+    slow_state.fuel_mass = params.fuel_initial_mass;
+    resetThermal(slow_state.thermal, params.thermal);
+    pending_brake_work = 0.0;
+    pending_distance = 0.0;
+    inv_heave_stiffness = 1.0 / params.heave_stiffness;
+    last_forces = ForceBreakdown();
+    updateGearCache();
+    updateSlowState();
 }
 
 // === ПУБЛИЧНЫЕ МЕТОДЫ ===
 
-void F1PhysicsEngine::update(double dt, bool gas_pedal, bool brake_pedal, double steering) {
-    // 1. Двигатель и трансмиссия
-    calculateEnginePhysics(gas_pedal, dt);
-    
-    // 2. Силы
-    calculateForces(gas_pedal, brake_pedal, steering);
+void F1PhysicsEngine::update(double dt, double throttle, double brake, double steering) {
+    f1core::NoStageClock clock;
+    step(dt, throttle, brake, clock);
+    (void)steering;   // Движение одномерное - руль пока не используется
+}
+
+void F1PhysicsEngine::updateProfiled(double dt, double throttle, double brake, double steering,
+                                     StageProfile& profile) {
+    ProfileStageClock clock{profile, stageClock()};
+    step(dt, throttle, brake, clock);
+    profile.steps++;
+    (void)steering;
+}
+
+std::uint64_t F1PhysicsEngine::stageClock() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+const char* F1PhysicsEngine::stageName(int stage) {
+    switch (stage) {
+        case STAGE_ENGINE: return "engine";
+        case STAGE_FORCES: return "forces";
+        case STAGE_MOTION: return "motion";
+        case STAGE_SLOW: return "slow";
+    }
+    return "?";
+}
+
+// Тело шага - общее для всех вариантов движка (f1core::step): двигатель ->
+// силы -> движение -> медленные величины на грубом шаге
+template <typename Clock>
+void F1PhysicsEngine::step(double dt, double throttle, double brake, Clock& clock) {
+    StepCar car(*this);
+    ForceBreakdown forces;
+    f1core::step(car, current_state, forces, throttle, brake, dt, clock);
+}
+
+void F1PhysicsEngine::setFuelLoad(double fuel_kg) {
+    slow_state.fuel_mass = std::max(0.0, fuel_kg);
+    updateSlowState();
+}
+
+void F1PhysicsEngine::changeTires() {
+    slow_state.tire_wear = 0.0;
+    resetTireTemperatures(slow_state.thermal, params.thermal);
+    updateSlowState();
+}
+
+void F1PhysicsEngine::setStartPosition(double position) {
+    current_state.position.x = position;
     
-    // 3. Движение
-    integrateMotion(dt);
+    // Позади линии старта - еще "нулевой" круг, счет кругов начнется с ее пересечения
+    current_state.lap = 0;
+    current_state.lap_distance = position;
+    while (current_state.lap_distance < 0) {
+        current_state.lap_distance += params.track_length;
+        current_state.lap--;
+    }
+}
+
+void F1PhysicsEngine::holdBehind(double max_position, double max_velocity) {
+    double correction = current_state.position.x - max_position;
+    if (correction > 0) {
+        current_state.position.x = max_position;
+        current_state.lap_distance -= correction;
+        if (current_state.lap_distance < 0) {
+            current_state.lap_distance += params.track_length;
+            current_state.lap--;
+        }
+    }
     
-    // 4. Геометрия
-    calculateWheelPositions();
+    if (current_state.velocity.x > max_velocity) {
+        current_state.velocity.x = max_velocity;
+    }
 }
 
 void F1PhysicsEngine::shiftUp() {
-    if (current_state.current_gear < 8) {
+    if (current_state.current_gear < params.gear_count) {
         current_state.current_gear++;
+        updateGearCache();
         // Синхронизируем RPM двигателя с новым передаточным числом
-        double gear_factor = params.gear_ratios[current_state.current_gear - 1] * params.final_drive;
-        current_state.engine_rpm = current_state.wheel_rpm * gear_factor;
+        if (current_state.clutch_locked) {
+            current_state.engine_rpm = getWheelRPM() * gear_factor;
+        }
     }
 }
 
@@ -44,194 +153,103 @@ void F1PhysicsEngine::shiftDown() {
         double new_gear_factor = params.gear_ratios[current_state.current_gear - 2] * params.final_drive;
         
         // Проверяем, не превысит ли понижение передачи максимальные обороты
-        if (current_state.wheel_rpm * new_gear_factor <= params.max_rpm) {
+        if (getWheelRPM() * new_gear_factor <= params.max_rpm) {
             current_state.current_gear--;
-            current_state.engine_rpm = current_state.wheel_rpm * new_gear_factor;
+            updateGearCache();
+            if (current_state.clutch_locked) {
+                current_state.engine_rpm = getWheelRPM() * gear_factor;
+            }
         }
     }
 }
 
-// === ПРИВАТНЫЕ МЕТОДЫ РАСЧЕТА ===
+// === ПРОИЗВОДНЫЕ ВЕЛИЧИНЫ ===
 
-void F1PhysicsEngine::calculateEnginePhysics(bool gas_pedal, double dt) {
-    calculateRPM(gas_pedal, dt);
-    calculateTorque();
-    calculateWheelParameters();
+double F1PhysicsEngine::getSpeed() const {
+    return std::sqrt(current_state.velocity.x * current_state.velocity.x +
+                     current_state.velocity.y * current_state.velocity.y);
 }
 
-void F1PhysicsEngine::calculateRPM(bool gas_pedal, double dt) {
-    if (gas_pedal) {
-        current_state.engine_rpm += dt * sigmaFactor();
-        if (current_state.engine_rpm > params.max_rpm) {
-            current_state.engine_rpm = params.max_rpm;
-        }
-    } else {
-        current_state.engine_rpm -= dt * params.deceleration_rate;
-        if (current_state.engine_rpm < 0) {
-            current_state.engine_rpm = 0;
-        }
-    }
+double F1PhysicsEngine::getWheelRPM() const {
+    // Колеса катятся без проскальзывания
+    return current_state.velocity.x / params.wheel_radius * RAD_S_TO_RPM;
 }
 
-void F1PhysicsEngine::calculateTorque() {
-    if (current_state.engine_rpm < params.null_rpm) {
-        current_state.engine_torque = 0;
-    }
-    else if (current_state.engine_rpm <= params.peak_rpm) {
-        current_state.engine_torque = params.max_torque * (current_state.engine_rpm / params.peak_rpm);
-    }
-    else {
-        double drop_factor = 1.0 - 0.4 * (current_state.engine_rpm - params.peak_rpm) / (params.max_rpm - params.peak_rpm);
-        current_state.engine_torque = params.max_torque * drop_factor;
-    }
+double F1PhysicsEngine::getRideHeight() const {
+    // Подвеска - одна пружина: прижим (отрицательный) садит машину вниз
+    return std::max(params.static_ride_height + current_state.down_force * inv_heave_stiffness, 0.0);
 }
 
-void F1PhysicsEngine::calculateWheelParameters() {
-    double gear_factor = params.gear_ratios[current_state.current_gear - 1] * params.final_drive;
-    current_state.wheel_rpm = current_state.engine_rpm / gear_factor;
-    current_state.wheel_torque = current_state.engine_torque * gear_factor;
-    current_state.traction_force = current_state.wheel_torque / params.wheel_radius;
+double F1PhysicsEngine::getAeroBalance() const {
+    return aero_map ? aero_map->balance(current_state.velocity.x, getRideHeight(), drs_open) : 0.5;
 }
 
-double F1PhysicsEngine::sigmaFactor() const {
-    if ((current_state.engine_rpm > 0 && current_state.engine_rpm < params.max_rpm / 3) || 
-        (current_state.engine_rpm > params.max_rpm / 3 * 2 && current_state.engine_rpm < params.max_rpm)) {
-        return 0.5 * params.acceleration_rate_max;
-    }
-    else {
-        return params.acceleration_rate_max;
-    }
-}
-
-void F1PhysicsEngine::calculateBrakeFactor(bool brake_pedal, double dt) {
-    if (brake_pedal) {
-        if (current_state.brake_factor + params.brake_factor_coef * dt <= 1) {
-            current_state.brake_factor += params.brake_factor_coef * dt;
-        }
-    } else {
-        if (current_state.brake_factor - params.brake_factor_coef * dt >= 0) {
-            current_state.brake_factor -= params.brake_factor_coef * dt;
-        }
-    }
-}
-
-void F1PhysicsEngine::applyBrakes(double dt) {
-    if (current_state.brake_factor == 0) { 
-        calculateBrakeFactor(true, dt); 
-    }
-    
-    if (current_state.wheel_rpm - current_state.brake_factor * params.brake_rate * dt >= 0) {
-        current_state.wheel_rpm -= current_state.brake_factor * params.brake_rate * dt;
-        double gear_factor = params.gear_ratios[current_state.current_gear - 1] * params.final_drive;
-        current_state.engine_rpm = current_state.wheel_rpm * gear_factor;
-        
-        calculateTorque();
-        calculateWheelParameters();
-    }
-}
-
-void F1PhysicsEngine::calculateWheelPositions() {
+std::array<F1PhysicsEngine::Point2D, 4> F1PhysicsEngine::getWheelPositions() const {
     double half_wheelbase = params.wheelbase / 2.0;
     double half_track = params.track_width / 2.0;
+    const Point2D& p = current_state.position;
     
     // Пока просто ставим колеса вокруг центра (без учета поворота)
-    current_state.wheel_positions[0] = {  // FL (переднее левое)
-        current_state.position.x + half_wheelbase,
-        current_state.position.y + half_track
-    };
-    
-    current_state.wheel_positions[1] = {  // FR (переднее правое)
-        current_state.position.x + half_wheelbase, 
-        current_state.position.y - half_track
-    };
-    
-    current_state.wheel_positions[2] = {  // RL (заднее левое)
-        current_state.position.x - half_wheelbase,
-        current_state.position.y + half_track
-    };
-    
-    current_state.wheel_positions[3] = {  // RR (заднее правое)
-        current_state.position.x - half_wheelbase,
-        current_state.position.y - half_track
-    };
+    return {{
+        { p.x + half_wheelbase, p.y + half_track },  // FL (переднее левое)
+        { p.x + half_wheelbase, p.y - half_track },  // FR (переднее правое)
+        { p.x - half_wheelbase, p.y + half_track },  // RL (заднее левое)
+        { p.x - half_wheelbase, p.y - half_track }   // RR (заднее правое)
+    }};
 }
 
-void F1PhysicsEngine::calculateForces(bool gas_pedal, bool brake_pedal, double steering) {
-    // 1. СИЛА ТЯГИ (только при нажатом газе)
-    current_state.traction_force = gas_pedal ? calculateTractionForce() : 0.0;
-    
-    // 2. СОПРОТИВЛЕНИЕ ВОЗДУХА (всегда против движения)
-    current_state.drag_force = calculateDragForce();
-    
-    // 3. СИЛА ТОРМОЖЕНИЯ (только при нажатом тормозе)
-    current_state.brake_force = brake_pedal ? calculateBrakeForce() : 0.0;
-    
-    // 4. ПРИЖИМНАЯ СИЛА (вертикальная - пока не влияет на 1D движение)
-    current_state.down_force = calculateDownForce();
-    
-    // 5. Управление тормозным фактором и применение тормозов
-    calculateBrakeFactor(brake_pedal, 0.01); // dt = 0.01 как в оригинале
-    if (brake_pedal) {
-        applyBrakes(0.01);
-    }
+// === ПРИВАТНЫЕ МЕТОДЫ РАСЧЕТА ===
+
+void F1PhysicsEngine::updateGearCache() {
+    gear_factor = params.gear_ratios[current_state.current_gear - 1] * params.final_drive;
     
-    // 💡 ПРИМЕЧАНИЕ: steering пока не используем для 1D движения
+    // Замкнутое сцепление: инерция ДВС "видна" колесам как добавочная масса I·(i/r)²
+    double ratio_per_radius = gear_factor / params.wheel_radius;
+    drivetrain_inertia_mass = params.engine_inertia * ratio_per_radius * ratio_per_radius;
 }
 
-double F1PhysicsEngine::calculateTractionForce() const {
-    double max_traction = params.tire_friction * (params.mass * 9.81 + current_state.down_force);
-    
-    // Не даем силе тяги превысить силу сцепления
-    return std::min(current_state.traction_force, max_traction);
+void F1PhysicsEngine::updateSlowState() {
+    StepCar car(*this);
+    f1core::slowStage(car, current_state);
 }
 
-double F1PhysicsEngine::calculateDragForce() const {
-    // Формула сопротивления воздуха: F_drag = -0.5 * ρ * v² * C_d * A
-    double drag_force = -0.5 * params.air_density * 
-                       current_state.speed * std::abs(current_state.speed) *
-                       params.drag_coefficient * params.frontal_area;
-    
-    return drag_force;
+// === ПОЛИТИКА МАШИНЫ ДЛЯ f1core::step ===
+
+double F1PhysicsEngine::StepCar::deployFraction(const CarState& s) const {
+    return engine.deployment_map ? engine.deployment_map->deployFraction(s.lap_distance) : 1.0;
 }
 
-double F1PhysicsEngine::calculateDownForce() const {
-    // Формула прижимной силы: F_down = 0.5 * ρ * v² * C_l * A
-    double down_force = 0.5 * params.air_density * 
-                       current_state.speed * std::abs(current_state.speed) *
-                       params.downforce_coefficient * params.frontal_area;
-    
-    // Прижимная сила всегда отрицательная (вниз)
-    return down_force;
+void F1PhysicsEngine::StepCar::aeroCoefficients(const CarState& s, ForceBreakdown& f, double& drag, double& lift) {
+    // С картой - по скорости, клиренсу (от прижима прошлого шага) и DRS
+    if (engine.aero_map) {
+        double ride_height = engine.getRideHeight();
+        AeroDragLift aero = engine.aero_map->evaluate(s.velocity.x, ride_height, engine.drs_open,
+                                                      engine.aero_cursor);
+        drag = aero.drag;
+        lift = aero.lift;
+        f.ride_height = ride_height;
+    }
 }
 
-double F1PhysicsEngine::calculateBrakeForce() const {
-    // Используем brake_factor для расчета силы торможения
-    return -current_state.brake_factor * params.max_brake_force;
+void F1PhysicsEngine::StepCar::recordForces(const ForceBreakdown& f) {
+    // Разбивка сил - только для тех, кто ее читает
+    if (engine.record_forces) {
+        engine.last_forces = f;
+    }
 }
 
-void F1PhysicsEngine::integrateMotion(double dt) {
-    // 1. СУММИРУЕМ ВСЕ СИЛЫ (пока только продольные для 1D)
-    double total_force = current_state.traction_force + 
-                        current_state.drag_force + 
-                        current_state.brake_force;
-    
-    // 2. ВТОРОЙ ЗАКОН НЬЮТОНА: F = m × a
-    current_state.acceleration.x = total_force / params.mass;
-    current_state.acceleration.y = 0.0;  // Пока нет бокового движения
-    
-    // 3. ИНТЕГРИРУЕМ УСКОРЕНИЕ → СКОРОСТЬ (метод Эйлера)
-    current_state.velocity.x += current_state.acceleration.x * dt;
-    
-    // 4. ИНТЕГРИРУЕМ СКОРОСТЬ → ПОЗИЦИЯ
-    current_state.position.x += current_state.velocity.x * dt;
-    
-    // 5. РАСЧЕТ МОДУЛЯ СКОРОСТИ
-    current_state.speed = std::sqrt(current_state.velocity.x * current_state.velocity.x + 
-                                   current_state.velocity.y * current_state.velocity.y);
+void F1PhysicsEngine::StepCar::updateBrakes(CarState& s) {
+    engine.brake_force_limit = p.max_brake_force;
     
-    // 6. ЗАЩИТА ОТ ОТРИЦАТЕЛЬНОЙ СКОРОСТИ
-    if (current_state.velocity.x < 0 && current_state.brake_force == 0) {
-        current_state.velocity.x = 0;
-        current_state.speed = 0;
+    // Температуры: работа и путь копятся каждый шаг, пересчет - на тепловом
+    if (p.thermal.enabled) {
+        ThermalState& thermal = slow.thermal;
+        accumulateThermal(thermal, engine.pending_brake_work, s.pending_tire_work,
+                          engine.pending_distance, s.slow_timer);
+        updateThermal(thermal, p.thermal);
+        s.tire_grip *= thermal.grip_factor;
+        engine.brake_force_limit *= thermal.brake_efficiency;
     }
+    engine.pending_brake_work = 0.0;
+    engine.pending_distance = 0.0;
 }
@@ -3,6 +3,10 @@
 
 #include <vector>
 #include <array>
+#include <cstdint>
+#include "F1_Aero.h"
+#include "F1_ERS.h"
+#include "F1_Thermal.h"
 
 class F1PhysicsEngine {
 public:
@@ -18,50 +22,94 @@ public:
         Vector2D(double x = 0, double y = 0) : x(x), y(y) {}
     };
     
-    // Основная структура состояния автомобиля
+    // Основная структура состояния автомобиля.
+    // Только то, что шаг читает и пишет каждый раз - две кэш-линии на машину.
+    // Производные величины (модуль скорости, колеса, силы) считаются по запросу.
     struct CarState {
         // Поступательное движение
         Point2D position;           // Позиция центра масс [м]
         Vector2D velocity;          // Скорость центра масс [м/с]
-        Vector2D acceleration;      // Ускорение центра масс [м/с²]
-        double speed;               // Модуль скорости [м/с]
         
-        // Вращательное движение  
-        double angle = 0.0;         // Угол поворота автомобиля [рад]
-        double angular_velocity = 0.0;  // Угловая скорость [рад/с]
+        // Двигатель
+        double engine_rpm = 0.0;
+        double down_force = 0.0;    // Прижимная сила прошлого шага (для лимита сцепления) [Н]
         
-        // Колеса (0=FL, 1=FR, 2=RL, 3=RR)
-        std::array<Point2D, 4> wheel_positions;    // Позиции колес
+        // Система рекуперации (ERS)
+        double battery_energy = 0.0;        // Заряд батареи [Дж]
         
-        // Двигатель и трансмиссия
-        double engine_rpm = 0.0;
-        double engine_torque = 0.0;
-        double wheel_rpm = 0.0;
-        double wheel_torque = 0.0;
-        int current_gear = 1;
+        // Круг
+        double time = 0.0;                  // Время с начала заезда [с]
+        double lap_distance = 0.0;          // Дистанция от линии старта [м]
         
+        // Медленные величины, которые шаг читает (пишет их только медленное обновление)
+        double mass = 0.0;                  // Полная масса с топливом [кг]
+        double tire_grip = 0.0;             // Текущий коэффициент трения шин
+        double slow_timer = 0.0;            // Время с последнего медленного обновления [с]
+        
+        // Тормозная система
+        float brake_factor = 0.0f;
         
-        // Силы
+        // Лимиты ERS на круг
+        float lap_deployed_energy = 0.0f;   // Отдано за текущий круг [Дж]
+        float lap_harvested_energy = 0.0f;  // Рекуперировано за текущий круг [Дж]
+        
+        // Накопители быстрого шага для медленного обновления
+        float pending_engine_work = 0.0f;   // Работа ДВС [Н·м·об/мин·с]
+        float pending_tire_work = 0.0f;     // Работа сил в пятне контакта [Дж]
+        
+        int lap = 0;
+        std::int16_t current_gear = 1;
+        bool clutch_locked = false;         // Сцепление замкнуто (обороты ДВС = обороты трансмиссии)
+        bool rev_limiter_active = false;    // Отсечка по оборотам
+        bool out_of_fuel = false;
+    };
+    
+    // Холодные данные: меняются на медленном шаге или раз за круг
+    struct SlowState {
+        double fuel_mass = 0.0;             // Топливо в баке [кг]
+        double tire_wear = 0.0;             // Износ шин [0..1]
+        double lap_start_time = 0.0;        // Время пересечения линии [с]
+        double last_lap_time = 0.0;         // Время последнего полного круга [с]
+        ThermalState thermal;               // Температуры тормозов и шин (при params.thermal.enabled)
+    };
+    
+    // Разбивка сил и моментов шага. Живет на стеке шага; сохраняется,
+    // только если кто-то читает ее (enableForceBreakdown)
+    struct ForceBreakdown {
+        double engine_torque = 0.0;     // Момент ДВС [Н·м]
+        double clutch_torque = 0.0;     // Момент, передаваемый сцеплением [Н·м]
+        double ers_torque = 0.0;        // Момент MGU-K на коленвале (+ отдача, - рекуперация) [Н·м]
+        double wheel_torque = 0.0;      // Момент на колесах [Н·м]
         double traction_force = 0.0;
         double drag_force = 0.0;
         double brake_force = 0.0;
         double down_force = 0.0;
-        
-        // Тормозная система
-        double brake_factor = 0.0;
+        double ride_height = 0.0;       // Клиренс, по которому взяты коэффициенты [м]
+        double acceleration = 0.0;      // Продольное ускорение [м/с²]
+    };
+    
+    // Стадии шага update() - для профиля по стадиям (updateProfiled)
+    enum UpdateStage {
+        STAGE_ENGINE,               // Двигатель, сцепление, обороты
+        STAGE_FORCES,               // ERS, тяга, аэродинамика, тормоза
+        STAGE_MOTION,               // Интегрирование, круг, разбивка сил
+        STAGE_SLOW,                 // Медленные величины (на грубом шаге)
+        STAGE_COUNT
     };
-
-private:
-    // Текущее состояние (меняется каждый кадр)
-    CarState current_state;
     
-    // Параметры автомобиля (константы, не меняются)
+    // Время стадий, накопленное updateProfiled, в тактах stageClock()
+    struct StageProfile {
+        std::array<std::uint64_t, STAGE_COUNT> ticks{};
+        std::uint64_t steps = 0;
+    };
+    
+    // Параметры автомобиля (константы, не меняются во время заезда)
     struct CarParameters {
         // === ГЕОМЕТРИЯ ===
         double wheelbase = 3.7;         // Колесная база [м]
         double track_width = 1.8;       // Колея [м]
         double wheel_radius = 0.33;     // Радиус колеса [м]
-        double mass = 740.0;            // Масса [кг]
+        double mass = 740.0;            // Масса без топлива [кг]
         double moment_of_inertia = 1000.0; // Момент инерции [кг·м²]
         
         // === ДВИГАТЕЛЬ И ТРАНСМИССИЯ ===
@@ -69,70 +117,187 @@ private:
         double max_torque = 500.0;      // Максимальный крутящий момент [Н·м]
         double peak_rpm = 11000.0;      // Обороты максимального момента
         double null_rpm = 4000.0;       // Обороты холостого хода
-        double deceleration_rate = 500.0; // Скорость снижения RPM
-        double acceleration_rate_max = 3000.0; // Макс. скорость ускорения RPM
-        double time_to_max_rpm = 5.0;   // Время до макс. RPM
+        double engine_inertia = 0.08;   // Момент инерции ДВС с маховиком [кг·м²]
+        double engine_friction_torque = 40.0; // Момент трения ДВС на макс. оборотах [Н·м]
+        double rev_limiter_hysteresis = 200.0; // Гистерезис отсечки [об/мин]
+        
+        // === СЦЕПЛЕНИЕ ===
+        double clutch_max_torque = 800.0; // Максимальный момент сцепления [Н·м]
+        double launch_rpm = 9000.0;     // Обороты полного замыкания сцепления при старте
+        double clutch_lock_rpm = 100.0; // Проскальзывание, при котором сцепление замыкается
         std::array<double, 8> gear_ratios = {3.2, 2.5, 2.0, 1.7, 1.4, 1.2, 1.1, 1.0}; // КПП
+        int gear_count = 8;             // Число передач (не больше размера gear_ratios)
         double final_drive = 3.5;       // Главная передача
         
         // === АЭРОДИНАМИКА ===
         double drag_coefficient = 0.9;  // Коэффициент лобового сопротивления
         double frontal_area = 1.5;      // Фронтальная площадь [м²]
         double air_density = 1.225;     // Плотность воздуха [кг/м³]
-        const double downforce_coefficient = -3.0; // Коэффициент прижимной силы 
+        double downforce_coefficient = -3.0; // Коэффициент прижимной силы (без карты)
+        double static_ride_height = 0.05; // Клиренс без прижима [м]
+        double heave_stiffness = 1.5e6;  // Жесткость подвески по прижиму [Н/м]
         
         // === ШИНЫ И ТОРМОЗА ===
         double tire_friction = 1.5;     // Коэффициент трения шин
         double max_brake_force = 15000.0; // Максимальная сила торможения [Н]
         double brake_factor_coef = 1.0; // Коэффициент торможения
-        double brake_rate = 1000.0;     // Скорость торможения
+        
+        // === ERS ===
+        ErsParameters ers;
+        
+        // === ТОПЛИВО И ИЗНОС ===
+        double fuel_initial_mass = 110.0;     // Топливо на старте [кг]
+        double fuel_work_per_kg = 22.0e6;     // Полезная работа ДВС на кг топлива [Дж/кг]
+        double tire_wear_per_joule = 1.5e-9;  // Износ на джоуль работы в пятне контакта
+        double tire_grip_loss = 0.3;          // Потеря сцепления при полном износе (доля)
+        double slow_update_interval = 0.1;    // Шаг медленных величин [с] (0 - каждый шаг)
+        
+        // === ТЕМПЕРАТУРЫ ТОРМОЗОВ И ШИН ===
+        ThermalParameters thermal;            // По умолчанию выключены
+        
+        // === ТРАССА ===
+        double track_length = 5000.0;   // Длина круга [м]
     };
+
+private:
+    // Текущее состояние (меняется каждый кадр)
+    CarState current_state;
+    SlowState slow_state;
+    
+    // Силы последнего шага (пишутся, только если включена разбивка)
+    ForceBreakdown last_forces;
+    bool record_forces = false;
+    
+    // Аэродинамическое влияние соседних машин (выставляет гоночный слой)
+    double slipstream_drag_factor = 1.0;     // Множитель сопротивления в слипстриме
+    double dirty_air_downforce_factor = 1.0; // Множитель прижимной силы в грязном воздухе
     
     CarParameters params;
+    
+    // Кэш трансмиссии (пересчитывается только при смене передачи)
+    double gear_factor = 0.0;           // Передаточное число текущей передачи с главной парой
+    double drivetrain_inertia_mass = 0.0; // Инерция ДВС, приведенная к массе автомобиля [кг]
+    
+    // Подвеска: 1 / heave_stiffness (клиренс считается каждый шаг с картой)
+    double inv_heave_stiffness = 0.0;
+    
+    // Тормоза с учетом температуры (пересчитывается на медленном шаге)
+    double brake_force_limit = 0.0;     // max_brake_force · эффективность тормозов [Н]
+    double pending_brake_work = 0.0;    // Работа тормозов с медленного шага [Дж] (в CarState нет места)
+    double pending_distance = 0.0;      // Путь с медленного шага [м] (охлаждение тормозов и шин)
+    
+    // Карта отдачи ERS (не владеем; nullptr - отдача на полной мощности)
+    const ErsDeploymentMap* deployment_map = nullptr;
+    
+    // Аэрокарта (не владеем; nullptr - постоянные drag/downforce_coefficient)
+    const AeroMap* aero_map = nullptr;
+    AeroMap::Cursor aero_cursor;        // Ячейка карты прошлого шага
+    bool drs_open = false;
 
 public:
     // Конструктор
     F1PhysicsEngine();
+    explicit F1PhysicsEngine(const CarParameters& car_params);
     
     // Сброс состояния
     void reset();
     
     // === ПУБЛИЧНЫЙ ИНТЕРФЕЙС ===
     
-    // Основной метод обновления физики
-    void update(double dt, bool gas_pedal, bool brake_pedal, double steering = 0.0);
+    // Основной метод обновления физики. Педали аналоговые, 0..1 (вне диапазона
+    // обрезаются): газ - доля момента ДВС и отдачи MGU-K, тормоз - цель, к которой
+    // идет тормозной фактор. bool по-прежнему подходит: true - педаль в пол.
+    void update(double dt, double throttle, double brake, double steering = 0.0);
+    
+    // update() с замером стадий в profile: тот же расчет бит в бит плюс
+    // чтение счетчика тактов между стадиями (для бенчмарков, не для гонки)
+    void updateProfiled(double dt, double throttle, double brake, double steering, StageProfile& profile);
+    
+    // Счетчик профиля стадий: такты процессора (TSC на x86), иначе наносекунды
+    static std::uint64_t stageClock();
+    static const char* stageName(int stage);
     
     // Управление передачами
     void shiftUp();
     void shiftDown();
     
+    // Карта отдачи ERS для трассы (должна жить дольше движка)
+    void setDeploymentMap(const ErsDeploymentMap* map) { deployment_map = map; }
+    
+    // Аэрокарта машины (должна жить дольше движка); nullptr - без карты
+    void setAeroMap(const AeroMap* map) { aero_map = map; }
+    
+    // DRS: действует только с картой (у постоянных коэффициентов нет таблицы DRS)
+    void setDrs(bool open) { drs_open = open; }
+    bool isDrsOpen() const { return drs_open; }
+    
+    // Пит-стоп и стратегия
+    void setFuelLoad(double fuel_kg);
+    void changeTires();
+    
+    // Гонка: место на стартовой решетке (отрицательное - позади линии старта)
+    void setStartPosition(double position);
+    
+    // Машина заперта позади соперника: не дальше max_position и не быстрее max_velocity
+    void holdBehind(double max_position, double max_velocity);
+    
+    // Влияние машины впереди на аэродинамику (1.0 - чистый воздух)
+    void setAeroInteraction(double drag_factor, double downforce_factor) {
+        slipstream_drag_factor = drag_factor;
+        dirty_air_downforce_factor = downforce_factor;
+    }
+    
+    // Сохранять разбивку сил каждого шага (нужно только для отображения и телеметрии)
+    void enableForceBreakdown(bool enable) { record_forces = enable; }
+    
     // === ГЕТТЕРЫ для отрисовки ===
     const CarState& getState() const { return current_state; }
+    const SlowState& getSlowState() const { return slow_state; }
+    const CarParameters& getParameters() const { return params; }
+    const ForceBreakdown& getForces() const { return last_forces; }
+    double getBatterySOC() const { return current_state.battery_energy / params.ers.battery_capacity; }
+    double getSlipstreamDragFactor() const { return slipstream_drag_factor; }
+    
+    // Производные величины - считаются при запросе
+    double getSpeed() const;
+    double getWheelRPM() const;
+    double getRideHeight() const;       // Клиренс под прижимом прошлого шага [м]
+    double getAeroBalance() const;      // Доля прижима на передней оси (без карты - 0.5)
+    std::array<Point2D, 4> getWheelPositions() const;   // 0=FL, 1=FR, 2=RL, 3=RR
 
 private:
-    // === ПРИВАТНЫЕ МЕТОДЫ РАСЧЕТА ===
-    
-    // Двигатель и трансмиссия
-    void calculateEnginePhysics(bool gas_pedal, double dt);
-    void calculateRPM(bool gas_pedal, double dt);
-    void calculateTorque();
-    void calculateWheelParameters();
-    void calculateBrakeFactor(bool brake_pedal, double dt);
-    void applyBrakes(double dt);
-    double sigmaFactor() const;
-    
-    // Силы
-    void calculateForces(bool gas_pedal, bool brake_pedal, double steering);
-    double calculateTractionForce() const;
-    double calculateDragForce() const;
-    double calculateDownForce() const;
-    double calculateBrakeForce() const;
-    
-    // Движение
-    void integrateMotion(double dt);
-    
-    // Геометрия
-    void calculateWheelPositions();
+    // Политика машины для общего шага f1core::step (F1_PhysicsCore.h):
+    // кэш передачи, тормоза с температурой, карты ERS и аэродинамики
+    struct StepCar {
+        F1PhysicsEngine& engine;
+        const CarParameters& p;
+        SlowState& slow;
+        
+        explicit StepCar(F1PhysicsEngine& e) : engine(e), p(e.params), slow(e.slow_state) {}
+        
+        double gearFactor(int) const { return engine.gear_factor; }
+        double inertiaMass(int) const { return engine.drivetrain_inertia_mass; }
+        double brakeForceLimit() const { return engine.brake_force_limit; }
+        double dragFactor() const { return engine.slipstream_drag_factor; }
+        double downforceFactor() const { return engine.dirty_air_downforce_factor; }
+        double deployFraction(const CarState& s) const;
+        void aeroCoefficients(const CarState& s, ForceBreakdown& f, double& drag, double& lift);
+        void brakeWork(double work) { engine.pending_brake_work += work; }
+        void travel(double distance) { engine.pending_distance += distance; }
+        void recordForces(const ForceBreakdown& f);
+        void updateBrakes(CarState& s);
+    };
+    
+    // Шаг по стадиям; Clock::mark(стадия) - после каждой (пустой у update())
+    template <typename Clock>
+    void step(double dt, double throttle, double brake, Clock& clock);
+    
+    void updateGearCache();
+    
+    // Медленные величины: масса, износ, температуры
+    void updateSlowState();
 };
 
+static_assert(sizeof(F1PhysicsEngine::CarState) <= 128, "CarState hot block must fit two cache lines");
+
 #endif // F1_PHYSICS_H
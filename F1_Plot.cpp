@@ -0,0 +1,169 @@
+#include "F1_Plot.h"
+#include <algorithm>
+#include <iomanip>
+
+// === РЯД ===
+
+PlotSeries::PlotSeries(int columns, double initial_span)
+    : buckets(std::max(2, columns)), initial_span(initial_span > 0.0 ? initial_span : 1.0), span(this->initial_span) {
+}
+
+void PlotSeries::clear() {
+    std::fill(buckets.begin(), buckets.end(), RunningMoments());
+    span = initial_span;
+    x_total = RunningMoments();
+    y_total = RunningMoments();
+}
+
+void PlotSeries::add(double x, double y) {
+    if (x_total.count == 0) {
+        origin = x;
+    }
+    x_total.add(x);
+    y_total.add(y);
+    
+    // Вне диапазона - удваиваем его: колонки 2i и 2i+1 сливаются в i
+    const int n = columns();
+    while (x - origin >= span) {
+        for (int i = 0; i < n / 2; i++) {
+            RunningMoments merged = buckets[2 * i];
+            merged.merge(buckets[2 * i + 1]);
+            buckets[i] = merged;
+        }
+        if (n % 2 != 0) {
+            buckets[n / 2] = buckets[n - 1];
+        }
+        std::fill(buckets.begin() + (n + 1) / 2, buckets.end(), RunningMoments());
+        span *= 2.0;
+    }
+    
+    int column = static_cast<int>((x - origin) / span * n);
+    buckets[std::min(n - 1, std::max(0, column))].add(y);
+}
+
+// === ХОЛСТ ===
+
+namespace {
+    // Сетка с осями и подписями: масштаб Y от min_y до max_y с запасом сверху
+    class Canvas {
+    public:
+        Canvas(int width, int height, double min_y, double max_y)
+            : width(width), height(height), grid(height, std::vector<char>(width, ' ')) {
+            // Добавляем немного места сверху
+            this->max_y = max_y * 1.1;
+            this->min_y = min_y > 0 ? 0 : min_y;
+            
+            // Рисуем оси
+            int zero_y = (int)((0 - this->min_y) / (this->max_y - this->min_y) * (height - 1));
+            zero_y = std::min(height - 1, std::max(0, zero_y));
+            
+            for (int i = 0; i < width; i++) {
+                grid[zero_y][i] = '-'; // Ось X
+            }
+            for (int i = 0; i < height; i++) {
+                grid[i][0] = '|'; // Ось Y
+            }
+            grid[zero_y][0] = '+'; // Начало координат
+        }
+        
+        int column(double x, double min_x, double max_x) const {
+            int plot_x = (int)((x - min_x) / (max_x - min_x) * (width - 1));
+            return std::min(width - 1, std::max(0, plot_x));
+        }
+        
+        // Строка сетки для y: 0 - верх
+        int row(double y) const {
+            int plot_y = (int)((y - min_y) / (max_y - min_y) * (height - 1));
+            plot_y = std::min(height - 1, std::max(0, plot_y));
+            
+            // Инвертируем Y для правильного отображения (0 внизу)
+            return height - 1 - plot_y;
+        }
+        
+        void mark(int plot_x, int plot_y) { grid[plot_y][plot_x] = '*'; }
+        
+        void print(std::ostream& out, const std::string& xlabel, const std::string& ylabel, double max_x) const {
+            // Выводим сетку
+            for (int i = 0; i < height; i++) {
+                out << " ";
+                for (int j = 0; j < width; j++) {
+                    out << grid[i][j];
+                }
+                out << "\n";
+            }
+            
+            // Подписи осей
+            out << " " << std::string(width, ' ') << "^\n";
+            out << " " << std::string(width, ' ') << "| " << ylabel << " (max: " << std::fixed << std::setprecision(1) << max_y << ")\n";
+            out << " +";
+            for (int i = 0; i < width - 1; i++) out << "-";
+            out << "> " << xlabel << " (0-" << (int)max_x << " сек)\n\n";
+        }
+    
+    private:
+        int width;
+        int height;
+        double min_y;
+        double max_y;
+        std::vector<std::vector<char>> grid;
+    };
+    
+    void printTitle(std::ostream& out, const std::string& title) {
+        out << "\n" << title << "\n";
+        out << std::string(title.length(), '=') << "\n";
+    }
+}
+
+// === ГРАФИКИ ===
+
+void plotGraph(std::ostream& out, const std::vector<double>& x, const std::vector<double>& y,
+               const std::string& title, const std::string& xlabel, const std::string& ylabel,
+               int width, int height) {
+    
+    if (x.empty() || y.empty()) return;
+    
+    // Находим min и max значения
+    double min_x = *std::min_element(x.begin(), x.end());
+    double max_x = *std::max_element(x.begin(), x.end());
+    double min_y = *std::min_element(y.begin(), y.end());
+    double max_y = *std::max_element(y.begin(), y.end());
+    
+    printTitle(out, title);
+    Canvas canvas(width, height, min_y, max_y);
+    
+    // Рисуем данные
+    for (size_t i = 0; i < x.size(); i++) {
+        canvas.mark(canvas.column(x[i], min_x, max_x), canvas.row(y[i]));
+    }
+    
+    canvas.print(out, xlabel, ylabel, max_x);
+}
+
+void plotGraph(std::ostream& out, const PlotSeries& series,
+               const std::string& title, const std::string& xlabel, const std::string& ylabel,
+               int width, int height) {
+    
+    if (series.empty()) return;
+    
+    // min/max известны без истории
+    double min_x = series.x().min;
+    double max_x = series.x().max;
+    
+    printTitle(out, title);
+    Canvas canvas(width, height, series.y().min, series.y().max);
+    
+    // Колонка ряда - черта от min до max ее точек
+    for (int c = 0; c < series.columns(); c++) {
+        const RunningMoments& column = series.column(c);
+        if (column.count == 0) {
+            continue;
+        }
+        double x = std::min(std::max(series.columnX(c), min_x), max_x);
+        int plot_x = canvas.column(x, min_x, max_x);
+        for (int plot_y = canvas.row(column.max); plot_y <= canvas.row(column.min); plot_y++) {
+            canvas.mark(plot_x, plot_y);
+        }
+    }
+    
+    canvas.print(out, xlabel, ylabel, max_x);
+}
@@ -0,0 +1,48 @@
+#ifndef F1_PLOT_H
+#define F1_PLOT_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "F1_StreamStats.h"
+
+// Ряд для графика в постоянной памяти: columns колонок по X, в каждой -
+// потоковые min/max/среднее Y попавших в нее точек. X растет от первой точки;
+// вышла за диапазон - диапазон удваивается, соседние колонки сливаются.
+// Заезд любой длины занимает одинаково памяти, а график сохраняет пики
+// (колонка рисуется от min до max). После удвоения заполнена половина колонок
+// и больше, поэтому колонок берется вдвое больше ширины графика.
+class PlotSeries {
+public:
+    explicit PlotSeries(int columns = 120, double initial_span = 1.0);
+    
+    void add(double x, double y);
+    void clear();
+    
+    bool empty() const { return y_total.count == 0; }
+    int columns() const { return static_cast<int>(buckets.size()); }
+    const RunningMoments& column(int i) const { return buckets[i]; }
+    double columnX(int i) const { return origin + (i + 0.5) * span / columns(); }   // Середина колонки
+    const RunningMoments& x() const { return x_total; }
+    const RunningMoments& y() const { return y_total; }
+
+private:
+    std::vector<RunningMoments> buckets;
+    double initial_span;
+    double origin = 0.0;
+    double span;                        // Колонки покрывают [origin, origin + span)
+    RunningMoments x_total;
+    RunningMoments y_total;
+};
+
+// ASCII-график y(x) в out: сетка width x height, ось X на нуле, подписи осей
+void plotGraph(std::ostream& out, const std::vector<double>& x, const std::vector<double>& y,
+               const std::string& title, const std::string& xlabel, const std::string& ylabel,
+               int width = 60, int height = 20);
+
+// То же по ряду: каждая колонка - вертикальная черта от min до max Y
+void plotGraph(std::ostream& out, const PlotSeries& series,
+               const std::string& title, const std::string& xlabel, const std::string& ylabel,
+               int width = 60, int height = 20);
+
+#endif // F1_PLOT_H
@@ -0,0 +1,164 @@
+#include "F1_Race.h"
+#include <cassert>
+#include <cmath>
+
+F1Race::F1Race(int car_count, const RaceParameters& race_params, const F1PhysicsEngine::CarParameters& car_params)
+    : race_params(race_params),
+      aero_map(AeroMap::groundEffectCar(car_params.drag_coefficient, car_params.downforce_coefficient)),
+      cars(car_count, F1PhysicsEngine(car_params)),
+      order(car_count),
+      distance(car_count),
+      gap_ahead(car_count) {
+    for (F1PhysicsEngine& car : cars) {
+        car.setAeroMap(&aero_map);
+    }
+    reset();
+}
+
+void F1Race::setDeploymentMap(const ErsDeploymentMap* map) {
+    for (F1PhysicsEngine& car : cars) {
+        car.setDeploymentMap(map);
+    }
+}
+
+void F1Race::reset() {
+    for (int i = 0; i < carCount(); i++) {
+        cars[i].reset();
+        cars[i].setStartPosition(-i * race_params.grid_spacing);
+        order[i] = i;
+        distance[i] = cars[i].getState().position.x;
+    }
+    overtakes = 0;
+    
+    // Лидер едет в чистом воздухе, остальные - через grid_spacing друг за другом
+    gap_ahead[order[0]] = 0.0;
+    for (int k = 1; k < carCount(); k++) {
+        gap_ahead[order[k]] = distance[order[k - 1]] - distance[order[k]];
+    }
+}
+
+void F1Race::step(double dt, const std::vector<CarControl>& controls) {
+    assert(static_cast<int>(controls.size()) == carCount());
+    
+    // 1. Слипстрим и грязный воздух по дистанциям прошлого шага
+    applyAeroInteractions();
+    
+    // 2. Физика машин
+    for (int i = 0; i < carCount(); i++) {
+        cars[i].update(dt, controls[i].throttle, controls[i].brake);
+        distance[i] = cars[i].getState().position.x;
+    }
+    
+    // 3. Без запаса скорости обогнать нельзя - машина остается позади
+    resolveBlocking();
+    
+    // 4. Новый порядок и отставания
+    updateOrder();
+}
+
+void F1Race::applyAeroInteractions() {
+    double inv_slipstream_range = 1.0 / race_params.slipstream_range;
+    double inv_dirty_air_range = 1.0 / race_params.dirty_air_range;
+    
+    // Лидер едет за последней машиной через линию старта: отставание по кругу
+    double track_length = cars[0].getParameters().track_length;
+    double leader_gap = std::fmod(distance[order.back()] - distance[order[0]], track_length);
+    if (leader_gap < 0.0) {
+        leader_gap += track_length;
+    }
+    
+    for (int k = 0; k < carCount(); k++) {
+        int index = order[k];
+        double drag_factor = 1.0;
+        double downforce_factor = 1.0;
+        bool drs = false;
+        
+        // Линейное затухание эффекта с расстоянием до машины впереди.
+        // Одна машина едет в чистом воздухе - впереди нее никого
+        if (carCount() > 1) {
+            double gap = k > 0 ? gap_ahead[index] : leader_gap;
+            if (gap < race_params.slipstream_range) {
+                drag_factor -= race_params.slipstream_max_drag_reduction * (1.0 - gap * inv_slipstream_range);
+            }
+            if (gap < race_params.dirty_air_range) {
+                downforce_factor -= race_params.dirty_air_max_downforce_loss * (1.0 - gap * inv_dirty_air_range);
+            }
+            drs = gap < race_params.drs_range
+                  && !(track && track->inCorner(cars[index].getState().lap_distance));
+        }
+        
+        cars[index].setAeroInteraction(drag_factor, downforce_factor);
+        cars[index].setDrs(drs);
+    }
+}
+
+void F1Race::resolveBlocking() {
+    // Идем от лидера, чтобы ограничения передавались по цепочке назад
+    for (int k = 1; k < carCount(); k++) {
+        int ahead = order[k - 1];
+        int follower = order[k];
+        double limit = distance[ahead] - race_params.min_gap;
+        if (distance[follower] <= limit) {
+            continue;
+        }
+        
+        double ahead_velocity = cars[ahead].getState().velocity.x;
+        double closing_speed = cars[follower].getState().velocity.x - ahead_velocity;
+        if (closing_speed < race_params.overtake_min_closing_speed) {
+            cars[follower].holdBehind(limit, ahead_velocity);
+            distance[follower] = cars[follower].getState().position.x;
+        }
+    }
+}
+
+void F1Race::updateOrder() {
+    // Сортировка вставками почти отсортированного массива: каждая перестановка - обгон
+    for (int k = 1; k < carCount(); k++) {
+        int index = order[k];
+        double key = distance[index];
+        int j = k - 1;
+        while (j >= 0 && distance[order[j]] < key) {
+            order[j + 1] = order[j];
+            j--;
+            overtakes++;
+        }
+        order[j + 1] = index;
+    }
+    
+    gap_ahead[order[0]] = 0.0;
+    for (int k = 1; k < carCount(); k++) {
+        gap_ahead[order[k]] = distance[order[k - 1]] - distance[order[k]];
+    }
+}
+
+// === АВТОПИЛОТЫ ===
+
+RaceDrivers::RaceDrivers(const Track& track, const F1PhysicsEngine::CarParameters& car, int car_count)
+    : profiles(car_count), states(car_count) {
+    for (int i = 0; i < car_count; i++) {
+        SpeedProfileConfig config;
+        double boldness = car_count > 1 ? static_cast<double>(i) / (car_count - 1) : 0.0;
+        config.corner_margin = 0.88 + 0.09 * boldness;
+        profiles[i] = SpeedProfile::fromTrack(track, car, config);
+    }
+    // Пилоты держат указатели на профили - после того, как вектор профилей заполнен
+    drivers.reserve(car_count);
+    for (const SpeedProfile& profile : profiles) {
+        drivers.emplace_back(profile);
+    }
+}
+
+void RaceDrivers::control(F1Race& race, double dt, std::vector<F1Race::CarControl>& controls) {
+    controls.resize(race.carCount());
+    for (int i = 0; i < race.carCount(); i++) {
+        F1PhysicsEngine& car = race.car(i);
+        DriverCommand command = drivers[i].control(car, states[i], dt);
+        if (command.shift > 0) {
+            car.shiftUp();
+        } else if (command.shift < 0) {
+            car.shiftDown();
+        }
+        controls[i].throttle = command.throttle;
+        controls[i].brake = command.brake;
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef F1_RACE_H
+#define F1_RACE_H
+
+#include <vector>
+#include "F1_Driver.h"
+#include "F1_Physics_build_2.h"
+
+// Параметры взаимодействия машин на трассе
+struct RaceParameters {
+    double grid_spacing = 8.0;                  // Расстояние между машинами на старте [м]
+    double slipstream_range = 60.0;             // Дистанция, на которой работает слипстрим [м]
+    double slipstream_max_drag_reduction = 0.3; // Снижение сопротивления вплотную за машиной
+    double dirty_air_range = 40.0;              // Дистанция потери прижимной силы [м]
+    double dirty_air_max_downforce_loss = 0.35; // Потеря прижимной силы вплотную за машиной
+    double min_gap = 6.0;                       // Минимальная дистанция до машины впереди [м]
+    double overtake_min_closing_speed = 3.0;    // Разница скоростей для обгона [м/с]
+    double drs_range = 80.0;                    // DRS открыт ближе этой дистанции до машины впереди (вне поворотов) [м]
+};
+
+// Гоночный слой: много движков F1PhysicsEngine на одной трассе.
+// Порядок машин хранится отсортированным по дистанции и обновляется
+// вставками каждый шаг - за шаг почти ничего не меняется, поэтому это O(N).
+// Трасса кольцевая: впереди лидера по асфальту - последняя машина, поэтому
+// слипстрим, грязный воздух и DRS у лидера - от нее, через линию старта.
+// У машин общая аэрокарта граунд-эффекта (без нее DRS не на что действовать);
+// гонка владеет картой, поэтому не копируется.
+class F1Race {
+public:
+    // Управление одной машиной на шаг: педали 0..1
+    struct CarControl {
+        double throttle = 0.0;
+        double brake = 0.0;
+    };
+    
+    explicit F1Race(int car_count, const RaceParameters& race_params = RaceParameters(),
+                    const F1PhysicsEngine::CarParameters& car_params = F1PhysicsEngine::CarParameters());
+    F1Race(const F1Race&) = delete;
+    F1Race& operator=(const F1Race&) = delete;
+    
+    // Карта отдачи ERS для всех машин (должна жить дольше гонки)
+    void setDeploymentMap(const ErsDeploymentMap* map);
+    
+    // Трасса для зон DRS (должна жить дольше гонки): в поворотах DRS закрыт.
+    // Без трассы повороты неизвестны - DRS открывается по дистанции где угодно
+    void setTrack(const Track* track) { this->track = track; }
+    
+    // Расставляет машины по стартовой решетке
+    void reset();
+    
+    // Шаг гонки: аэродинамика от соседей -> физика каждой машины -> блокировки -> порядок.
+    // controls - по машине на индекс, ровно carCount()
+    void step(double dt, const std::vector<CarControl>& controls);
+    
+    // === ГЕТТЕРЫ ===
+    int carCount() const { return static_cast<int>(cars.size()); }
+    F1PhysicsEngine& car(int index) { return cars[index]; }
+    const F1PhysicsEngine& car(int index) const { return cars[index]; }
+    
+    // Индексы машин от лидера к последнему
+    const std::vector<int>& classification() const { return order; }
+    
+    // Отставание от машины впереди по трассе [м] (у лидера - 0)
+    double gapAhead(int car_index) const { return gap_ahead[car_index]; }
+    
+    // Число смен позиций с начала гонки
+    int overtakeCount() const { return overtakes; }
+
+private:
+    void applyAeroInteractions();
+    void resolveBlocking();
+    void updateOrder();
+    
+    RaceParameters race_params;
+    AeroMap aero_map;
+    const Track* track = nullptr;
+    std::vector<F1PhysicsEngine> cars;
+    std::vector<int> order;          // Индексы машин, лидер первый
+    std::vector<double> distance;    // Дистанция машин (по индексу машины), копия для сортировки
+    std::vector<double> gap_ahead;   // По индексу машины
+    int overtakes = 0;
+};
+
+// Автопилоты гонки: у каждой машины свой профиль скорости - запас в
+// поворотах от осторожного на поул-позиции до самого смелого в хвосте
+// решетки, чтобы быстрые машины догоняли медленные и обгоняли
+class RaceDrivers {
+public:
+    RaceDrivers(const Track& track, const F1PhysicsEngine::CarParameters& car, int car_count);
+    RaceDrivers(const RaceDrivers&) = delete;               // Пилоты указывают на свои профили
+    RaceDrivers& operator=(const RaceDrivers&) = delete;
+    
+    // Команды всех машин на шаг; переключения передач - сразу в машины гонки
+    void control(F1Race& race, double dt, std::vector<F1Race::CarControl>& controls);
+    
+    const SpeedProfile& profile(int car_index) const { return profiles[car_index]; }
+
+private:
+    std::vector<SpeedProfile> profiles;
+    std::vector<SpeedProfileDriver> drivers;
+    std::vector<DriverState> states;
+};
+
+#endif // F1_RACE_H
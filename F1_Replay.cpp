@@ -0,0 +1,117 @@
+#include "F1_Replay.h"
+#include <algorithm>
+#include <cmath>
+
+bool TelemetryReplay::open(const std::string& path) {
+    close();
+    if (!telemetry.open(path) || telemetry.sampleCount() == 0) {
+        telemetry.close();
+        return false;
+    }
+    
+    const std::vector<TelemetryLogBlock>& blocks = telemetry.blocks();
+    start_time = blocks.front().first_timestamp;
+    end_time = blocks.back().last_timestamp;
+    step_channels.assign(telemetry.channelNames().size(), 0);
+    for (const char* name : {"lap", "gear"}) {
+        int channel = telemetry.channelIndex(name);
+        if (channel >= 0) {
+            step_channels[channel] = 1;
+        }
+    }
+    lap_distance_channel = telemetry.trackLength() > 0.0 ? telemetry.channelIndex("lap_distance") : -1;
+    return true;
+}
+
+void TelemetryReplay::close() {
+    telemetry.close();
+    for (CachedBlock& slot : cache) {
+        slot = CachedBlock();
+    }
+    start_time = 0;
+    end_time = 0;
+    step_channels.clear();
+    lap_distance_channel = -1;
+    uses = 0;
+    decodes = 0;
+}
+
+void TelemetryReplay::setStepChannel(int channel, bool step) {
+    if (channel >= 0 && channel < channelCount()) {
+        step_channels[channel] = step ? 1 : 0;
+    }
+}
+
+const TelemetryColumns* TelemetryReplay::load(std::size_t block) {
+    uses++;
+    for (CachedBlock& slot : cache) {
+        if (slot.block == block) {
+            slot.last_use = uses;
+            return &slot.columns;
+        }
+    }
+    
+    CachedBlock& slot = cache[0].last_use <= cache[1].last_use ? cache[0] : cache[1];
+    slot.block = static_cast<std::size_t>(-1);
+    if (!telemetry.decodeBlock(block, slot.columns) || slot.columns.size() == 0) {
+        return nullptr;
+    }
+    decodes++;
+    slot.block = block;
+    slot.last_use = uses;
+    return &slot.columns;
+}
+
+bool TelemetryReplay::sample(std::int64_t timestamp, double* values) {
+    if (telemetry.blocks().empty()) {
+        return false;
+    }
+    timestamp = std::min(std::max(timestamp, start_time), end_time);
+    
+    // Отсчет не позже timestamp: блок по индексу, внутри - бинарный поиск
+    std::size_t block = telemetry.findBlock(timestamp);
+    const TelemetryColumns* before = load(block);
+    if (before == nullptr) {
+        return false;
+    }
+    const std::vector<std::int64_t>& times = before->timestamps;
+    std::size_t i = std::upper_bound(times.begin(), times.end(), timestamp) - times.begin();
+    i = i > 0 ? i - 1 : 0;
+    
+    // Следующий отсчет - в этом блоке или первый в следующем
+    const TelemetryColumns* after = before;
+    std::size_t j = i + 1;
+    if (j >= before->size()) {
+        after = block + 1 < telemetry.blocks().size() ? load(block + 1) : nullptr;
+        j = 0;
+    }
+    
+    const int channels = channelCount();
+    if (after == nullptr || after->timestamps[j] <= times[i]) {
+        for (int c = 0; c < channels; c++) {
+            values[c] = before->channels[c][i];
+        }
+        return true;
+    }
+    
+    double fraction = static_cast<double>(timestamp - times[i]) / (after->timestamps[j] - times[i]);
+    for (int c = 0; c < channels; c++) {
+        double v0 = before->channels[c][i];
+        double v1 = after->channels[c][j];
+        if (step_channels[c]) {
+            values[c] = v0;
+            continue;
+        }
+        if (c == lap_distance_channel) {
+            // Через линию старта: 4990 -> 5 м - это 15 м вперед, а не 4985 назад
+            double length = telemetry.trackLength();
+            if (v1 < v0 - 0.5 * length) {
+                v1 += length;
+            }
+            values[c] = std::fmod(v0 + (v1 - v0) * fraction, length);
+            continue;
+        }
+        values[c] = v0 + (v1 - v0) * fraction;
+    }
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef F1_REPLAY_H
+#define F1_REPLAY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "F1_TelemetryLog.h"
+
+// Воспроизведение лога телеметрии: значения каналов на любой момент времени,
+// без пересчета физики. Между записанными отсчетами - линейная интерполяция;
+// ступенчатые каналы (круг, передача) берутся с предыдущего отсчета, а
+// дистанция круга интерполируется через линию старта, а не назад по кругу.
+//
+// Поиск - по индексу блоков лога (по записи на блок, O(log блоков)) и
+// бинарным поиском внутри блока. Декодированы не больше двух блоков (на
+// стыке нужны оба), файл читается через mmap: память не растет с длиной лога.
+class TelemetryReplay {
+public:
+    bool open(const std::string& path);     // false - нет файла, он не лог или в нем нет отсчетов
+    void close();
+    
+    const TelemetryLog& log() const { return telemetry; }
+    int channelCount() const { return static_cast<int>(telemetry.channelNames().size()); }
+    std::int64_t startTime() const { return start_time; }      // [нс]
+    std::int64_t endTime() const { return end_time; }
+    
+    // Канал без интерполяции (по умолчанию - "lap" и "gear")
+    void setStepChannel(int channel, bool step);
+    
+    // Значения на момент timestamp (зажимается в границы лога), channelCount()
+    // значений в values. false - блок лога испорчен
+    bool sample(std::int64_t timestamp, double* values);
+    
+    std::uint64_t blockDecodes() const { return decodes; }     // Сколько раз блок декодировался
+
+private:
+    struct CachedBlock {
+        std::size_t block = static_cast<std::size_t>(-1);
+        std::uint64_t last_use = 0;
+        TelemetryColumns columns;
+    };
+    
+    // Блок из кэша; вытесняется давнее использованный из двух
+    const TelemetryColumns* load(std::size_t block);
+    
+    TelemetryLog telemetry;
+    std::int64_t start_time = 0;
+    std::int64_t end_time = 0;
+    std::vector<char> step_channels;
+    int lap_distance_channel = -1;
+    std::array<CachedBlock, 2> cache;
+    std::uint64_t uses = 0;
+    std::uint64_t decodes = 0;
+};
+
+#endif // F1_REPLAY_H
@@ -0,0 +1,37 @@
+#include "F1_Scenario.h"
+
+ScenarioContext::ScenarioContext(MonotonicArena& arena, const F1PhysicsEngine::CarParameters& params,
+                                 const ScenarioConfig& config)
+    : config(config) {
+    engine = arena.create<F1PhysicsEngine>(params);
+    script = arena.createArray<ScenarioInput>(config.steps);
+    sample_capacity = config.telemetry_every > 0 ? config.steps / config.telemetry_every : 0;
+    samples = arena.createArray<ScenarioSample>(sample_capacity);
+}
+
+void ScenarioContext::run() {
+    sample_count = 0;
+    std::size_t until_sample = config.telemetry_every;
+    for (std::size_t i = 0; i < config.steps; i++) {
+        engine->update(config.dt, script[i].throttle, script[i].brake);
+        
+        const F1PhysicsEngine::CarState& s = engine->getState();
+        if (s.engine_rpm > config.upshift_rpm) {
+            engine->shiftUp();
+        } else if (s.clutch_locked && s.engine_rpm < config.downshift_rpm && s.current_gear > 1) {
+            engine->shiftDown();
+        }
+        
+        if (--until_sample == 0 && sample_count < sample_capacity) {
+            ScenarioSample& sample = samples[sample_count++];
+            sample.time = s.time;
+            sample.lap_distance = s.lap_distance;
+            sample.velocity = s.velocity.x;
+            sample.engine_rpm = s.engine_rpm;
+            sample.battery_energy = s.battery_energy;
+            sample.lap = s.lap;
+            sample.gear = s.current_gear;
+            until_sample = config.telemetry_every;
+        }
+    }
+}
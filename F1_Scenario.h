@@ -0,0 +1,68 @@
+#ifndef F1_SCENARIO_H
+#define F1_SCENARIO_H
+
+#include <cstddef>
+#include <cstdint>
+#include "F1_Arena.h"
+#include "F1_Physics_build_2.h"
+
+// Прогон сценария в арене: движок, скрипт педалей и буфер телеметрии
+// выделяются из одной арены потока и освобождаются ее reset() разом.
+// Для разверток на миллионы коротких прогонов: после первого прогона арена
+// уже держит нужные блоки, и ни создание контекста, ни шаг к куче не
+// обращаются.
+
+// Педали на один шаг
+struct ScenarioInput {
+    float throttle = 0.0f;              // 0..1
+    float brake = 0.0f;                 // 0..1
+};
+
+// Отсчет телеметрии прогона
+struct ScenarioSample {
+    double time = 0.0;                  // [с]
+    double lap_distance = 0.0;          // [м]
+    double velocity = 0.0;              // [м/с]
+    double engine_rpm = 0.0;
+    double battery_energy = 0.0;        // [Дж]
+    std::int32_t lap = 0;
+    std::int16_t gear = 0;
+};
+
+struct ScenarioConfig {
+    double dt = 0.01;                   // Шаг физики [с]
+    std::size_t steps = 1000;           // Длина скрипта педалей
+    std::size_t telemetry_every = 10;   // Отсчет раз в столько шагов (0 - без телеметрии)
+    double upshift_rpm = 13500.0;       // Переключения по оборотам, как у пилотов
+    double downshift_rpm = 8000.0;
+};
+
+class ScenarioContext {
+public:
+    // Все буферы - из arena; контекст действителен до arena.reset()
+    ScenarioContext(MonotonicArena& arena, const F1PhysicsEngine::CarParameters& params,
+                    const ScenarioConfig& config = ScenarioConfig());
+    
+    // Скрипт педалей: config.steps шагов, заполняет вызывающий (по умолчанию - нули)
+    ScenarioInput* inputs() { return script; }
+    std::size_t inputCount() const { return config.steps; }
+    
+    // Прогоняет скрипт: шаг движка, переключение, отсчет каждые telemetry_every шагов
+    void run();
+    
+    F1PhysicsEngine& car() { return *engine; }
+    const F1PhysicsEngine& car() const { return *engine; }
+    
+    const ScenarioSample* telemetry() const { return samples; }
+    std::size_t telemetryCount() const { return sample_count; }
+
+private:
+    F1PhysicsEngine* engine;
+    ScenarioInput* script;
+    ScenarioSample* samples;
+    std::size_t sample_capacity;
+    std::size_t sample_count = 0;
+    ScenarioConfig config;
+};
+
+#endif // F1_SCENARIO_H
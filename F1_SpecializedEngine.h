@@ -0,0 +1,172 @@
+#ifndef F1_SPECIALIZED_ENGINE_H
+#define F1_SPECIALIZED_ENGINE_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include "F1_Physics_build_2.h"
+#include "F1_PhysicsCore.h"
+
+// Движок для фиксированной (омологированной) машины.
+// Config задает параметры на этапе компиляции:
+//
+//     struct MyCar {
+//         static constexpr F1PhysicsEngine::CarParameters params = makeMyCarParameters();
+//     };
+//     F1SpecializedEngine<MyCar> engine;
+//
+// Шаг - тот же f1core::step, что у F1PhysicsEngine::update (F1_PhysicsCore.h),
+// но параметры - константы: компилятор сворачивает 0.5·ρ·Cd·A и другие
+// произведения параметров, берет передаточные числа и приведенную инерцию
+// из таблиц по передачам и выбрасывает аэрокарту, слипстрим и температуры.
+// Порядок операций общий, поэтому траектории совпадают с рантайм-движком бит в бит.
+template <typename Config>
+class F1SpecializedEngine {
+public:
+    using CarState = F1PhysicsEngine::CarState;
+    using SlowState = F1PhysicsEngine::SlowState;
+    using ForceBreakdown = F1PhysicsEngine::ForceBreakdown;
+    using CarParameters = F1PhysicsEngine::CarParameters;
+    using Point = F1PhysicsEngine::Point2D;
+    
+    static constexpr const CarParameters& params = Config::params;
+    static constexpr int gear_count = params.gear_count;
+    static_assert(gear_count >= 1 && gear_count <= static_cast<int>(params.gear_ratios.size()),
+                  "gear_count must fit gear_ratios");
+    static_assert(!params.thermal.enabled, "thermal model is only in F1PhysicsEngine and F1Fleet");
+    
+    F1SpecializedEngine() { reset(); }
+    
+    void reset() {
+        current_state = CarState();
+        current_state.current_gear = 1;
+        current_state.engine_rpm = params.null_rpm;
+        current_state.battery_energy = params.ers.battery_initial_energy;
+        slow_state = SlowState();
+        slow_state.fuel_mass = params.fuel_initial_mass;
+        last_forces = ForceBreakdown();
+        updateSlowState();
+    }
+    
+    // Педали аналоговые, 0..1 - как у F1PhysicsEngine::update
+    void update(double dt, double throttle, double brake, double steering = 0.0) {
+        StepCar car{*this};
+        ForceBreakdown forces;
+        f1core::NoStageClock clock;
+        f1core::step(car, current_state, forces, throttle, brake, dt, clock);
+        (void)steering;
+    }
+    
+    void shiftUp() {
+        if (current_state.current_gear < gear_count) {
+            current_state.current_gear++;
+            if (current_state.clutch_locked) {
+                current_state.engine_rpm = getWheelRPM() * gear_factors[current_state.current_gear - 1];
+            }
+        }
+    }
+    
+    void shiftDown() {
+        if (current_state.current_gear > 1) {
+            double new_gear_factor = gear_factors[current_state.current_gear - 2];
+            double wheel_rpm = getWheelRPM();
+            if (wheel_rpm * new_gear_factor <= params.max_rpm) {
+                current_state.current_gear--;
+                if (current_state.clutch_locked) {
+                    current_state.engine_rpm = wheel_rpm * new_gear_factor;
+                }
+            }
+        }
+    }
+    
+    void setDeploymentMap(const ErsDeploymentMap* map) { deployment_map = map; }
+    void enableForceBreakdown(bool enable) { record_forces = enable; }
+    
+    const CarState& getState() const { return current_state; }
+    const SlowState& getSlowState() const { return slow_state; }
+    const CarParameters& getParameters() const { return params; }
+    const ForceBreakdown& getForces() const { return last_forces; }
+    
+    // Производные величины (движение одномерное, velocity.x >= 0)
+    double getSpeed() const { return current_state.velocity.x; }
+    double getWheelRPM() const { return f1core::wheelRpm(params, current_state); }
+    
+    std::array<Point, 4> getWheelPositions() const {
+        constexpr double half_wheelbase = params.wheelbase / 2.0;
+        constexpr double half_track = params.track_width / 2.0;
+        const Point& p = current_state.position;
+        return {{
+            { p.x + half_wheelbase, p.y + half_track },
+            { p.x + half_wheelbase, p.y - half_track },
+            { p.x - half_wheelbase, p.y + half_track },
+            { p.x - half_wheelbase, p.y - half_track }
+        }};
+    }
+
+private:
+    // === ТАБЛИЦЫ, ПОСЧИТАННЫЕ КОМПИЛЯТОРОМ ===
+    
+    struct GearTables {
+        std::array<double, 8> gear_factor{};      // i_передачи · i_главной
+        std::array<double, 8> ratio_per_radius{};  // i / r
+        std::array<double, 8> inertia_mass{};     // I·(i/r)²
+    };
+    
+    static constexpr GearTables makeGearTables() {
+        GearTables t{};
+        for (int g = 0; g < gear_count; g++) {
+            t.gear_factor[g] = params.gear_ratios[g] * params.final_drive;
+            t.ratio_per_radius[g] = t.gear_factor[g] / params.wheel_radius;
+            t.inertia_mass[g] = params.engine_inertia * t.ratio_per_radius[g] * t.ratio_per_radius[g];
+        }
+        return t;
+    }
+    
+    static constexpr GearTables gear_tables = makeGearTables();
+    static constexpr const std::array<double, 8>& gear_factors = gear_tables.gear_factor;
+    
+    // Политика машины для f1core::step: таблицы по передачам, чистый воздух,
+    // постоянные коэффициенты и тормоза без температуры
+    struct StepCar {
+        F1SpecializedEngine& engine;
+        static constexpr const CarParameters& p = params;
+        SlowState& slow = engine.slow_state;
+        
+        static constexpr double gearFactor(int gear) { return gear_tables.gear_factor[gear]; }
+        static constexpr double inertiaMass(int gear) { return gear_tables.inertia_mass[gear]; }
+        static constexpr double brakeForceLimit() { return params.max_brake_force; }
+        static constexpr double dragFactor() { return 1.0; }
+        static constexpr double downforceFactor() { return 1.0; }
+        
+        double deployFraction(const CarState& s) const {
+            return engine.deployment_map ? engine.deployment_map->deployFraction(s.lap_distance) : 1.0;
+        }
+        void aeroCoefficients(const CarState&, ForceBreakdown&, double&, double&) const {}
+        void brakeWork(double) const {}
+        void travel(double) const {}
+        void recordForces(const ForceBreakdown& f) const {
+            if (engine.record_forces) {
+                engine.last_forces = f;
+            }
+        }
+        void updateBrakes(CarState&) const {}
+    };
+    
+    void updateSlowState() {
+        StepCar car{*this};
+        f1core::slowStage(car, current_state);
+    }
+    
+    CarState current_state;
+    SlowState slow_state;
+    ForceBreakdown last_forces;
+    bool record_forces = false;
+    const ErsDeploymentMap* deployment_map = nullptr;
+};
+
+// Конфигурация с параметрами по умолчанию (как у F1PhysicsEngine())
+struct DefaultCarConfig {
+    static constexpr F1PhysicsEngine::CarParameters params{};
+};
+
+#endif // F1_SPECIALIZED_ENGINE_H
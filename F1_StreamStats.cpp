@@ -0,0 +1,257 @@
+#include "F1_StreamStats.h"
+#include <algorithm>
+#include <cmath>
+
+// === МОМЕНТЫ ===
+
+void RunningMoments::add(double value) {
+    if (std::isnan(value)) {
+        return;
+    }
+    count++;
+    double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+    min = std::min(min, value);
+    max = std::max(max, value);
+}
+
+void RunningMoments::merge(const RunningMoments& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    
+    std::uint64_t total = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / total;
+    m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / total);
+    count = total;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+double RunningMoments::stddev() const {
+    return std::sqrt(variance());
+}
+
+// === КВАНТИЛИ ===
+
+QuantileSketch::QuantileSketch(double relative_accuracy, int max_buckets)
+    : accuracy(relative_accuracy),
+      gamma((1.0 + relative_accuracy) / (1.0 - relative_accuracy)),
+      inv_log_gamma(1.0 / std::log(gamma)),
+      max_buckets(std::max(1, max_buckets)) {
+}
+
+int QuantileSketch::bucketIndex(double magnitude) const {
+    return static_cast<int>(std::ceil(std::log(magnitude) * inv_log_gamma));
+}
+
+double QuantileSketch::bucketValue(int index) const {
+    // Середина корзины (γ^(i-1), γ^i] по относительной ошибке
+    return 2.0 * std::pow(gamma, index) / (gamma + 1.0);
+}
+
+void QuantileSketch::Store::cover(int low, int high, int max_buckets) {
+    // Шире max_buckets - нижние корзины сливаются в самую нижнюю оставшуюся
+    low = std::max(low, high - max_buckets + 1);
+    int old_high = offset + static_cast<int>(counts.size()) - 1;
+    if (!counts.empty() && low == offset && high == old_high) {
+        return;
+    }
+    std::vector<std::uint64_t> covered(high - low + 1, 0);
+    for (std::size_t i = 0; i < counts.size(); i++) {
+        int index = std::max(offset + static_cast<int>(i), low);
+        covered[index - low] += counts[i];
+    }
+    counts.swap(covered);
+    offset = low;
+}
+
+void QuantileSketch::Store::add(int index, std::uint64_t n, int max_buckets) {
+    if (counts.empty()) {
+        counts.assign(1, 0);
+        offset = index;
+    }
+    int high = offset + static_cast<int>(counts.size()) - 1;
+    if (index < offset || index > high) {
+        cover(std::min(index, offset), std::max(index, high), max_buckets);
+    }
+    counts[std::max(index, offset) - offset] += n;
+    total += n;
+}
+
+void QuantileSketch::Store::merge(const Store& other, int max_buckets) {
+    if (other.total == 0) {
+        return;
+    }
+    int other_high = other.offset + static_cast<int>(other.counts.size()) - 1;
+    if (counts.empty()) {
+        counts.assign(1, 0);
+        offset = other.offset;
+    }
+    int high = offset + static_cast<int>(counts.size()) - 1;
+    cover(std::min(offset, other.offset), std::max(high, other_high), max_buckets);
+    for (std::size_t i = 0; i < other.counts.size(); i++) {
+        int index = std::max(other.offset + static_cast<int>(i), offset);
+        counts[index - offset] += other.counts[i];
+    }
+    total += other.total;
+}
+
+void QuantileSketch::add(double value) {
+    if (std::isnan(value)) {
+        return;
+    }
+    double magnitude = std::abs(value);
+    if (magnitude < MIN_MAGNITUDE) {
+        zero_count++;
+    } else if (value > 0) {
+        positive.add(bucketIndex(magnitude), 1, max_buckets);
+    } else {
+        negative.add(bucketIndex(magnitude), 1, max_buckets);
+    }
+}
+
+bool QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.gamma != gamma) {
+        return false;
+    }
+    positive.merge(other.positive, max_buckets);
+    negative.merge(other.negative, max_buckets);
+    zero_count += other.zero_count;
+    return true;
+}
+
+double QuantileSketch::quantile(double q) const {
+    std::uint64_t n = count();
+    if (n == 0) {
+        return 0.0;
+    }
+    
+    // Отсчет номер ceil(q·n) (с единицы) по возрастанию, как у FixedHistogram:
+    // отрицательные от больших по модулю, ноль, положительные
+    double target = std::min(std::max(q, 0.0), 1.0) * n;
+    std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(target)));
+    std::uint64_t seen = 0;
+    for (std::size_t i = negative.counts.size(); i-- > 0;) {
+        seen += negative.counts[i];
+        if (seen >= rank) {
+            return -bucketValue(negative.offset + static_cast<int>(i));
+        }
+    }
+    seen += zero_count;
+    if (seen >= rank) {
+        return 0.0;
+    }
+    for (std::size_t i = 0; i < positive.counts.size(); i++) {
+        seen += positive.counts[i];
+        if (seen >= rank) {
+            return bucketValue(positive.offset + static_cast<int>(i));
+        }
+    }
+    return positive.counts.empty() ? 0.0 : bucketValue(positive.offset + static_cast<int>(positive.counts.size()) - 1);
+}
+
+// === ГИСТОГРАММА ===
+
+FixedHistogram::FixedHistogram(double low, double high, int bins)
+    : range_low(low), range_high(high), inv_bin_width(bins / (high - low)), counts(bins + 2, 0) {
+}
+
+void FixedHistogram::add(double value) {
+    if (counts.empty() || std::isnan(value)) {
+        return;
+    }
+    int n = bins();
+    int bin;
+    if (value < range_low) {
+        bin = 0;
+    } else if (value >= range_high) {
+        bin = n + 1;
+    } else {
+        bin = 1 + std::min(n - 1, static_cast<int>((value - range_low) * inv_bin_width));
+    }
+    counts[bin]++;
+    total++;
+}
+
+bool FixedHistogram::merge(const FixedHistogram& other) {
+    if (other.counts.size() != counts.size() || other.range_low != range_low || other.range_high != range_high) {
+        return false;
+    }
+    for (std::size_t i = 0; i < counts.size(); i++) {
+        counts[i] += other.counts[i];
+    }
+    total += other.total;
+    return true;
+}
+
+bool FixedHistogram::quantile(double q, double& value) const {
+    if (total == 0) {
+        return false;
+    }
+    
+    double target = std::min(std::max(q, 0.0), 1.0) * total;
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < counts.size(); i++) {
+        if (seen + counts[i] >= target && counts[i] > 0) {
+            if (i == 0 || i == counts.size() - 1) {
+                return false;
+            }
+            // Линейная интерполяция внутри корзины
+            double fraction = (target - seen) / counts[i];
+            value = range_low + (i - 1 + fraction) * binWidth();
+            return true;
+        }
+        seen += counts[i];
+    }
+    return false;
+}
+
+// === КАНАЛ ===
+
+StreamingStats::StreamingStats(const StreamStatsConfig& config)
+    : quantiles(config.relative_accuracy, config.max_buckets) {
+    if (config.histogram_bins > 0 && config.histogram_high > config.histogram_low) {
+        bins = FixedHistogram(config.histogram_low, config.histogram_high, config.histogram_bins);
+    }
+}
+
+void StreamingStats::add(double value) {
+    moments.add(value);
+    quantiles.add(value);
+    bins.add(value);
+}
+
+bool StreamingStats::merge(const StreamingStats& other) {
+    if (other.quantiles.relativeAccuracy() != quantiles.relativeAccuracy()
+        || other.bins.bins() != bins.bins() || other.bins.low() != bins.low() || other.bins.high() != bins.high()) {
+        return false;
+    }
+    moments.merge(other.moments);
+    quantiles.merge(other.quantiles);
+    bins.merge(other.bins);
+    return true;
+}
+
+double StreamingStats::quantile(double q) const {
+    if (moments.count == 0) {
+        return 0.0;
+    }
+    if (q <= 0.0) {
+        return moments.min;
+    }
+    if (q >= 1.0) {
+        return moments.max;
+    }
+    double value = 0.0;
+    if (!bins.quantile(q, value)) {
+        value = quantiles.quantile(q);
+    }
+    return std::min(std::max(value, moments.min), moments.max);
+}
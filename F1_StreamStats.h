@@ -0,0 +1,150 @@
+#ifndef F1_STREAM_STATS_H
+#define F1_STREAM_STATS_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Потоковая статистика канала в постоянной памяти: отсчет добавляется и
+// забывается. Каждая часть сливается (merge) - потоки и машины считают свои
+// накопители, итог - их слияние, и он не зависит от порядка слияния
+// (кроме округления среднего). Отсчеты NaN пропускаются.
+
+// === МОМЕНТЫ ===
+
+// Среднее и дисперсия (Уэлфорд, слияние - формула Чана), точные min/max
+struct RunningMoments {
+    std::uint64_t count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;                    // Сумма квадратов отклонений
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    
+    void add(double value);
+    void merge(const RunningMoments& other);
+    
+    double variance() const { return count > 1 ? m2 / (count - 1) : 0.0; }     // Выборочная
+    double stddev() const;
+};
+
+// === КВАНТИЛИ ===
+
+// DDSketch: корзины с границами γ^i, γ = (1+α)/(1-α). Любой квантиль - с
+// относительной ошибкой не больше α, слияние - сумма корзин. Корзин не больше
+// max_buckets на знак: при переполнении сливаются самые малые по модулю
+// (точность теряют только они). При α = 1% 2048 корзин покрывают 17
+// порядков величины.
+class QuantileSketch {
+public:
+    explicit QuantileSketch(double relative_accuracy = 0.01, int max_buckets = 2048);
+    
+    void add(double value);
+    // false - у other другая точность (корзины не совпадают), ничего не слито
+    bool merge(const QuantileSketch& other);
+    
+    std::uint64_t count() const { return negative.total + zero_count + positive.total; }
+    double relativeAccuracy() const { return accuracy; }
+    // Отсчет с рангом q·n: номер ceil(q·n) по возрастанию (не меньше первого),
+    // q в [0, 1]; пустой - 0
+    double quantile(double q) const;
+
+private:
+    // Корзины одного знака: counts[i] - корзина offset + i
+    struct Store {
+        std::vector<std::uint64_t> counts;
+        int offset = 0;
+        std::uint64_t total = 0;
+        
+        void add(int index, std::uint64_t n, int max_buckets);
+        void merge(const Store& other, int max_buckets);
+        void cover(int low, int high, int max_buckets);
+    };
+    
+    // Модули меньше этого - в корзину нуля
+    static constexpr double MIN_MAGNITUDE = 1e-12;
+    
+    int bucketIndex(double magnitude) const;
+    double bucketValue(int index) const;
+    
+    double accuracy;
+    double gamma;
+    double inv_log_gamma;
+    int max_buckets;
+    Store positive;
+    Store negative;                     // По модулю
+    std::uint64_t zero_count = 0;
+};
+
+// === ГИСТОГРАММА ===
+
+// Равные корзины на [low, high) и по корзине на выход за края
+class FixedHistogram {
+public:
+    FixedHistogram() = default;
+    FixedHistogram(double low, double high, int bins);
+    
+    void add(double value);
+    // false - другая раскладка корзин, ничего не слито
+    bool merge(const FixedHistogram& other);
+    
+    int bins() const { return static_cast<int>(counts.size()) - 2; }
+    double low() const { return range_low; }
+    double high() const { return range_high; }
+    double binWidth() const { return bins() > 0 ? (range_high - range_low) / bins() : 0.0; }
+    std::uint64_t bin(int i) const { return counts[i + 1]; }
+    std::uint64_t underflow() const { return counts.empty() ? 0 : counts.front(); }
+    std::uint64_t overflow() const { return counts.empty() ? 0 : counts.back(); }
+    
+    // Корзина отсчета с рангом q·n, как у QuantileSketch; false - он в выходе
+    // за край (или пусто). value - интерполяция внутри корзины, точность -
+    // ширина корзины
+    bool quantile(double q, double& value) const;
+
+private:
+    double range_low = 0.0;
+    double range_high = 0.0;
+    double inv_bin_width = 0.0;
+    std::vector<std::uint64_t> counts;
+    std::uint64_t total = 0;
+};
+
+// === КАНАЛ ===
+
+struct StreamStatsConfig {
+    double relative_accuracy = 0.01;    // Квантили скетча
+    int max_buckets = 2048;             // Корзин скетча на знак
+    double histogram_low = 0.0;         // Гистограмма [low, high)
+    double histogram_high = 0.0;
+    int histogram_bins = 0;             // 0 - без гистограммы
+};
+
+// Все вместе: моменты, min/max, квантили, гистограмма. Квантиль - по
+// гистограмме, если он попал в ее диапазон (точность - ширина корзины),
+// иначе по скетчу (относительная точность)
+class StreamingStats {
+public:
+    explicit StreamingStats(const StreamStatsConfig& config = StreamStatsConfig());
+    
+    void add(double value);
+    // false - другая точность скетча или раскладка гистограммы
+    bool merge(const StreamingStats& other);
+    
+    std::uint64_t count() const { return moments.count; }
+    double mean() const { return moments.mean; }
+    double variance() const { return moments.variance(); }
+    double stddev() const { return moments.stddev(); }
+    double min() const { return moments.count > 0 ? moments.min : 0.0; }
+    double max() const { return moments.count > 0 ? moments.max : 0.0; }
+    double quantile(double q) const;
+    
+    const RunningMoments& runningMoments() const { return moments; }
+    const QuantileSketch& sketch() const { return quantiles; }
+    const FixedHistogram& histogram() const { return bins; }
+
+private:
+    RunningMoments moments;
+    QuantileSketch quantiles;
+    FixedHistogram bins;
+};
+
+#endif // F1_STREAM_STATS_H
@@ -0,0 +1,655 @@
+#include "F1_Sweep.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+    enum MessageType : std::uint32_t {
+        SWEEP_HELLO = 1,
+        SWEEP_JOB = 2,
+        SWEEP_BATCH = 3,
+        SWEEP_DONE = 4,
+        SWEEP_RESULT = 5,
+    };
+    
+    constexpr std::uint32_t PROTOCOL_VERSION = 2;
+    constexpr std::uint32_t MAX_MESSAGE = 64u << 20;                // Защита от мусора в длине кадра
+    constexpr std::uint64_t CHECKPOINT_MAGIC = 0x3150434B57535446ULL;   // "FTSWKCP1"
+    
+    // === СЕРИАЛИЗАЦИЯ ===
+    
+    struct ByteWriter {
+        std::vector<std::uint8_t> bytes;
+        
+        template <typename T>
+        void put(T value) {
+            std::size_t at = bytes.size();
+            bytes.resize(at + sizeof(T));
+            std::memcpy(bytes.data() + at, &value, sizeof(T));
+        }
+        
+        void putString(const std::string& s) {
+            put<std::uint32_t>(static_cast<std::uint32_t>(s.size()));
+            bytes.insert(bytes.end(), s.begin(), s.end());
+        }
+    };
+    
+    // Чтение с проверкой границ: после первой ошибки ok = false, дальше - нули
+    struct ByteReader {
+        const std::uint8_t* data;
+        std::size_t left;
+        bool ok = true;
+        
+        explicit ByteReader(const std::vector<std::uint8_t>& bytes) : data(bytes.data()), left(bytes.size()) {}
+        
+        template <typename T>
+        T get() {
+            T value{};
+            if (left < sizeof(T)) {
+                ok = false;
+                return value;
+            }
+            std::memcpy(&value, data, sizeof(T));
+            data += sizeof(T);
+            left -= sizeof(T);
+            return value;
+        }
+        
+        std::string getString() {
+            std::uint32_t length = get<std::uint32_t>();
+            if (left < length) {
+                ok = false;
+                return std::string();
+            }
+            std::string s(reinterpret_cast<const char*>(data), length);
+            data += length;
+            left -= length;
+            return s;
+        }
+    };
+    
+    // Задача целиком: все, что воркеру нужно кроме трассы и машины
+    std::vector<std::uint8_t> encodeJob(const MonteCarloConfig& config, const std::vector<PitStrategy>& strategies,
+                                        int batch_size) {
+        ByteWriter w;
+        w.put<std::uint64_t>(config.seed);
+        w.put<std::int32_t>(config.samples);
+        w.put<std::int32_t>(config.laps);
+        w.put<double>(config.dt);
+        w.put<double>(config.safety_car_probability);
+        w.put<std::int32_t>(config.safety_car_min_laps);
+        w.put<std::int32_t>(config.safety_car_max_laps);
+        w.put<double>(config.safety_car_speed);
+        w.put<double>(config.pit_loss);
+        w.put<double>(config.pit_loss_safety_car);
+        w.put<double>(config.tire_wear_sigma);
+        w.put<double>(config.braking_noise);
+        w.put<double>(config.pedal_noise);
+        w.put<std::int32_t>(batch_size);
+        w.put<std::uint32_t>(static_cast<std::uint32_t>(strategies.size()));
+        for (const PitStrategy& strategy : strategies) {
+            w.putString(strategy.name);
+            w.put<double>(strategy.start_fuel);
+            w.put<std::uint32_t>(static_cast<std::uint32_t>(strategy.pit_laps.size()));
+            for (int lap : strategy.pit_laps) {
+                w.put<std::int32_t>(lap);
+            }
+        }
+        return w.bytes;
+    }
+    
+    bool decodeJob(const std::vector<std::uint8_t>& bytes, MonteCarloConfig& config,
+                   std::vector<PitStrategy>& strategies) {
+        ByteReader r(bytes);
+        config.seed = r.get<std::uint64_t>();
+        config.samples = r.get<std::int32_t>();
+        config.laps = r.get<std::int32_t>();
+        config.dt = r.get<double>();
+        config.safety_car_probability = r.get<double>();
+        config.safety_car_min_laps = r.get<std::int32_t>();
+        config.safety_car_max_laps = r.get<std::int32_t>();
+        config.safety_car_speed = r.get<double>();
+        config.pit_loss = r.get<double>();
+        config.pit_loss_safety_car = r.get<double>();
+        config.tire_wear_sigma = r.get<double>();
+        config.braking_noise = r.get<double>();
+        config.pedal_noise = r.get<double>();
+        r.get<std::int32_t>();                      // batch_size - только для отпечатка
+        std::uint32_t count = r.get<std::uint32_t>();
+        strategies.clear();
+        for (std::uint32_t k = 0; k < count && r.ok; k++) {
+            PitStrategy strategy;
+            strategy.name = r.getString();
+            strategy.start_fuel = r.get<double>();
+            std::uint32_t pits = r.get<std::uint32_t>();
+            for (std::uint32_t p = 0; p < pits && r.ok; p++) {
+                strategy.pit_laps.push_back(r.get<std::int32_t>());
+            }
+            strategies.push_back(strategy);
+        }
+        return r.ok && r.left == 0;
+    }
+    
+    // FNV-1a: отпечаток задачи в контрольной точке
+    std::uint64_t fingerprint(const std::vector<std::uint8_t>& bytes) {
+        std::uint64_t hash = 0xCBF29CE484222325ULL;
+        for (std::uint8_t b : bytes) {
+            hash = (hash ^ b) * 0x100000001B3ULL;
+        }
+        return hash;
+    }
+    
+    // Пачка: первая выборка и число выборок
+    int batchCount(const MonteCarloConfig& config, int batch_size) {
+        return (config.samples + batch_size - 1) / batch_size;
+    }
+    
+    int batchSamples(const MonteCarloConfig& config, int batch_size, int batch) {
+        return std::min(batch_size, config.samples - batch * batch_size);
+    }
+    
+    // Запись выборки по стратегии: [u8 финиш][u16 кругов][f64 время гонки][f64 круги...]
+    void encodeOutcome(ByteWriter& w, const RaceOutcome& outcome, const std::vector<double>& lap_times) {
+        w.put<std::uint8_t>(outcome.finished ? 1 : 0);
+        w.put<std::uint16_t>(static_cast<std::uint16_t>(lap_times.size()));
+        w.put<double>(outcome.race_time);
+        for (double lap_time : lap_times) {
+            w.put<double>(lap_time);
+        }
+    }
+    
+    // Записи пачки в накопители - так же, как runMonteCarlo после simulateRace.
+    // Без results - только проверка: битая пачка не должна попасть в накопители наполовину
+    bool readBatch(ByteReader r, int samples, std::size_t strategies, std::vector<StrategyResult>* results) {
+        for (int i = 0; i < samples; i++) {
+            for (std::size_t k = 0; k < strategies; k++) {
+                bool finished = r.get<std::uint8_t>() != 0;
+                std::uint16_t laps = r.get<std::uint16_t>();
+                double race_time = r.get<double>();
+                for (std::uint16_t lap = 0; lap < laps && r.ok; lap++) {
+                    double lap_time = r.get<double>();
+                    if (results) {
+                        (*results)[k].lap_time.add(lap_time);
+                    }
+                }
+                if (!r.ok) {
+                    return false;
+                }
+                if (results && finished) {
+                    (*results)[k].race_time.add(race_time);
+                    (*results)[k].finished++;
+                } else if (results) {
+                    (*results)[k].dnf++;
+                }
+            }
+        }
+        return r.left == 0;
+    }
+    
+    bool applyBatch(const ByteReader& r, int samples, std::vector<StrategyResult>& results) {
+        return readBatch(r, samples, results.size(), nullptr) && readBatch(r, samples, results.size(), &results);
+    }
+    
+    // === СОКЕТЫ ===
+    
+    bool writeAll(int fd, const void* data, std::size_t size) {
+        const char* p = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t n = send(fd, p, size, MSG_NOSIGNAL);    // Оборванный сокет - ошибка, а не SIGPIPE
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            p += n;
+            size -= static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+    
+    bool readAll(int fd, void* data, std::size_t size) {
+        char* p = static_cast<char*>(data);
+        while (size > 0) {
+            ssize_t n = recv(fd, p, size, 0);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            p += n;
+            size -= static_cast<std::size_t>(n);
+        }
+        return true;
+    }
+    
+    bool sendMessage(int fd, std::uint32_t type, const std::vector<std::uint8_t>& payload) {
+        std::uint32_t header[2] = {type, static_cast<std::uint32_t>(payload.size())};
+        return writeAll(fd, header, sizeof(header)) && writeAll(fd, payload.data(), payload.size());
+    }
+    
+    // Блокирующее чтение кадра (сторона воркера)
+    bool receiveMessage(int fd, std::uint32_t& type, std::vector<std::uint8_t>& payload) {
+        std::uint32_t header[2];
+        if (!readAll(fd, header, sizeof(header)) || header[1] > MAX_MESSAGE) {
+            return false;
+        }
+        type = header[0];
+        payload.resize(header[1]);
+        return readAll(fd, payload.data(), payload.size());
+    }
+    
+    bool makeAddress(const std::string& path, sockaddr_un& address) {
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path)) {
+            return false;
+        }
+        std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+    
+    // === КОНТРОЛЬНАЯ ТОЧКА ===
+    // Файл: [u64 magic][u64 отпечаток задачи], затем по пачке [u32 номер][u32 длина][записи].
+    // Пачка дописывается целиком и сбрасывается в ядро - переживает kill координатора.
+    // Недописанный хвост (координатор убит посреди записи) отрезается при открытии.
+    class Checkpoint {
+    public:
+        ~Checkpoint() {
+            if (file) {
+                std::fclose(file);
+            }
+        }
+        
+        // Поднимает посчитанные пачки в results/done; false - файл от другой задачи или ошибка
+        bool open(const std::string& path, std::uint64_t job_fingerprint, const MonteCarloConfig& config,
+                  int batch_size, std::vector<StrategyResult>& results, std::vector<char>& done, int& restored) {
+            restored = 0;
+            long good_size = 0;
+            if (std::FILE* existing = std::fopen(path.c_str(), "rb")) {
+                std::uint64_t header[2] = {0, 0};
+                bool header_ok = std::fread(header, sizeof(header), 1, existing) == 1;
+                if (header_ok && (header[0] != CHECKPOINT_MAGIC || header[1] != job_fingerprint)) {
+                    std::fclose(existing);
+                    return false;
+                }
+                if (header_ok) {
+                    good_size = sizeof(header);
+                    std::uint32_t entry[2];
+                    std::vector<std::uint8_t> payload;
+                    while (std::fread(entry, sizeof(entry), 1, existing) == 1) {
+                        if (entry[1] > MAX_MESSAGE) {
+                            break;          // Мусор в длине - дальше не доверяем
+                        }
+                        payload.resize(entry[1]);
+                        if (entry[0] >= done.size() || std::fread(payload.data(), 1, payload.size(), existing) != payload.size()) {
+                            break;
+                        }
+                        if (!done[entry[0]]) {
+                            ByteReader r(payload);
+                            if (!applyBatch(r, batchSamples(config, batch_size, entry[0]), results)) {
+                                break;
+                            }
+                            done[entry[0]] = 1;
+                            restored++;
+                        }
+                        good_size = std::ftell(existing);
+                    }
+                }
+                std::fclose(existing);
+            }
+            
+            if (good_size == 0) {
+                file = std::fopen(path.c_str(), "wb");
+                std::uint64_t header[2] = {CHECKPOINT_MAGIC, job_fingerprint};
+                return file && std::fwrite(header, sizeof(header), 1, file) == 1 && std::fflush(file) == 0;
+            }
+            
+            // Продолжаем после последней целой пачки
+            file = std::fopen(path.c_str(), "r+b");
+            return file && ftruncate(fileno(file), good_size) == 0 && std::fseek(file, good_size, SEEK_SET) == 0;
+        }
+        
+        bool append(std::uint32_t batch, const std::uint8_t* records, std::size_t size) {
+            if (!file) {
+                return true;
+            }
+            std::uint32_t entry[2] = {batch, static_cast<std::uint32_t>(size)};
+            return std::fwrite(entry, sizeof(entry), 1, file) == 1
+                && std::fwrite(records, 1, size, file) == size
+                && std::fflush(file) == 0;
+        }
+    
+    private:
+        std::FILE* file = nullptr;
+    };
+    
+    // Соединение координатора с воркером
+    struct WorkerConnection {
+        int fd = -1;
+        std::vector<std::uint8_t> inbox;    // Принятые байты до целого кадра
+        int batch = -1;                     // Пачка у воркера (-1 - нет)
+        bool waiting = false;               // Ждет пачку
+    };
+    
+    pid_t spawnLocalWorker(int listen_fd, const Track& track, const F1PhysicsEngine::CarParameters& car,
+                           const std::string& socket_path) {
+        std::cout.flush();
+        std::fflush(nullptr);
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(listen_fd);
+            bool ok = runSweepWorker(track, car, socket_path);
+            _exit(ok ? 0 : 1);
+        }
+        return pid;
+    }
+}
+
+// === КООРДИНАТОР ===
+
+bool runSweepCoordinator(const Track& track, const F1PhysicsEngine::CarParameters& car,
+                         const std::vector<PitStrategy>& strategies, const MonteCarloConfig& config,
+                         const SweepConfig& sweep, std::vector<StrategyResult>& results,
+                         SweepStats* stats) {
+    SweepStats local_stats;
+    SweepStats& st = stats ? *stats : local_stats;
+    st = SweepStats();
+    
+    const int batch_size = std::max(1, sweep.batch_size);
+    const std::vector<std::uint8_t> job = encodeJob(config, strategies, batch_size);
+    const int batches = batchCount(config, batch_size);
+    st.batches = batches;
+    results = emptyStrategyResults(strategies, config);
+    
+    // 1. Контрольная точка: посчитанное раньше - сразу в накопители
+    std::vector<char> done(batches, 0);
+    Checkpoint checkpoint;
+    if (!sweep.checkpoint_path.empty() &&
+        !checkpoint.open(sweep.checkpoint_path, fingerprint(job), config, batch_size, results, done,
+                         st.restored_batches)) {
+        return false;
+    }
+    std::deque<int> pending;
+    for (int b = 0; b < batches; b++) {
+        if (!done[b]) {
+            pending.push_back(b);
+        }
+    }
+    int remaining = static_cast<int>(pending.size());
+    if (remaining == 0) {
+        return true;
+    }
+    
+    // 2. Сокет
+    sockaddr_un address;
+    if (!makeAddress(sweep.socket_path, address)) {
+        return false;
+    }
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        return false;
+    }
+    unlink(sweep.socket_path.c_str());
+    if (bind(listen_fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listen_fd, 64) != 0) {
+        close(listen_fd);
+        return false;
+    }
+    
+    // 3. Локальные воркеры. Упавший перезапускается, пока есть работа
+    // (с ограничением - чтобы не крутиться, если воркер падает сразу)
+    std::vector<pid_t> children;
+    int respawns_left = 4 * sweep.local_workers;
+    for (int i = 0; i < sweep.local_workers; i++) {
+        pid_t pid = spawnLocalWorker(listen_fd, track, car, sweep.socket_path);
+        if (pid > 0) {
+            children.push_back(pid);
+        }
+    }
+    
+    // 4. Цикл событий: прием, кадры от воркеров, раздача пачек
+    std::vector<WorkerConnection> connections;
+    std::vector<pollfd> fds;
+    bool ok = true;
+    
+    auto disconnect = [&](WorkerConnection& c) {
+        if (c.batch >= 0 && !done[c.batch]) {
+            pending.push_front(c.batch);    // Пачка упавшего воркера - первой следующему
+            st.reassigned_batches++;
+        }
+        close(c.fd);
+        c.fd = -1;
+    };
+    
+    while (remaining > 0 && ok) {
+        fds.clear();
+        fds.push_back({listen_fd, POLLIN, 0});
+        for (const WorkerConnection& c : connections) {
+            fds.push_back({c.fd, POLLIN, 0});
+        }
+        if (poll(fds.data(), fds.size(), 200) < 0 && errno != EINTR) {
+            ok = false;
+            break;
+        }
+        
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(listen_fd, nullptr, nullptr);
+            if (fd >= 0) {
+                WorkerConnection c;
+                c.fd = fd;
+                connections.push_back(c);
+                st.workers_seen++;
+            }
+        }
+        
+        for (std::size_t i = 1; i < fds.size(); i++) {
+            WorkerConnection& c = connections[i - 1];
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                continue;
+            }
+            std::uint8_t buffer[64 * 1024];
+            ssize_t n = recv(c.fd, buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                if (n < 0 && errno == EINTR) {
+                    continue;
+                }
+                disconnect(c);
+                continue;
+            }
+            c.inbox.insert(c.inbox.end(), buffer, buffer + n);
+            
+            // Целые кадры из накопленного
+            std::size_t consumed = 0;
+            while (c.fd >= 0 && c.inbox.size() - consumed >= 8) {
+                std::uint32_t header[2];
+                std::memcpy(header, c.inbox.data() + consumed, sizeof(header));
+                if (header[1] > MAX_MESSAGE) {
+                    disconnect(c);
+                    break;
+                }
+                if (c.inbox.size() - consumed - 8 < header[1]) {
+                    break;
+                }
+                const std::uint8_t* payload = c.inbox.data() + consumed + 8;
+                std::size_t length = header[1];
+                consumed += 8 + length;
+                
+                if (header[0] == SWEEP_HELLO) {
+                    std::uint32_t version = 0;
+                    if (length >= 4) {
+                        std::memcpy(&version, payload, 4);
+                    }
+                    if (version != PROTOCOL_VERSION || !sendMessage(c.fd, SWEEP_JOB, job)) {
+                        disconnect(c);
+                        break;
+                    }
+                    c.waiting = true;
+                } else if (header[0] == SWEEP_RESULT && length >= 4) {
+                    std::uint32_t batch = 0;
+                    std::memcpy(&batch, payload, 4);
+                    if (c.batch < 0 || batch >= static_cast<std::uint32_t>(batches) ||
+                        static_cast<int>(batch) != c.batch) {
+                        disconnect(c);      // Не та пачка или вне диапазона - воркер сломан
+                        break;
+                    }
+                    std::vector<std::uint8_t> records(payload + 4, payload + length);
+                    ByteReader r(records);
+                    if (!applyBatch(r, batchSamples(config, batch_size, batch), results)) {
+                        disconnect(c);
+                        break;
+                    }
+                    if (!checkpoint.append(batch, records.data(), records.size())) {
+                        ok = false;
+                    }
+                    done[batch] = 1;
+                    remaining--;
+                    st.result_bytes += length;
+                    c.batch = -1;
+                    c.waiting = true;
+                } else {
+                    disconnect(c);
+                    break;
+                }
+            }
+            if (c.fd >= 0) {
+                c.inbox.erase(c.inbox.begin(), c.inbox.begin() + consumed);
+            }
+        }
+        
+        // Раздача: свободным воркерам - следующую пачку
+        for (WorkerConnection& c : connections) {
+            if (c.fd < 0 || !c.waiting || pending.empty()) {
+                continue;
+            }
+            int batch = pending.front();
+            ByteWriter w;
+            w.put<std::uint32_t>(static_cast<std::uint32_t>(batch));
+            w.put<std::int32_t>(batch * batch_size);
+            w.put<std::int32_t>(batchSamples(config, batch_size, batch));
+            pending.pop_front();
+            c.batch = batch;
+            c.waiting = false;
+            if (!sendMessage(c.fd, SWEEP_BATCH, w.bytes)) {
+                disconnect(c);
+            }
+        }
+        connections.erase(std::remove_if(connections.begin(), connections.end(),
+                                         [](const WorkerConnection& c) { return c.fd < 0; }),
+                          connections.end());
+        
+        // Упавшие локальные воркеры
+        for (pid_t& pid : children) {
+            int status = 0;
+            if (pid > 0 && waitpid(pid, &status, WNOHANG) == pid) {
+                pid = -1;
+                if (remaining > 0 && respawns_left > 0) {
+                    respawns_left--;
+                    pid = spawnLocalWorker(listen_fd, track, car, sweep.socket_path);
+                }
+            }
+        }
+    }
+    
+    // 5. Все посчитано: воркеры расходятся
+    for (WorkerConnection& c : connections) {
+        sendMessage(c.fd, SWEEP_DONE, std::vector<std::uint8_t>());
+        close(c.fd);
+    }
+    close(listen_fd);
+    unlink(sweep.socket_path.c_str());
+    for (pid_t pid : children) {
+        if (pid > 0) {
+            waitpid(pid, nullptr, 0);
+        }
+    }
+    return ok;
+}
+
+// === ВОРКЕР ===
+
+bool runSweepWorker(const Track& track, const F1PhysicsEngine::CarParameters& car,
+                    const std::string& socket_path, int crash_after_batches) {
+    sockaddr_un address;
+    if (!makeAddress(socket_path, address)) {
+        return false;
+    }
+    
+    // Координатор может еще подниматься - несколько попыток
+    int fd = -1;
+    for (int attempt = 0; attempt < 50 && fd < 0; attempt++) {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return false;
+        }
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd);
+            fd = -1;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+    }
+    if (fd < 0) {
+        return false;
+    }
+    
+    ByteWriter hello;
+    hello.put<std::uint32_t>(PROTOCOL_VERSION);
+    std::uint32_t type = 0;
+    std::vector<std::uint8_t> payload;
+    MonteCarloConfig config;
+    std::vector<PitStrategy> strategies;
+    if (!sendMessage(fd, SWEEP_HELLO, hello.bytes) || !receiveMessage(fd, type, payload) ||
+        type != SWEEP_JOB || !decodeJob(payload, config, strategies)) {
+        close(fd);
+        return false;
+    }
+    
+    std::vector<double> lap_times;
+    int batches_done = 0;
+    while (receiveMessage(fd, type, payload)) {
+        if (type == SWEEP_DONE) {
+            close(fd);
+            return true;
+        }
+        ByteReader r(payload);
+        std::uint32_t batch = r.get<std::uint32_t>();
+        int first = r.get<std::int32_t>();
+        int count = r.get<std::int32_t>();
+        if (type != SWEEP_BATCH || !r.ok) {
+            break;
+        }
+        
+        ByteWriter result;
+        result.put<std::uint32_t>(batch);
+        for (int i = 0; i < count; i++) {
+            // Проверка восстановления: обрыв посреди пачки
+            if (batches_done == crash_after_batches && i == count / 2) {
+                close(fd);
+                return false;
+            }
+            for (const PitStrategy& strategy : strategies) {
+                lap_times.clear();
+                RaceOutcome outcome = simulateRace(track, car, strategy, config,
+                                                   static_cast<std::uint64_t>(first + i), lap_times);
+                encodeOutcome(result, outcome, lap_times);
+            }
+        }
+        if (!sendMessage(fd, SWEEP_RESULT, result.bytes)) {
+            break;
+        }
+        batches_done++;
+    }
+    close(fd);
+    return false;
+}
@@ -0,0 +1,57 @@
+#ifndef F1_SWEEP_H
+#define F1_SWEEP_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "F1_MonteCarlo.h"
+#include "F1_Physics_build_2.h"
+#include "F1_Track.h"
+
+// Развертка Монте-Карло на несколько процессов: координатор режет выборки
+// на пачки, воркеры забирают их по Unix-сокету, считают и присылают
+// компактные двоичные результаты. Гонка выборки зависит только от seed и
+// номера (CounterRng), поэтому пачку можно пересчитать где угодно.
+//
+// Координатор пишет каждую принятую пачку в файл контрольной точки. Упавший
+// воркер теряет только свою текущую пачку: она возвращается в очередь. Упавший
+// координатор при перезапуске с тем же файлом и той же задачей пропускает уже
+// посчитанное.
+//
+// Протокол: кадры [u32 тип][u32 длина][данные], числа в порядке байт хоста
+// (все процессы на одной машине; для удаленных воркеров понадобится явный).
+//   воркер -> HELLO; координатор -> JOB (задача целиком)
+//   координатор -> BATCH (номер, первая выборка, число) или DONE
+//   воркер -> RESULT (номер, записи) - он же запрос следующей пачки
+
+struct SweepConfig {
+    std::string socket_path = "/tmp/f1_sweep.sock";
+    std::string checkpoint_path;        // Пусто - без контрольной точки
+    int batch_size = 8;                 // Выборок в пачке
+    int local_workers = 0;              // Воркеров, запускаемых fork() самим координатором
+};
+
+struct SweepStats {
+    int batches = 0;                    // Всего пачек
+    int restored_batches = 0;           // Взято из контрольной точки
+    int reassigned_batches = 0;         // Возвращено в очередь после обрыва воркера
+    int workers_seen = 0;               // Подключений воркеров
+    std::uint64_t result_bytes = 0;     // Принято данных результатов
+};
+
+// Координатор: слушает socket_path, пока все пачки не посчитаны. Трасса и
+// машина - те же, что у воркеров (воркер получает только задачу: настройки
+// и стратегии). false - ошибка сокета или контрольной точки от другой задачи.
+bool runSweepCoordinator(const Track& track, const F1PhysicsEngine::CarParameters& car,
+                         const std::vector<PitStrategy>& strategies, const MonteCarloConfig& config,
+                         const SweepConfig& sweep, std::vector<StrategyResult>& results,
+                         SweepStats* stats = nullptr);
+
+// Воркер: подключается к координатору и считает пачки до DONE.
+// crash_after_batches >= 0 - оборвать соединение посреди пачки с этим
+// номером по счету (проверка восстановления на одной машине).
+// false - нет связи с координатором или он оборвал протокол.
+bool runSweepWorker(const Track& track, const F1PhysicsEngine::CarParameters& car,
+                    const std::string& socket_path, int crash_after_batches = -1);
+
+#endif // F1_SWEEP_H
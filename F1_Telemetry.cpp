@@ -0,0 +1,264 @@
+#include "F1_Telemetry.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace telemetry_bus;
+
+TelemetryFrame makeTelemetryFrame(const F1PhysicsEngine& engine, std::uint16_t car_id) {
+    const auto& state = engine.getState();
+    const auto& slow = engine.getSlowState();
+    
+    TelemetryFrame frame;
+    frame.time = state.time;
+    frame.position_x = state.position.x;
+    frame.position_y = state.position.y;
+    frame.velocity = state.velocity.x;
+    frame.engine_rpm = state.engine_rpm;
+    frame.down_force = state.down_force;
+    frame.battery_energy = state.battery_energy;
+    frame.lap_distance = state.lap_distance;
+    frame.mass = state.mass;
+    frame.tire_grip = state.tire_grip;
+    frame.fuel_mass = slow.fuel_mass;
+    frame.tire_wear = slow.tire_wear;
+    frame.last_lap_time = slow.last_lap_time;
+    frame.lap_time = state.time - slow.lap_start_time;
+    frame.brake_factor = state.brake_factor;
+    frame.lap_deployed_energy = state.lap_deployed_energy;
+    frame.lap_harvested_energy = state.lap_harvested_energy;
+    frame.lap = state.lap;
+    frame.gear = state.current_gear;
+    frame.car_id = car_id;
+    frame.flags = (state.clutch_locked ? TelemetryFrame::FLAG_CLUTCH_LOCKED : 0)
+                | (state.rev_limiter_active ? TelemetryFrame::FLAG_REV_LIMITER : 0)
+                | (state.out_of_fuel ? TelemetryFrame::FLAG_OUT_OF_FUEL : 0);
+    return frame;
+}
+
+// === ИЗДАТЕЛЬ ===
+
+bool TelemetryPublisher::open(const std::string& segment_name, std::uint32_t slot_count) {
+    close();
+    
+    std::uint32_t slots_pow2 = 1;
+    while (slots_pow2 < slot_count && slots_pow2 < (1u << 30)) {
+        slots_pow2 <<= 1;
+    }
+    
+    // Старый сегмент (например, от упавшего издателя) удаляем: его читатели
+    // держат свое отображение и не мешают новому
+    shm_unlink(segment_name.c_str());
+    int fd = shm_open(segment_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    
+    std::size_t size = segmentSize(slots_pow2);
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        shm_unlink(segment_name.c_str());
+        return false;
+    }
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        shm_unlink(segment_name.c_str());
+        return false;
+    }
+    
+    name = segment_name;
+    mapping = memory;
+    mapping_size = size;
+    header = new (memory) Header();
+    slots = reinterpret_cast<Slot*>(static_cast<char*>(memory) + sizeof(Header));
+    for (std::uint32_t i = 0; i < slots_pow2; i++) {
+        new (&slots[i]) Slot();
+    }
+    slot_mask = slots_pow2 - 1;
+    write_index = 0;
+    
+    header->version = VERSION;
+    header->frame_size = sizeof(TelemetryFrame);
+    header->slot_count = slots_pow2;
+    header->slot_size = sizeof(Slot);
+    header->writer_pid = static_cast<std::int32_t>(getpid());
+    header->state.store(STATE_LIVE, std::memory_order_relaxed);
+    header->write_index.store(0, std::memory_order_relaxed);
+    header->magic.store(MAGIC, std::memory_order_release);
+    return true;
+}
+
+void TelemetryPublisher::close() {
+    if (header == nullptr) {
+        return;
+    }
+    header->state.store(STATE_CLOSED, std::memory_order_release);
+    munmap(mapping, mapping_size);
+    shm_unlink(name.c_str());
+    mapping = nullptr;
+    mapping_size = 0;
+    header = nullptr;
+    slots = nullptr;
+}
+
+void TelemetryPublisher::publish(const TelemetryFrame& frame) {
+    if (header == nullptr) {
+        return;
+    }
+    
+    std::uint64_t words[FRAME_WORDS];
+    std::memcpy(words, &frame, sizeof(words));
+    words[0] = write_index;     // sequence - первое поле кадра
+    
+    // Seqlock: нечетный номер -> данные -> четный номер
+    Slot& slot = slots[write_index & slot_mask];
+    slot.sequence.store(2 * write_index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::size_t i = 0; i < FRAME_WORDS; i++) {
+        slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(2 * write_index + 2, std::memory_order_release);
+    
+    write_index++;
+    header->write_index.store(write_index, std::memory_order_release);
+}
+
+// === ЧИТАТЕЛЬ ===
+
+bool TelemetryReader::attach(const std::string& segment_name) {
+    detach();
+    
+    int fd = shm_open(segment_name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Header)) {
+        ::close(fd);
+        return false;
+    }
+    std::size_t size = static_cast<std::size_t>(info.st_size);
+    void* memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+    
+    // Проверка версии и раскладки: magic пишется последним, после него поля готовы
+    const Header* h = static_cast<const Header*>(memory);
+    bool valid = h->magic.load(std::memory_order_acquire) == MAGIC
+              && h->version == VERSION
+              && h->frame_size == sizeof(TelemetryFrame)
+              && h->slot_size == sizeof(Slot)
+              && h->slot_count != 0 && (h->slot_count & (h->slot_count - 1)) == 0
+              && size >= segmentSize(h->slot_count);
+    if (!valid) {
+        munmap(memory, size);
+        return false;
+    }
+    
+    mapping = memory;
+    mapping_size = size;
+    header = h;
+    slots = reinterpret_cast<const Slot*>(static_cast<const char*>(memory) + sizeof(Header));
+    slot_count = h->slot_count;
+    cursor = h->write_index.load(std::memory_order_acquire);
+    lost = 0;
+    return true;
+}
+
+void TelemetryReader::detach() {
+    if (mapping != nullptr) {
+        munmap(const_cast<void*>(mapping), mapping_size);
+    }
+    mapping = nullptr;
+    mapping_size = 0;
+    header = nullptr;
+    slots = nullptr;
+}
+
+bool TelemetryReader::readSlot(std::uint64_t index, TelemetryFrame& frame) const {
+    const Slot& slot = slots[index & (slot_count - 1)];
+    std::uint64_t expected = 2 * index + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != expected) {
+        return false;
+    }
+    
+    std::uint64_t words[FRAME_WORDS];
+    for (std::size_t i = 0; i < FRAME_WORDS; i++) {
+        words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+        return false;   // Издатель начал перезаписывать слот во время копирования
+    }
+    std::memcpy(&frame, words, sizeof(words));
+    return true;
+}
+
+bool TelemetryReader::next(TelemetryFrame& frame) {
+    if (header == nullptr) {
+        return false;
+    }
+    
+    while (true) {
+        std::uint64_t published = header->write_index.load(std::memory_order_acquire);
+        if (cursor >= published) {
+            return false;
+        }
+        
+        // Отстали больше чем на кольцо - прыгаем в середину живой части,
+        // чтобы сразу же не оказаться обогнанными снова
+        if (published - cursor > slot_count) {
+            std::uint64_t resume = published - slot_count / 2;
+            lost += resume - cursor;
+            cursor = resume;
+        }
+        
+        if (readSlot(cursor, frame)) {
+            cursor++;
+            return true;
+        }
+        
+        // Слот перезаписан, пока мы до него шли: кадр потерян
+        lost++;
+        cursor++;
+    }
+}
+
+bool TelemetryReader::latest(TelemetryFrame& frame) const {
+    if (header == nullptr) {
+        return false;
+    }
+    for (int attempt = 0; attempt < 4; attempt++) {
+        std::uint64_t published = header->write_index.load(std::memory_order_acquire);
+        if (published == 0) {
+            return false;
+        }
+        if (readSlot(published - 1, frame)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TelemetryReader::writerGone() const {
+    if (header == nullptr) {
+        return true;
+    }
+    if (header->state.load(std::memory_order_acquire) != STATE_LIVE) {
+        return true;
+    }
+    // Процесс издателя завершился, не закрыв шину (EPERM - жив, но чужой)
+    return kill(header->writer_pid, 0) != 0 && errno == ESRCH;
+}
+
+std::uint64_t TelemetryReader::publishedFrames() const {
+    return header != nullptr ? header->write_index.load(std::memory_order_acquire) : 0;
+}
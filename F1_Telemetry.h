@@ -0,0 +1,224 @@
+#ifndef F1_TELEMETRY_H
+#define F1_TELEMETRY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include "F1_Physics_build_2.h"
+
+// Кадр телеметрии. Раскладка фиксирована и не зависит от CarState:
+// читатели из других процессов проверяют ее по версии шины.
+struct TelemetryFrame {
+    std::uint64_t sequence = 0;         // Номер кадра на шине (ставит издатель)
+    
+    double time = 0.0;                  // [с]
+    double position_x = 0.0;            // [м]
+    double position_y = 0.0;            // [м]
+    double velocity = 0.0;              // [м/с]
+    double engine_rpm = 0.0;
+    double down_force = 0.0;            // [Н]
+    double battery_energy = 0.0;        // [Дж]
+    double lap_distance = 0.0;          // [м]
+    double mass = 0.0;                  // [кг]
+    double tire_grip = 0.0;
+    double fuel_mass = 0.0;             // [кг]
+    double tire_wear = 0.0;             // [0..1]
+    double last_lap_time = 0.0;         // [с]
+    double lap_time = 0.0;              // С начала текущего круга [с]
+    
+    float brake_factor = 0.0f;
+    float lap_deployed_energy = 0.0f;   // [Дж]
+    float lap_harvested_energy = 0.0f;  // [Дж]
+    std::int32_t lap = 0;
+    
+    std::int16_t gear = 0;
+    std::uint16_t car_id = 0;           // Номер машины (несколько машин на одной шине)
+    std::uint8_t flags = 0;             // FLAG_*
+    std::uint8_t reserved[3] = {0, 0, 0};
+    
+    static constexpr std::uint8_t FLAG_CLUTCH_LOCKED = 1;
+    static constexpr std::uint8_t FLAG_REV_LIMITER = 2;
+    static constexpr std::uint8_t FLAG_OUT_OF_FUEL = 4;
+};
+
+static_assert(sizeof(TelemetryFrame) % 8 == 0, "TelemetryFrame is copied in 64-bit words");
+
+// Снимок машины в кадр
+TelemetryFrame makeTelemetryFrame(const F1PhysicsEngine& engine, std::uint16_t car_id = 0);
+
+// === РАЗДЕЛЯЕМАЯ ПАМЯТЬ ===
+// Сегмент POSIX shm: заголовок и кольцо слотов. У каждого слота свой seqlock:
+// нечетный номер - слот пишется, четный 2*(i+1) - в слоте кадр i.
+// Издатель один и никого не ждет; читатели только читают отображение
+// (PROT_READ), поэтому подключение и отключение на издателя не влияют.
+// Кадр хранится 64-битными атомарными словами: чтение во время записи
+// определено моделью памяти, порванный кадр отбрасывается по seqlock.
+
+namespace telemetry_bus {
+    constexpr std::uint64_t MAGIC = 0x314D4C5431424631ULL;   // "1FB1TLM1"
+    constexpr std::uint32_t VERSION = 2;          // 2: lap_time в кадре
+    constexpr std::size_t FRAME_WORDS = sizeof(TelemetryFrame) / 8;
+    
+    enum State : std::uint32_t { STATE_LIVE = 1, STATE_CLOSED = 2 };
+    
+    struct Header {
+        std::atomic<std::uint64_t> magic;           // Пишется последним: до него сегмент не готов
+        std::uint32_t version;
+        std::uint32_t frame_size;
+        std::uint32_t slot_count;                   // Степень двойки
+        std::uint32_t slot_size;
+        std::int32_t writer_pid;
+        std::atomic<std::uint32_t> state;
+        alignas(64) std::atomic<std::uint64_t> write_index;  // Опубликовано кадров
+    };
+    
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> sequence;
+        std::atomic<std::uint64_t> words[FRAME_WORDS];
+    };
+    
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "shared-memory seqlock needs address-free 64-bit atomics");
+    
+    inline std::size_t segmentSize(std::uint32_t slot_count) {
+        return sizeof(Header) + static_cast<std::size_t>(slot_count) * sizeof(Slot);
+    }
+}
+
+// Издатель: создает сегмент и пишет кадр каждый шаг.
+// publish() - только запись в память, без системных вызовов и блокировок.
+// При сборке на старом glibc нужен -lrt (shm_open).
+class TelemetryPublisher {
+public:
+    TelemetryPublisher() = default;
+    ~TelemetryPublisher() { close(); }
+    
+    TelemetryPublisher(const TelemetryPublisher&) = delete;
+    TelemetryPublisher& operator=(const TelemetryPublisher&) = delete;
+    
+    // Пересоздает сегмент name ("/f1_telemetry"); slot_count округляется до степени двойки.
+    // Читатели старого сегмента видят его закрытым и переподключаются.
+    bool open(const std::string& name, std::uint32_t slot_count = 4096);
+    
+    // Помечает шину закрытой, снимает отображение и удаляет имя
+    void close();
+    
+    bool isOpen() const { return header != nullptr; }
+    
+    void publish(const TelemetryFrame& frame);
+    void publish(const F1PhysicsEngine& engine, std::uint16_t car_id = 0) {
+        publish(makeTelemetryFrame(engine, car_id));
+    }
+
+private:
+    std::string name;
+    void* mapping = nullptr;
+    std::size_t mapping_size = 0;
+    telemetry_bus::Header* header = nullptr;
+    telemetry_bus::Slot* slots = nullptr;
+    std::uint64_t slot_mask = 0;
+    std::uint64_t write_index = 0;      // Локальная копия, чтобы не читать общую линию
+};
+
+// Последнее значение внутри процесса: seqlock одного слота, как у слота шины,
+// без разделяемой памяти. Пишет один поток (физика) каждый шаг, читают
+// другие (панель): без блокировок, значение всегда одного шага.
+// T копируется 64-битными словами, поэтому должен быть тривиально копируемым
+template <typename T>
+class SnapshotSlot {
+    static_assert(std::is_trivially_copyable<T>::value, "SnapshotSlot copies T as raw words");
+    static constexpr std::size_t WORDS = (sizeof(T) + 7) / 8;
+
+public:
+    void store(const T& value) {
+        std::uint64_t words_in[WORDS] = {};
+        std::memcpy(words_in, &value, sizeof(T));
+        
+        // Seqlock, как в publish(): нечетный номер -> данные -> четный
+        std::uint64_t next = sequence.load(std::memory_order_relaxed) + 2;
+        sequence.store(next - 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < WORDS; i++) {
+            words[i].store(words_in[i], std::memory_order_relaxed);
+        }
+        sequence.store(next, std::memory_order_release);
+    }
+    
+    // false - значения еще не было или писатель занимал слот все попытки
+    bool load(T& value) const {
+        for (int attempt = 0; attempt < 4; attempt++) {
+            std::uint64_t before = sequence.load(std::memory_order_acquire);
+            if (before == 0) {
+                return false;
+            }
+            if (before & 1) {
+                continue;
+            }
+            
+            std::uint64_t words_out[WORDS];
+            for (std::size_t i = 0; i < WORDS; i++) {
+                words_out[i] = words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) {
+                std::memcpy(&value, words_out, sizeof(T));
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::atomic<std::uint64_t> sequence{0};
+    std::atomic<std::uint64_t> words[WORDS] = {};
+};
+
+using TelemetrySnapshot = SnapshotSlot<TelemetryFrame>;
+
+// Читатель: отображает сегмент только на чтение и идет по кольцу своим курсором
+class TelemetryReader {
+public:
+    TelemetryReader() = default;
+    ~TelemetryReader() { detach(); }
+    
+    TelemetryReader(const TelemetryReader&) = delete;
+    TelemetryReader& operator=(const TelemetryReader&) = delete;
+    
+    // false - сегмента нет, он еще не готов или другой версии.
+    // Курсор встает на конец: next() вернет кадры, опубликованные после подключения.
+    bool attach(const std::string& name);
+    void detach();
+    
+    bool isAttached() const { return header != nullptr; }
+    
+    // Следующий кадр после курсора; false - новых кадров нет.
+    // Если издатель обогнал читателя на кольцо, курсор прыгает вперед,
+    // а пропущенные кадры считаются в lostFrames().
+    bool next(TelemetryFrame& frame);
+    
+    // Последний опубликованный кадр, курсор не двигается
+    bool latest(TelemetryFrame& frame) const;
+    
+    // Издатель закрыл шину или его процесса больше нет - пора переподключаться
+    bool writerGone() const;
+    
+    std::uint64_t lostFrames() const { return lost; }
+    std::uint64_t publishedFrames() const;
+
+private:
+    // Копирует кадр index из его слота; false - слот уже перезаписан или пишется
+    bool readSlot(std::uint64_t index, TelemetryFrame& frame) const;
+    
+    const void* mapping = nullptr;
+    std::size_t mapping_size = 0;
+    const telemetry_bus::Header* header = nullptr;
+    const telemetry_bus::Slot* slots = nullptr;
+    std::uint64_t slot_count = 0;
+    std::uint64_t cursor = 0;
+    std::uint64_t lost = 0;
+};
+
+#endif // F1_TELEMETRY_H
@@ -0,0 +1,224 @@
+#include "F1_TelemetryCodec.h"
+
+namespace {
+    constexpr std::uint8_t MAGIC[4] = {'F', '1', 'G', 'C'};
+    constexpr std::uint8_t VERSION = 1;
+    constexpr std::size_t HEADER_BYTES = 16;
+    constexpr std::size_t PADDING_BYTES = 8;
+    
+    std::uint64_t toBits(double value) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, 8);
+        return bits;
+    }
+    
+    double fromBits(std::uint64_t bits) {
+        double value;
+        std::memcpy(&value, &bits, 8);
+        return value;
+    }
+    
+    std::int64_t signExtend(std::uint64_t value, int bits) {
+        return static_cast<std::int64_t>(value << (64 - bits)) >> (64 - bits);
+    }
+    
+    bool fits(std::int64_t value, int bits) {
+        std::int64_t limit = std::int64_t(1) << (bits - 1);
+        return value >= -limit && value < limit;
+    }
+}
+
+// === КОДЕР ===
+
+TelemetryEncoder::TelemetryEncoder(int channel_count, CodecPredictor predictor)
+    : channels(channel_count > 0 ? channel_count : 0), predictor(predictor) {
+    for (std::uint8_t b : MAGIC) {
+        writer.write(b, 8);
+    }
+    writer.write(VERSION, 8);
+    writer.write(static_cast<std::uint8_t>(predictor), 8);
+    writer.write(static_cast<std::uint16_t>(channels.size()), 16);
+    writer.write(0, 64);        // Число отсчетов - в finish()
+}
+
+void TelemetryEncoder::append(std::int64_t timestamp, const double* values) {
+    if (finished) {
+        return;
+    }
+    
+    // Первый отсчет - сырыми битами
+    if (samples == 0) {
+        writer.write(static_cast<std::uint64_t>(timestamp), 64);
+        for (std::size_t c = 0; c < channels.size(); c++) {
+            std::uint64_t bits = toBits(values[c]);
+            writer.write(bits, 64);
+            channels[c].history.start(bits, predictor);
+        }
+        previous_timestamp = timestamp;
+        samples++;
+        return;
+    }
+    
+    // Время: разность разностей. При постоянном шаге - один бит '0'.
+    std::int64_t delta = timestamp - previous_timestamp;
+    std::int64_t dod = delta - previous_delta;
+    std::uint64_t u = static_cast<std::uint64_t>(dod);
+    if (dod == 0) {
+        writer.write(0, 1);
+    } else if (fits(dod, 7)) {
+        writer.write((0x2ULL << 7) | (u & 0x7F), 9);
+    } else if (fits(dod, 9)) {
+        writer.write((0x6ULL << 9) | (u & 0x1FF), 12);
+    } else if (fits(dod, 12)) {
+        writer.write((0xEULL << 12) | (u & 0xFFF), 16);
+    } else if (fits(dod, 32)) {
+        writer.write((0x1EULL << 32) | (u & 0xFFFFFFFFULL), 37);
+    } else {
+        writer.write(0x1F, 5);
+        writer.write(u, 64);
+    }
+    previous_timestamp = timestamp;
+    previous_delta = delta;
+    
+    for (std::size_t c = 0; c < channels.size(); c++) {
+        encodeValue(channels[c], toBits(values[c]));
+    }
+    samples++;
+}
+
+void TelemetryEncoder::encodeValue(Channel& channel, std::uint64_t bits) {
+    std::uint64_t x = bits ^ channel.history.predict();
+    channel.history.push(bits, predictor);
+    
+    if (x == 0) {
+        writer.write(0, 1);
+        return;
+    }
+    
+    int leading = __builtin_clzll(x);
+    int trailing = __builtin_ctzll(x);
+    if (leading > 31) {
+        leading = 31;   // 5 бит на поле
+    }
+    
+    // Значащие биты помещаются в окно прошлого значения - окно не пишем
+    if (channel.leading >= 0 && leading >= channel.leading && trailing >= channel.trailing) {
+        writer.write(0x2, 2);
+        writer.write(x >> channel.trailing, 64 - channel.leading - channel.trailing);
+        return;
+    }
+    
+    int length = 64 - leading - trailing;
+    writer.write((0x3ULL << 11) | (static_cast<std::uint64_t>(leading) << 6) | (length - 1), 13);
+    writer.write(x >> trailing, length);
+    channel.leading = leading;
+    channel.trailing = trailing;
+}
+
+const std::vector<std::uint8_t>& TelemetryEncoder::finish() {
+    std::vector<std::uint8_t>& bytes = writer.buffer();
+    if (!finished) {
+        writer.finish();
+        for (int i = 0; i < 8; i++) {
+            bytes[8 + i] = static_cast<std::uint8_t>(samples >> (8 * i));
+        }
+        bytes.insert(bytes.end(), PADDING_BYTES, 0);
+        finished = true;
+    }
+    return bytes;
+}
+
+// === ДЕКОДЕР ===
+
+TelemetryDecoder::TelemetryDecoder(const std::uint8_t* data, std::size_t size) {
+    if (size < HEADER_BYTES + PADDING_BYTES || std::memcmp(data, MAGIC, 4) != 0
+        || data[4] != VERSION || data[5] > static_cast<std::uint8_t>(CodecPredictor::Adaptive)) {
+        return;
+    }
+    predictor = static_cast<CodecPredictor>(data[5]);
+    channels.resize((static_cast<std::size_t>(data[6]) << 8) | data[7]);
+    for (int i = 0; i < 8; i++) {
+        total_samples |= static_cast<std::uint64_t>(data[8 + i]) << (8 * i);
+    }
+    reader = BitReader(data, size);
+    reader.skip(HEADER_BYTES * 8);
+    header_ok = true;
+}
+
+bool TelemetryDecoder::next(std::int64_t& timestamp, double* values) {
+    if (!header_ok || samples >= total_samples || reader.overrun()) {
+        return false;
+    }
+    
+    if (samples == 0) {
+        timestamp = static_cast<std::int64_t>(reader.read64());
+        for (std::size_t c = 0; c < channels.size(); c++) {
+            std::uint64_t bits = reader.read64();
+            channels[c].history.start(bits, predictor);
+            values[c] = fromBits(bits);
+        }
+        previous_timestamp = timestamp;
+        samples++;
+        return true;
+    }
+    
+    // Префикс из единиц до первого нуля (не больше пяти) выбирает ширину
+    std::uint64_t word = reader.peek();
+    int ones = __builtin_clzll(~word | 1);
+    std::int64_t dod = 0;
+    switch (ones) {
+        case 0: reader.skip(1); break;
+        case 1: reader.skip(2); dod = signExtend(reader.read(7), 7); break;
+        case 2: reader.skip(3); dod = signExtend(reader.read(9), 9); break;
+        case 3: reader.skip(4); dod = signExtend(reader.read(12), 12); break;
+        case 4: reader.skip(5); dod = signExtend(reader.read(32), 32); break;
+        default: reader.skip(5); dod = static_cast<std::int64_t>(reader.read64()); break;
+    }
+    previous_delta += dod;
+    previous_timestamp += previous_delta;
+    timestamp = previous_timestamp;
+    
+    // Читатель в локальной копии - позиция живет в регистре, а не в памяти объекта
+    BitReader local = reader;
+    for (std::size_t c = 0; c < channels.size(); c++) {
+        values[c] = fromBits(decodeValue(local, channels[c]));
+    }
+    reader = local;
+    samples++;
+    return true;
+}
+
+std::uint64_t TelemetryDecoder::decodeValue(BitReader& reader, Channel& channel) {
+    std::uint64_t predicted = channel.history.predict();
+    std::uint64_t word = reader.peek();
+    std::uint64_t x = 0;
+    
+    if ((word >> 63) == 0) {
+        reader.skip(1);
+    } else {
+        int header_bits = 2;
+        if ((word >> 62) == 0x3) {
+            // Новое окно: 5 бит ведущих нулей, 6 бит длины - 1
+            channel.leading = static_cast<int>((word >> 57) & 0x1F);
+            channel.length = static_cast<int>((word >> 51) & 0x3F) + 1;
+            header_bits = 13;
+        }
+        int length = channel.length;
+        int trailing = 64 - channel.leading - length;
+        
+        // Обычно код целиком в уже прочитанном слове - второе чтение не нужно
+        if (header_bits + length <= 57) {
+            x = ((word << header_bits) >> (64 - length)) << trailing;
+            reader.skip(header_bits + length);
+        } else {
+            reader.skip(header_bits);
+            std::uint64_t meaningful = length <= 57 ? reader.read(length)
+                                                    : (reader.read(length - 32) << 32) | reader.read(32);
+            x = meaningful << trailing;
+        }
+    }
+    
+    std::uint64_t bits = predicted ^ x;
+    channel.history.push(bits, predictor);
+    return bits;
+}
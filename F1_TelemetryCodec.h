@@ -0,0 +1,225 @@
+#ifndef F1_TELEMETRY_CODEC_H
+#define F1_TELEMETRY_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Сжатие телеметрии в духе Gorilla (Facebook TSDB): отметки времени -
+// разность разностей, значения каналов - XOR с предсказанием.
+// Без потерь: decode() возвращает те же биты double, что были записаны.
+//
+// Формат потока:
+//   заголовок 16 байт: "F1GC", версия, предсказатель, число каналов (u16),
+//                      число отсчетов (u64, дописывается в finish())
+//   первый отсчет: время и значения сырыми 64 битами
+//   далее на отсчет: код разности разностей времени, затем по каналу код XOR
+//   8 нулевых байт в конце - запас для чтения словами
+//
+// Код XOR (как в Gorilla): '0' - совпало с предсказанием; '10' - значащие биты
+// в окне прошлого значения канала; '11' + 5 бит ведущих нулей + 6 бит длины - новое окно.
+
+// Предсказание следующего значения канала
+enum class CodecPredictor : std::uint8_t {
+    Previous = 0,   // Прошлое значение (классический Gorilla)
+    Linear = 1,     // Линейная экстраполяция по двум прошлым, в целых над битами double:
+                    // для плавных сигналов внутри одной экспоненты почти точна,
+                    // и не зависит от FMA и режима округления при сборке
+    Adaptive = 2    // По каналу: тот из двух, что точнее предсказал прошлый отсчет.
+                    // Ступенчатые каналы (медленный такт) - прошлое, гладкие - линейный
+};
+
+// История канала и выбор предсказания - общие для кодера и декодера
+struct CodecChannelHistory {
+    std::uint64_t previous = 0;
+    std::uint64_t before_previous = 0;
+    bool linear = false;                // Текущий выбор для Adaptive
+    
+    void start(std::uint64_t bits, CodecPredictor mode) {
+        previous = bits;
+        before_previous = bits;
+        linear = mode == CodecPredictor::Linear;
+    }
+    
+    std::uint64_t predict() const {
+        return linear ? 2 * previous - before_previous : previous;
+    }
+    
+    void push(std::uint64_t bits, CodecPredictor mode) {
+        if (mode == CodecPredictor::Adaptive) {
+            linear = distance(bits, 2 * previous - before_previous) < distance(bits, previous);
+        }
+        before_previous = previous;
+        previous = bits;
+    }
+
+private:
+    // Расстояние между битовыми образами: у близких double одного знака оно мало,
+    // и тогда мал и XOR
+    static std::uint64_t distance(std::uint64_t a, std::uint64_t b) {
+        return a > b ? a - b : b - a;
+    }
+};
+
+// === БИТОВЫЕ ПОТОКИ ===
+
+// Запись битов от старших к младшим
+class BitWriter {
+public:
+    void write(std::uint64_t value, int bits) {
+        if (bits == 0) {
+            return;
+        }
+        if (bits < 64) {
+            value &= (1ULL << bits) - 1;
+        }
+        int free_bits = 64 - used;
+        if (bits < free_bits) {
+            accumulator |= value << (free_bits - bits);
+            used += bits;
+            return;
+        }
+        int rest = bits - free_bits;
+        accumulator |= value >> rest;
+        flushWord();
+        accumulator = rest > 0 ? value << (64 - rest) : 0;
+        used = rest;
+    }
+    
+    // Дописывает неполное слово (с выравниванием на байт) и возвращает буфер
+    std::vector<std::uint8_t>& finish() {
+        for (int shift = 56; used > 0; shift -= 8, used -= 8) {
+            bytes.push_back(static_cast<std::uint8_t>(accumulator >> shift));
+        }
+        accumulator = 0;
+        used = 0;
+        return bytes;
+    }
+    
+    std::vector<std::uint8_t>& buffer() { return bytes; }
+    std::size_t bitCount() const { return bytes.size() * 8 + used; }
+
+private:
+    // Порядок байт в потоке - от старшего (хост little-endian)
+    void flushWord() {
+        std::uint64_t big_endian = __builtin_bswap64(accumulator);
+        std::size_t size = bytes.size();
+        bytes.resize(size + 8);
+        std::memcpy(bytes.data() + size, &big_endian, 8);
+    }
+    
+    std::vector<std::uint8_t> bytes;
+    std::uint64_t accumulator = 0;      // Заполняется со старшего бита
+    int used = 0;
+};
+
+// Чтение битов. Буфер должен иметь 8 байт запаса после последнего бита.
+class BitReader {
+public:
+    BitReader() = default;
+    BitReader(const std::uint8_t* data, std::size_t size) : data(data), size(size) {}
+    
+    // До 57 бит за раз
+    std::uint64_t read(int bits) {
+        std::uint64_t word = peek();
+        position += bits;
+        return bits == 0 ? 0 : word >> (64 - bits);
+    }
+    
+    std::uint64_t read64() {
+        std::uint64_t high = read(32);
+        return (high << 32) | read(32);
+    }
+    
+    bool readBit() {
+        bool bit = (peek() >> 63) != 0;
+        position++;
+        return bit;
+    }
+    
+    // Следующие 64 бита без сдвига позиции (валидны минимум 57)
+    std::uint64_t peek() const {
+        std::uint64_t word;
+        std::memcpy(&word, data + (position >> 3), 8);
+        return __builtin_bswap64(word) << (position & 7);
+    }
+    
+    void skip(int bits) { position += bits; }
+    bool overrun() const { return (position >> 3) + 8 > size; }
+
+private:
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+    std::size_t position = 0;           // В битах
+};
+
+// === КОДЕК ===
+
+// Потоковый кодер: отсчет за отсчетом, память - только выходной буфер
+class TelemetryEncoder {
+public:
+    explicit TelemetryEncoder(int channel_count, CodecPredictor predictor = CodecPredictor::Adaptive);
+    
+    // timestamp - целое время отсчета (например, наносекунды); values - channel_count значений
+    void append(std::int64_t timestamp, const double* values);
+    
+    // Закрывает поток (число отсчетов в заголовок, запас в конце) и отдает его
+    const std::vector<std::uint8_t>& finish();
+    
+    std::uint64_t sampleCount() const { return samples; }
+    std::size_t encodedBytes() const { return writer.bitCount() / 8; }
+
+private:
+    struct Channel {
+        CodecChannelHistory history;
+        int leading = -1;               // Окно значащих битов прошлого XOR (-1 - нет)
+        int trailing = 0;
+    };
+    
+    void encodeValue(Channel& channel, std::uint64_t bits);
+    
+    BitWriter writer;
+    std::vector<Channel> channels;
+    CodecPredictor predictor;
+    std::uint64_t samples = 0;
+    std::int64_t previous_timestamp = 0;
+    std::int64_t previous_delta = 0;
+    bool finished = false;
+};
+
+// Потоковый декодер поверх готового буфера (буфер не копируется)
+class TelemetryDecoder {
+public:
+    TelemetryDecoder(const std::uint8_t* data, std::size_t size);
+    explicit TelemetryDecoder(const std::vector<std::uint8_t>& buffer)
+        : TelemetryDecoder(buffer.data(), buffer.size()) {}
+    
+    // false - заголовок испорчен или версия не та
+    bool valid() const { return header_ok; }
+    int channelCount() const { return static_cast<int>(channels.size()); }
+    std::uint64_t sampleCount() const { return total_samples; }
+    
+    // Следующий отсчет; false - поток кончился (или оборван)
+    bool next(std::int64_t& timestamp, double* values);
+
+private:
+    struct Channel {
+        CodecChannelHistory history;
+        int leading = 0;
+        int length = 0;                 // Длина окна значащих битов
+    };
+    
+    std::uint64_t decodeValue(BitReader& reader, Channel& channel);
+    
+    BitReader reader;
+    std::vector<Channel> channels;
+    CodecPredictor predictor = CodecPredictor::Adaptive;
+    std::uint64_t total_samples = 0;
+    std::uint64_t samples = 0;
+    std::int64_t previous_timestamp = 0;
+    std::int64_t previous_delta = 0;
+    bool header_ok = false;
+};
+
+#endif // F1_TELEMETRY_CODEC_H
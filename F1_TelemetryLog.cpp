@@ -0,0 +1,263 @@
+#include "F1_TelemetryLog.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    constexpr char HEADER_MAGIC[8] = {'F', '1', 'T', 'L', 'O', 'G', '0', '1'};
+    constexpr char TRAILER_MAGIC[8] = {'F', '1', 'T', 'L', 'E', 'N', 'D', '1'};
+    constexpr std::uint32_t VERSION = 1;
+    
+    // Заголовок фиксированной части (за ним - имена каналов: u16 длина + байты)
+    struct LogHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t channel_count;
+        double track_length;
+        std::uint32_t block_samples;
+        std::uint32_t reserved;
+    };
+    
+    struct LogTrailer {
+        std::uint64_t index_offset;
+        std::uint64_t block_count;
+        char magic[8];
+    };
+}
+
+const std::vector<std::string>& carTelemetryChannels() {
+    static const std::vector<std::string> names = {
+        "position", "velocity", "engine_rpm", "battery_energy", "down_force", "lap_distance",
+        "brake_factor", "mass", "tire_grip", "fuel_mass", "tire_wear", "lap", "gear"};
+    return names;
+}
+
+// === ЗАПИСЬ ===
+
+bool TelemetryLogWriter::open(const std::string& path, const std::vector<std::string>& channel_names,
+                              double track_length, std::uint32_t block_samples, CodecPredictor predictor) {
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    
+    write_error = false;
+    channel_count = static_cast<int>(channel_names.size());
+    this->block_samples = std::max<std::uint32_t>(1, block_samples);
+    this->predictor = predictor;
+    samples = 0;
+    index.clear();
+    
+    LogHeader header;
+    std::memcpy(header.magic, HEADER_MAGIC, 8);
+    header.version = VERSION;
+    header.channel_count = static_cast<std::uint32_t>(channel_count);
+    header.track_length = track_length;
+    header.block_samples = this->block_samples;
+    header.reserved = 0;
+    write_error |= std::fwrite(&header, sizeof(header), 1, file) != 1;
+    offset = sizeof(header);
+    
+    for (const std::string& name : channel_names) {
+        std::uint16_t length = static_cast<std::uint16_t>(std::min<std::size_t>(name.size(), 0xFFFF));
+        write_error |= std::fwrite(&length, 2, 1, file) != 1;
+        write_error |= std::fwrite(name.data(), 1, length, file) != length;
+        offset += 2 + length;
+    }
+    return !write_error;
+}
+
+void TelemetryLogWriter::append(std::int64_t timestamp, const double* values) {
+    if (file == nullptr) {
+        return;
+    }
+    if (!encoder) {
+        encoder.reset(new TelemetryEncoder(channel_count, predictor));
+        current = TelemetryLogBlock();
+        current.first_timestamp = timestamp;
+        current.first_sample = samples;
+    }
+    encoder->append(timestamp, values);
+    current.last_timestamp = timestamp;
+    current.samples++;
+    samples++;
+    if (current.samples == block_samples) {
+        flushBlock();
+    }
+}
+
+void TelemetryLogWriter::appendFrame(const TelemetryFrame& frame) {
+    const double values[] = {
+        frame.position_x, frame.velocity, frame.engine_rpm, frame.battery_energy, frame.down_force,
+        frame.lap_distance, frame.brake_factor, frame.mass, frame.tire_grip, frame.fuel_mass,
+        frame.tire_wear, static_cast<double>(frame.lap), static_cast<double>(frame.gear)};
+    static_assert(sizeof(values) / sizeof(values[0]) == 13, "channels must match carTelemetryChannels()");
+    append(std::llround(frame.time * 1e9), values);
+}
+
+void TelemetryLogWriter::flushBlock() {
+    if (!encoder) {
+        return;
+    }
+    const std::vector<std::uint8_t>& bytes = encoder->finish();
+    current.offset = offset;
+    current.size = bytes.size();
+    write_error |= std::fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size();
+    offset += bytes.size();
+    index.push_back(current);
+    encoder.reset();
+}
+
+bool TelemetryLogWriter::close() {
+    if (file == nullptr) {
+        return !write_error;
+    }
+    flushBlock();
+    
+    LogTrailer trailer;
+    trailer.index_offset = offset;
+    trailer.block_count = index.size();
+    std::memcpy(trailer.magic, TRAILER_MAGIC, 8);
+    if (!index.empty()) {
+        write_error |= std::fwrite(index.data(), sizeof(TelemetryLogBlock), index.size(), file) != index.size();
+    }
+    write_error |= std::fwrite(&trailer, sizeof(trailer), 1, file) != 1;
+    write_error |= std::fclose(file) != 0;
+    file = nullptr;
+    return !write_error;
+}
+
+// === ЧТЕНИЕ ===
+
+bool TelemetryLog::open(const std::string& path) {
+    close();
+    
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(LogHeader) + sizeof(LogTrailer)) {
+        ::close(fd);
+        return false;
+    }
+    std::size_t file_size = static_cast<std::size_t>(info.st_size);
+    void* memory = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+    data = static_cast<const std::uint8_t*>(memory);
+    size = file_size;
+    
+    LogHeader header;
+    LogTrailer trailer;
+    std::memcpy(&header, data, sizeof(header));
+    std::memcpy(&trailer, data + size - sizeof(trailer), sizeof(trailer));
+    bool valid = std::memcmp(header.magic, HEADER_MAGIC, 8) == 0 && header.version == VERSION
+              && std::memcmp(trailer.magic, TRAILER_MAGIC, 8) == 0
+              && trailer.index_offset <= size - sizeof(trailer)
+              && trailer.block_count == (size - sizeof(trailer) - trailer.index_offset) / sizeof(TelemetryLogBlock);
+    
+    // Имена каналов
+    std::size_t position = sizeof(header);
+    for (std::uint32_t c = 0; valid && c < header.channel_count; c++) {
+        std::uint16_t length = 0;
+        valid = position + 2 <= trailer.index_offset;
+        if (valid) {
+            std::memcpy(&length, data + position, 2);
+            valid = position + 2 + length <= trailer.index_offset;
+        }
+        if (valid) {
+            channel_names.emplace_back(reinterpret_cast<const char*>(data + position + 2), length);
+            position += 2 + length;
+        }
+    }
+    
+    if (valid) {
+        index.resize(trailer.block_count);
+        if (!index.empty()) {
+            std::memcpy(index.data(), data + trailer.index_offset, index.size() * sizeof(TelemetryLogBlock));
+        }
+        for (const TelemetryLogBlock& block : index) {
+            valid = valid && block.offset + block.size <= trailer.index_offset;
+        }
+    }
+    
+    if (!valid) {
+        close();
+        return false;
+    }
+    track_length = header.track_length;
+    
+    // Блоки читаются вразброс разными потоками
+    madvise(memory, size, MADV_WILLNEED);
+    return true;
+}
+
+void TelemetryLog::close() {
+    if (data != nullptr) {
+        munmap(const_cast<std::uint8_t*>(data), size);
+    }
+    data = nullptr;
+    size = 0;
+    channel_names.clear();
+    index.clear();
+    track_length = 0.0;
+}
+
+int TelemetryLog::channelIndex(const std::string& name) const {
+    auto it = std::find(channel_names.begin(), channel_names.end(), name);
+    return it == channel_names.end() ? -1 : static_cast<int>(it - channel_names.begin());
+}
+
+std::uint64_t TelemetryLog::sampleCount() const {
+    return index.empty() ? 0 : index.back().first_sample + index.back().samples;
+}
+
+std::size_t TelemetryLog::findBlock(std::int64_t timestamp) const {
+    auto it = std::upper_bound(index.begin(), index.end(), timestamp,
+                               [](std::int64_t t, const TelemetryLogBlock& b) { return t < b.first_timestamp; });
+    return it == index.begin() ? 0 : static_cast<std::size_t>(it - index.begin()) - 1;
+}
+
+bool TelemetryLog::decodeBlock(std::size_t block, TelemetryColumns& out) const {
+    if (block >= index.size()) {
+        return false;
+    }
+    const TelemetryLogBlock& b = index[block];
+    TelemetryDecoder decoder(data + b.offset, b.size);
+    std::size_t channels = channel_names.size();
+    if (!decoder.valid() || decoder.channelCount() != static_cast<int>(channels) || decoder.sampleCount() != b.samples) {
+        return false;
+    }
+    
+    out.timestamps.resize(b.samples);
+    out.channels.resize(channels);
+    for (auto& column : out.channels) {
+        column.resize(b.samples);
+    }
+    
+    // Кодек отдает отсчет целиком - раскладываем по колонкам
+    double sample[256];
+    std::vector<double> wide;
+    double* values = sample;
+    if (channels > 256) {
+        wide.resize(channels);
+        values = wide.data();
+    }
+    for (std::size_t i = 0; i < b.samples; i++) {
+        if (!decoder.next(out.timestamps[i], values)) {
+            return false;
+        }
+        for (std::size_t c = 0; c < channels; c++) {
+            out.channels[c][i] = values[c];
+        }
+    }
+    return true;
+}
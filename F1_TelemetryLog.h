@@ -0,0 +1,117 @@
+#ifndef F1_TELEMETRY_LOG_H
+#define F1_TELEMETRY_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "F1_Telemetry.h"
+#include "F1_TelemetryCodec.h"
+
+// Файл лога телеметрии: заголовок с именами каналов, независимые блоки кодека
+// (по block_samples отсчетов) и индекс блоков в конце. Каждый блок декодируется
+// сам по себе - блоки разбираются параллельно, а поиск по времени идет по индексу.
+//
+//   заголовок: "F1TLOG01", версия, число каналов, длина круга, размер блока, имена
+//   блоки:     потоки TelemetryEncoder (см. F1_TelemetryCodec.h)
+//   индекс:    TelemetryLogBlock на блок
+//   хвост:     смещение индекса, число блоков, "F1TLEND1"
+// Числа в заголовке и индексе - в порядке байт хоста (little-endian).
+
+struct TelemetryLogBlock {
+    std::uint64_t offset = 0;           // Начало потока кодека в файле
+    std::uint64_t size = 0;             // Байт, вместе с запасом кодека
+    std::int64_t first_timestamp = 0;   // [нс]
+    std::int64_t last_timestamp = 0;
+    std::uint64_t first_sample = 0;     // Номер первого отсчета блока в логе
+    std::uint64_t samples = 0;
+};
+
+// Колонки одного блока: отсчет i - timestamps[i] и channels[c][i]
+struct TelemetryColumns {
+    std::vector<std::int64_t> timestamps;
+    std::vector<std::vector<double>> channels;
+    
+    std::size_t size() const { return timestamps.size(); }
+};
+
+// Каналы лога машины (из TelemetryFrame), в этом порядке
+const std::vector<std::string>& carTelemetryChannels();
+
+class TelemetryLogWriter {
+public:
+    TelemetryLogWriter() = default;
+    ~TelemetryLogWriter() { close(); }
+    
+    TelemetryLogWriter(const TelemetryLogWriter&) = delete;
+    TelemetryLogWriter& operator=(const TelemetryLogWriter&) = delete;
+    
+    bool open(const std::string& path, const std::vector<std::string>& channel_names,
+              double track_length, std::uint32_t block_samples = 8192,
+              CodecPredictor predictor = CodecPredictor::Adaptive);
+    
+    // Лог машины: каналы carTelemetryChannels(), время кадра в наносекундах
+    bool openCarLog(const std::string& path, double track_length, std::uint32_t block_samples = 8192) {
+        return open(path, carTelemetryChannels(), track_length, block_samples);
+    }
+    
+    void append(std::int64_t timestamp, const double* values);
+    void appendFrame(const TelemetryFrame& frame);
+    
+    // Дописывает последний блок, индекс и хвост. false - ошибка записи.
+    bool close();
+    
+    bool isOpen() const { return file != nullptr; }
+
+private:
+    void flushBlock();
+    
+    std::FILE* file = nullptr;
+    bool write_error = false;
+    int channel_count = 0;
+    std::uint32_t block_samples = 0;
+    CodecPredictor predictor = CodecPredictor::Adaptive;
+    std::unique_ptr<TelemetryEncoder> encoder;
+    TelemetryLogBlock current;
+    std::uint64_t offset = 0;
+    std::uint64_t samples = 0;
+    std::vector<TelemetryLogBlock> index;
+};
+
+// Чтение лога через mmap: заголовок и индекс разбираются при открытии,
+// блоки декодируются по запросу и независимо (можно из разных потоков)
+class TelemetryLog {
+public:
+    TelemetryLog() = default;
+    ~TelemetryLog() { close(); }
+    
+    TelemetryLog(const TelemetryLog&) = delete;
+    TelemetryLog& operator=(const TelemetryLog&) = delete;
+    
+    bool open(const std::string& path);     // false - нет файла или он не лог
+    void close();
+    
+    const std::vector<std::string>& channelNames() const { return channel_names; }
+    int channelIndex(const std::string& name) const;   // -1 - нет такого канала
+    double trackLength() const { return track_length; }
+    
+    const std::vector<TelemetryLogBlock>& blocks() const { return index; }
+    std::uint64_t sampleCount() const;
+    
+    // Блок с отсчетом на момент timestamp (последний, начавшийся не позже него)
+    std::size_t findBlock(std::int64_t timestamp) const;
+    
+    // Декодирует блок в колонки (буферы out переиспользуются). false - блок испорчен.
+    bool decodeBlock(std::size_t block, TelemetryColumns& out) const;
+
+private:
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+    std::vector<std::string> channel_names;
+    double track_length = 0.0;
+    std::vector<TelemetryLogBlock> index;
+};
+
+#endif // F1_TELEMETRY_LOG_H
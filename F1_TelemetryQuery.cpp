@@ -0,0 +1,450 @@
+#include "F1_TelemetryQuery.h"
+#include "F1_ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace {
+    const double NaN = std::numeric_limits<double>::quiet_NaN();
+    const double INF = std::numeric_limits<double>::infinity();
+    
+    // Отсчет, нужный для стыков блоков
+    struct EdgeSample {
+        double time = 0.0;
+        double lap_distance = 0.0;
+        double position = 0.0;
+        int lap = 0;
+    };
+    
+    // Пересечение линии (boundary = -1, начало круга lap) или конца сектора boundary
+    struct Crossing {
+        int lap;
+        int boundary;
+        double time;
+    };
+    
+    struct LapPartial {
+        int lap = 0;
+        ChannelStats stats;
+        std::vector<double> corner_min;
+        std::vector<double> corner_min_previous;    // Конец поворота прошлого круга за линией
+    };
+    
+    // ok - блок прочитан; пустой блок (без отсчетов) тоже ok, стыки его пропускают
+    struct BlockPartial {
+        bool ok = false;
+        bool empty = true;
+        std::vector<LapPartial> laps;
+        std::vector<Crossing> crossings;
+        EdgeSample first, last;
+    };
+    
+    double interpolateTime(double t0, double d0, double t1, double d1, double d) {
+        return d1 > d0 ? t0 + (d - d0) / (d1 - d0) * (t1 - t0) : t1;
+    }
+    
+    // Пересечения линии и концов секторов между двумя соседними отсчетами
+    void scanPair(const EdgeSample& a, const EdgeSample& b, double track_length,
+                  const std::vector<double>& ends, std::vector<Crossing>& out) {
+        if (b.lap == a.lap) {
+            for (int s = 0; s < static_cast<int>(ends.size()); s++) {
+                if (a.lap_distance < ends[s] && ends[s] <= b.lap_distance) {
+                    out.push_back({a.lap, s, interpolateTime(a.time, a.lap_distance, b.time, b.lap_distance, ends[s])});
+                }
+            }
+        } else if (b.lap == a.lap + 1) {
+            // Дистанция через линию: до нее track_length - a, после - b
+            double end = b.lap_distance + track_length;
+            out.push_back({b.lap, -1, interpolateTime(a.time, a.lap_distance, b.time, end, track_length)});
+            for (int s = 0; s < static_cast<int>(ends.size()); s++) {
+                if (a.lap_distance < ends[s]) {
+                    out.push_back({a.lap, s, interpolateTime(a.time, a.lap_distance, b.time, end, ends[s])});
+                }
+                if (ends[s] <= b.lap_distance) {
+                    out.push_back({b.lap, s, interpolateTime(a.time, a.lap_distance, b.time, end, ends[s] + track_length)});
+                }
+            }
+        }
+    }
+    
+    // Каналы с номером -1 не читаются
+    EdgeSample edgeSample(const TelemetryColumns& columns, std::size_t i, int lap_channel, int distance_channel,
+                          int position_channel) {
+        EdgeSample s;
+        s.time = columns.timestamps[i] * 1e-9;
+        s.lap = lap_channel >= 0 ? static_cast<int>(columns.channels[lap_channel][i]) : 0;
+        s.lap_distance = distance_channel >= 0 ? columns.channels[distance_channel][i] : 0.0;
+        s.position = position_channel >= 0 ? columns.channels[position_channel][i] : 0.0;
+        return s;
+    }
+    
+    // Агрегат по отрезку [begin, end) с фильтром. Условия - цепочкой выборов,
+    // без составных булевых масок: так цикл векторизуется.
+    ChannelStats aggregate(const double* values, const double* filter, std::size_t begin, std::size_t end,
+                           double filter_min, double filter_max) {
+        double lo = INF, hi = -INF, sum = 0.0, count = 0.0;
+        for (std::size_t i = begin; i < end; i++) {
+            double v = values[i];
+            double f = filter[i];
+            double in = f >= filter_min ? 1.0 : 0.0;
+            in = f <= filter_max ? in : 0.0;
+            double v_lo = in != 0.0 ? v : INF;
+            double v_hi = in != 0.0 ? v : -INF;
+            lo = v_lo < lo ? v_lo : lo;
+            hi = v_hi > hi ? v_hi : hi;
+            sum += in * v;
+            count += in;
+        }
+        ChannelStats stats;
+        stats.min = lo;
+        stats.max = hi;
+        stats.sum = sum;
+        stats.count = count;
+        return stats;
+    }
+    
+    // Минимум скорости на участке дистанции круга [from, to]
+    double minimumInRange(const double* speed, const double* distance, std::size_t begin, std::size_t end,
+                          double from, double to) {
+        double lo = INF;
+        for (std::size_t i = begin; i < end; i++) {
+            double d = distance[i];
+            double v = d >= from ? speed[i] : INF;
+            v = d <= to ? v : INF;
+            lo = v < lo ? v : lo;
+        }
+        return lo;
+    }
+}
+
+// === КРУГИ ===
+
+std::vector<LapReport> queryLaps(const TelemetryLog& log, const LapQuery& query) {
+    std::vector<LapReport> reports;
+    int lap_channel = log.channelIndex("lap");
+    int distance_channel = log.channelIndex("lap_distance");
+    int speed_channel = log.channelIndex("velocity");
+    int value_channel = log.channelIndex(query.channel);
+    int filter_channel = query.filter_channel.empty() ? value_channel : log.channelIndex(query.filter_channel);
+    if (lap_channel < 0 || distance_channel < 0 || speed_channel < 0 || value_channel < 0 || filter_channel < 0) {
+        return reports;
+    }
+    double filter_min = query.filter_channel.empty() ? -INF : query.filter_min;
+    double filter_max = query.filter_channel.empty() ? INF : query.filter_max;
+    
+    // Концы секторов внутри круга
+    double track_length = log.trackLength();
+    std::vector<double> ends = query.sector_ends;
+    if (ends.empty()) {
+        ends = {track_length / 3.0, 2.0 * track_length / 3.0};
+    }
+    ends.erase(std::remove_if(ends.begin(), ends.end(),
+                              [&](double d) { return !(d > 0.0 && d < track_length); }), ends.end());
+    std::sort(ends.begin(), ends.end());
+    std::size_t corner_count = query.track ? query.track->corners.size() : 0;
+    
+    // === Параллельный проход по блокам ===
+    const std::vector<TelemetryLogBlock>& blocks = log.blocks();
+    std::vector<BlockPartial> partials(blocks.size());
+    WorkStealingPool pool(query.threads);
+    std::vector<TelemetryColumns> scratch(pool.threadCount());
+    
+    pool.parallelFor(blocks.size(), 1, [&](std::size_t begin, std::size_t end, int worker) {
+        TelemetryColumns& columns = scratch[worker];
+        for (std::size_t b = begin; b < end; b++) {
+            BlockPartial& partial = partials[b];
+            if (!log.decodeBlock(b, columns)) {
+                continue;
+            }
+            partial.ok = true;
+            std::size_t n = columns.size();
+            if (n == 0) {
+                continue;
+            }
+            partial.empty = false;
+            const double* lap = columns.channels[lap_channel].data();
+            const double* distance = columns.channels[distance_channel].data();
+            const double* speed = columns.channels[speed_channel].data();
+            const double* values = columns.channels[value_channel].data();
+            const double* filter = columns.channels[filter_channel].data();
+            
+            // Отрезки одного круга: смена круга в блоке - редкость
+            for (std::size_t i = 0; i < n;) {
+                std::size_t j = i + 1;
+                while (j < n && lap[j] == lap[i]) {
+                    j++;
+                }
+                LapPartial lap_partial;
+                lap_partial.lap = static_cast<int>(lap[i]);
+                lap_partial.stats = aggregate(values, filter, i, j, filter_min, filter_max);
+                lap_partial.corner_min.resize(corner_count);
+                lap_partial.corner_min_previous.assign(corner_count, INF);
+                for (std::size_t c = 0; c < corner_count; c++) {
+                    const TrackCorner& corner = query.track->corners[c];
+                    double corner_end = corner.distance + corner.length;
+                    lap_partial.corner_min[c] = minimumInRange(speed, distance, i, j, corner.distance, corner_end);
+                    
+                    // Поворот через линию: его конец - в начале следующего круга
+                    if (corner_end > track_length) {
+                        lap_partial.corner_min_previous[c] = minimumInRange(speed, distance, i, j, 0.0,
+                                                                            corner_end - track_length);
+                    }
+                }
+                partial.laps.push_back(std::move(lap_partial));
+                i = j;
+            }
+            
+            // Пересечения внутри блока
+            EdgeSample previous = edgeSample(columns, 0, lap_channel, distance_channel, -1);
+            partial.first = previous;
+            for (std::size_t i = 1; i < n; i++) {
+                EdgeSample current = edgeSample(columns, i, lap_channel, distance_channel, -1);
+                scanPair(previous, current, track_length, ends, partial.crossings);
+                previous = current;
+            }
+            partial.last = previous;
+        }
+    });
+    
+    // === Слияние по порядку блоков ===
+    struct LapAccumulator {
+        ChannelStats stats;
+        std::vector<double> corner_min;
+        double start = NaN;
+        std::vector<double> boundary;
+    };
+    std::map<int, LapAccumulator> laps;
+    auto lapAt = [&](int lap) -> LapAccumulator& {
+        LapAccumulator& acc = laps[lap];
+        if (acc.boundary.empty()) {
+            acc.boundary.assign(ends.size(), NaN);
+            acc.corner_min.assign(corner_count, INF);
+        }
+        return acc;
+    };
+    
+    std::vector<Crossing> crossings;
+    const BlockPartial* previous = nullptr;     // Последний непустой блок
+    for (const BlockPartial& partial : partials) {
+        if (!partial.ok) {
+            return reports;
+        }
+        if (partial.empty) {
+            continue;
+        }
+        for (const LapPartial& lp : partial.laps) {
+            LapAccumulator& acc = lapAt(lp.lap);
+            acc.stats.merge(lp.stats);
+            auto previous_lap = laps.find(lp.lap - 1);
+            for (std::size_t c = 0; c < corner_count; c++) {
+                acc.corner_min[c] = std::min(acc.corner_min[c], lp.corner_min[c]);
+                if (previous_lap != laps.end()) {
+                    double& tail = previous_lap->second.corner_min[c];
+                    tail = std::min(tail, lp.corner_min_previous[c]);
+                }
+            }
+        }
+        if (!previous) {
+            // Лог начат со стартовой линии - начало первого круга известно
+            if (partial.first.lap_distance < 1.0) {
+                lapAt(partial.first.lap).start = partial.first.time;
+            }
+        } else {
+            scanPair(previous->last, partial.first, track_length, ends, crossings);
+        }
+        crossings.insert(crossings.end(), partial.crossings.begin(), partial.crossings.end());
+        previous = &partial;
+    }
+    for (const Crossing& c : crossings) {
+        LapAccumulator& acc = lapAt(c.lap);
+        if (c.boundary < 0) {
+            acc.start = c.time;
+        } else {
+            acc.boundary[c.boundary] = c.time;
+        }
+    }
+    
+    // === Отчет ===
+    for (auto it = laps.begin(); it != laps.end(); ++it) {
+        const LapAccumulator& acc = it->second;
+        auto next = laps.find(it->first + 1);
+        double finish = next != laps.end() ? next->second.start : NaN;
+        
+        LapReport report;
+        report.lap = it->first;
+        report.start_time = acc.start;
+        report.complete = !std::isnan(acc.start) && !std::isnan(finish);
+        report.lap_time = report.complete ? finish - acc.start : NaN;
+        report.stats = acc.stats;
+        
+        // Сектор s: от конца сектора s-1 (или линии) до конца сектора s (или линии)
+        double from = acc.start;
+        for (std::size_t s = 0; s <= ends.size(); s++) {
+            double to = s < ends.size() ? acc.boundary[s] : finish;
+            report.sector_times.push_back(to - from);   // NaN, если любой конец не найден
+            from = to;
+        }
+        for (double v : acc.corner_min) {
+            report.corner_min_speed.push_back(std::isinf(v) ? NaN : v);
+        }
+        reports.push_back(std::move(report));
+    }
+    return reports;
+}
+
+// === ДЕЛЬТА ===
+
+namespace {
+    // Время на сетке дистанции внутри блока и крайние отсчеты для стыков
+    struct GridPartial {
+        bool ok = false;
+        bool empty = true;
+        std::size_t first_index = 0;
+        std::vector<double> times;
+        EdgeSample first, last;
+    };
+    
+    void gridBlock(const TelemetryColumns& columns, int position_channel, double step, GridPartial& out) {
+        std::size_t n = columns.size();
+        const double* position = columns.channels[position_channel].data();
+        
+        // Точки сетки в [position[0], position[n-1]]
+        double first_grid = std::ceil(position[0] / step);
+        out.first_index = static_cast<std::size_t>(std::max(0.0, first_grid));
+        out.times.clear();
+        std::size_t k = 0;
+        for (std::size_t g = out.first_index; g * step <= position[n - 1]; g++) {
+            double d = g * step;
+            while (k + 1 < n && position[k + 1] < d) {
+                k++;
+            }
+            if (d <= position[0]) {
+                out.times.push_back(columns.timestamps[0] * 1e-9);
+            } else {
+                out.times.push_back(interpolateTime(columns.timestamps[k] * 1e-9, position[k],
+                                                    columns.timestamps[k + 1] * 1e-9, position[k + 1], d));
+            }
+        }
+    }
+    
+    // Сетка времени заезда: частичные результаты блоков и точки между блоками
+    std::vector<double> assembleGrid(const std::vector<GridPartial>& partials, double step) {
+        std::vector<double> grid;
+        const GridPartial* previous = nullptr;  // Последний непустой блок
+        for (const GridPartial& p : partials) {
+            if (!p.ok) {
+                return {};
+            }
+            if (p.empty) {
+                continue;
+            }
+            if (previous) {
+                const EdgeSample& a = previous->last;
+                for (std::size_t g = static_cast<std::size_t>(std::max(0.0, std::floor(a.position / step) + 1.0));
+                     g * step < p.first.position; g++) {
+                    if (grid.size() <= g) {
+                        grid.resize(g + 1, NaN);
+                    }
+                    grid[g] = interpolateTime(a.time, a.position, p.first.time, p.first.position, g * step);
+                }
+            }
+            if (grid.size() < p.first_index + p.times.size()) {
+                grid.resize(p.first_index + p.times.size(), NaN);
+            }
+            std::copy(p.times.begin(), p.times.end(), grid.begin() + p.first_index);
+            previous = &p;
+        }
+        return grid;
+    }
+}
+
+std::vector<DeltaPoint> queryDelta(const TelemetryLog& a, const TelemetryLog& b, double step, int threads) {
+    std::vector<DeltaPoint> result;
+    int position_a = a.channelIndex("position");
+    int position_b = b.channelIndex("position");
+    if (position_a < 0 || position_b < 0 || step <= 0.0) {
+        return result;
+    }
+    
+    // Блоки обоих логов одним параллельным проходом
+    std::size_t blocks_a = a.blocks().size();
+    std::size_t blocks_b = b.blocks().size();
+    std::vector<GridPartial> partials_a(blocks_a), partials_b(blocks_b);
+    WorkStealingPool pool(threads);
+    std::vector<TelemetryColumns> scratch(pool.threadCount());
+    
+    pool.parallelFor(blocks_a + blocks_b, 1, [&](std::size_t begin, std::size_t end, int worker) {
+        TelemetryColumns& columns = scratch[worker];
+        for (std::size_t i = begin; i < end; i++) {
+            bool first_log = i < blocks_a;
+            const TelemetryLog& log = first_log ? a : b;
+            std::size_t block = first_log ? i : i - blocks_a;
+            int channel = first_log ? position_a : position_b;
+            GridPartial& partial = first_log ? partials_a[block] : partials_b[block];
+            if (!log.decodeBlock(block, columns)) {
+                continue;
+            }
+            partial.ok = true;
+            if (columns.size() == 0) {
+                continue;
+            }
+            partial.empty = false;
+            gridBlock(columns, channel, step, partial);
+            partial.first = edgeSample(columns, 0, -1, -1, channel);
+            partial.last = edgeSample(columns, columns.size() - 1, -1, -1, channel);
+        }
+    });
+    
+    // Слияние сеток по дистанции
+    std::vector<double> grid_a = assembleGrid(partials_a, step);
+    std::vector<double> grid_b = assembleGrid(partials_b, step);
+    std::size_t count = std::min(grid_a.size(), grid_b.size());
+    for (std::size_t g = 0; g < count; g++) {
+        if (std::isnan(grid_a[g]) || std::isnan(grid_b[g])) {
+            continue;
+        }
+        DeltaPoint point;
+        point.distance = g * step;
+        point.time_a = grid_a[g];
+        point.time_b = grid_b[g];
+        point.delta = grid_b[g] - grid_a[g];
+        result.push_back(point);
+    }
+    return result;
+}
+
+std::vector<StreamingStats> queryChannelStats(const TelemetryLog& log, const StreamStatsConfig& config, int threads) {
+    const std::size_t channels = log.channelNames().size();
+    WorkStealingPool pool(threads);
+    std::vector<TelemetryColumns> scratch(pool.threadCount());
+    std::vector<std::vector<StreamingStats>> partials(pool.threadCount(),
+                                                     std::vector<StreamingStats>(channels, StreamingStats(config)));
+    std::vector<char> failed(log.blocks().size(), 0);
+    
+    pool.parallelFor(log.blocks().size(), 1, [&](std::size_t begin, std::size_t end, int worker) {
+        TelemetryColumns& columns = scratch[worker];
+        std::vector<StreamingStats>& stats = partials[worker];
+        for (std::size_t b = begin; b < end; b++) {
+            if (!log.decodeBlock(b, columns)) {
+                failed[b] = 1;
+                continue;
+            }
+            for (std::size_t c = 0; c < channels; c++) {
+                for (double value : columns.channels[c]) {
+                    stats[c].add(value);
+                }
+            }
+        }
+    });
+    
+    if (std::find(failed.begin(), failed.end(), 1) != failed.end()) {
+        return {};
+    }
+    std::vector<StreamingStats> result(channels, StreamingStats(config));
+    for (const std::vector<StreamingStats>& stats : partials) {
+        for (std::size_t c = 0; c < channels; c++) {
+            result[c].merge(stats[c]);
+        }
+    }
+    return result;
+}
@@ -0,0 +1,90 @@
+#ifndef F1_TELEMETRY_QUERY_H
+#define F1_TELEMETRY_QUERY_H
+
+#include <limits>
+#include <string>
+#include <vector>
+#include "F1_StreamStats.h"
+#include "F1_TelemetryLog.h"
+#include "F1_Track.h"
+
+// Запросы к логам телеметрии. Блоки лога разбираются параллельно
+// (WorkStealingPool), каждый блок дает частичный результат; частичные
+// результаты сливаются по порядку блоков, стыки блоков досчитываются при слиянии.
+
+// Агрегат канала: сливается между блоками
+struct ChannelStats {
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double sum = 0.0;
+    double count = 0.0;
+    
+    double mean() const { return count > 0 ? sum / count : 0.0; }
+    
+    void merge(const ChannelStats& other) {
+        min = other.min < min ? other.min : min;
+        max = other.max > max ? other.max : max;
+        sum += other.sum;
+        count += other.count;
+    }
+};
+
+struct LapQuery {
+    std::string channel = "velocity";   // Канал для min/max/mean по кругу
+    
+    // Фильтр отсчетов для агрегата: filter_min <= канал <= filter_max
+    // (пустое имя - без фильтра)
+    std::string filter_channel;
+    double filter_min = -std::numeric_limits<double>::infinity();
+    double filter_max = std::numeric_limits<double>::infinity();
+    
+    // Концы секторов по дистанции круга [м], кроме линии финиша.
+    // Пусто - три равных сектора.
+    std::vector<double> sector_ends;
+    
+    // Повороты для минимальной скорости в повороте (nullptr - не считать)
+    const Track* track = nullptr;
+    
+    int threads = 0;                    // 0 - все ядра
+};
+
+struct LapReport {
+    int lap = 0;
+    bool complete = false;              // Круг и начат, и закончен в логе
+    double start_time = 0.0;            // [с]
+    double lap_time = 0.0;              // [с], если complete
+    std::vector<double> sector_times;   // [с], NaN - сектор не пройден целиком
+    std::vector<double> corner_min_speed;   // [м/с] по поворотам трассы, NaN - не проехали
+    ChannelStats stats;                 // По каналу запроса с фильтром
+};
+
+// Разбивка лога по кругам: время круга и секторов (с интерполяцией момента
+// пересечения между отсчетами), минимальные скорости в поворотах и агрегат канала.
+// Поворот через линию старта целиком относится к кругу, в котором он начат.
+// Лог должен иметь каналы lap, lap_distance, velocity и канал запроса.
+// Пустой результат - нужных каналов нет или лог испорчен.
+std::vector<LapReport> queryLaps(const TelemetryLog& log, const LapQuery& query);
+
+// Разница по времени двух заездов на одной дистанции
+struct DeltaPoint {
+    double distance = 0.0;              // Общая дистанция от старта [м]
+    double time_a = 0.0;                // [с]
+    double time_b = 0.0;
+    double delta = 0.0;                 // time_b - time_a: > 0 - B медленнее
+};
+
+// Дельта B относительно A по сетке дистанции с шагом step [м]: каждый заезд
+// интерполируется на сетку по каналу position, затем сетки сливаются.
+std::vector<DeltaPoint> queryDelta(const TelemetryLog& a, const TelemetryLog& b,
+                                   double step = 10.0, int threads = 0);
+
+// Потоковая статистика всех каналов лога (по порядку channelNames): каждый
+// поток копит свои накопители по блокам, в конце они сливаются. Память -
+// накопитель на канал и поток, не зависит от длины лога. Счетчики квантилей
+// и min/max не зависят от числа потоков, среднее и дисперсия - с точностью
+// до округления. Пустой результат - лог испорчен.
+std::vector<StreamingStats> queryChannelStats(const TelemetryLog& log,
+                                              const StreamStatsConfig& config = StreamStatsConfig(),
+                                              int threads = 0);
+
+#endif // F1_TELEMETRY_QUERY_H
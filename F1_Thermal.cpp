@@ -0,0 +1,88 @@
+#include "F1_Thermal.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Температура тела с теплоемкостью capacity через time секунд при подводе
+    // power и теплоотдаче cooling: точное решение dT/dt = (P - h·(T - T_возд)) / C
+    double relax(double temperature, double ambient, double power, double cooling, double capacity, double time) {
+        double equilibrium = ambient + power / cooling;
+        return equilibrium + (temperature - equilibrium) * std::exp(-cooling * time / capacity);
+    }
+    
+    // Множитель μ: парабола вокруг оптимальной температуры с нижней границей
+    double tireGrip(double temperature, const ThermalParameters& p) {
+        double deviation = (temperature - p.tire_optimal_temperature) / p.tire_window;
+        return std::max(p.tire_min_grip_factor, 1.0 - p.tire_window_loss * deviation * deviation);
+    }
+    
+    // Эффективность тормоза: рост от холодного до рабочего, падение при перегреве
+    double brakeEfficiency(double temperature, const ThermalParameters& p) {
+        if (temperature < p.brake_warm_temperature) {
+            double warm = (temperature - p.ambient_temperature) / (p.brake_warm_temperature - p.ambient_temperature);
+            return p.brake_cold_efficiency + (1.0 - p.brake_cold_efficiency) * std::clamp(warm, 0.0, 1.0);
+        }
+        if (temperature > p.brake_fade_temperature) {
+            double fade = (temperature - p.brake_fade_temperature) /
+                          (p.brake_fade_end_temperature - p.brake_fade_temperature);
+            return 1.0 - (1.0 - p.brake_fade_efficiency) * std::min(fade, 1.0);
+        }
+        return 1.0;
+    }
+    
+    // Доля угла в тепле оси: front_share - доля передней оси, поровну на левое и правое колесо
+    double cornerShare(int corner, double front_share) {
+        return 0.5 * (corner < 2 ? front_share : 1.0 - front_share);
+    }
+    
+    void updateFactors(ThermalState& state, const ThermalParameters& p) {
+        state.grip_factor = 0.0;
+        state.brake_efficiency = 0.0;
+        for (int corner = 0; corner < 4; corner++) {
+            state.grip_factor += cornerShare(corner, p.tire_load_front) * tireGrip(state.tire_temperature[corner], p);
+            state.brake_efficiency += cornerShare(corner, p.brake_bias_front) *
+                                      brakeEfficiency(state.brake_temperature[corner], p);
+        }
+    }
+}
+
+void resetThermal(ThermalState& state, const ThermalParameters& params) {
+    state = ThermalState();
+    state.brake_temperature.fill(params.brake_initial_temperature);
+    state.tire_temperature.fill(params.tire_initial_temperature);
+    updateFactors(state, params);
+}
+
+void resetTireTemperatures(ThermalState& state, const ThermalParameters& params) {
+    state.tire_temperature.fill(params.tire_initial_temperature);
+    updateFactors(state, params);
+}
+
+bool updateThermal(ThermalState& state, const ThermalParameters& params) {
+    if (state.pending_time < params.update_interval || state.pending_time <= 0) {
+        return false;
+    }
+    
+    double time = state.pending_time;
+    double speed = state.pending_distance / time;
+    double brake_power = state.pending_brake_work / time;
+    double tire_power = params.tire_slip_heat * state.pending_tire_work / time;
+    double brake_cooling = params.brake_cooling + params.brake_cooling_per_speed * speed;
+    double tire_cooling = params.tire_cooling + params.tire_cooling_per_speed * speed;
+    
+    for (int corner = 0; corner < 4; corner++) {
+        state.brake_temperature[corner] = relax(state.brake_temperature[corner], params.ambient_temperature,
+                                                brake_power * cornerShare(corner, params.brake_bias_front),
+                                                brake_cooling, params.brake_heat_capacity, time);
+        state.tire_temperature[corner] = relax(state.tire_temperature[corner], params.ambient_temperature,
+                                               tire_power * cornerShare(corner, params.tire_load_front),
+                                               tire_cooling, params.tire_heat_capacity, time);
+    }
+    updateFactors(state, params);
+    
+    state.pending_brake_work = 0.0;
+    state.pending_tire_work = 0.0;
+    state.pending_distance = 0.0;
+    state.pending_time = 0.0;
+    return true;
+}
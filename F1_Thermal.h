@@ -0,0 +1,78 @@
+#ifndef F1_THERMAL_H
+#define F1_THERMAL_H
+
+#include <array>
+
+// Тепловая модель тормозов и шин по углам машины (0=FL, 1=FR, 2=RL, 3=RR,
+// как getWheelPositions). Тепло: работа тормозов (|F_торм|·v) по тормозному
+// балансу и доля работы в пятне контакта (проскальзывание) по нагрузке осей.
+// Охлаждение - конвекция, растущая со скоростью. Температуры возвращаются в
+// динамику множителями μ шин и тормозной силы.
+//
+// Физика шага копит только работу (как топливо и износ); температуры
+// считаются на своем грубом шаге update_interval по накопленному, точным
+// решением для экспоненты - устойчиво при любом шаге.
+
+struct ThermalParameters {
+    bool enabled = false;                   // Выключено - μ и тормоза постоянные
+    double update_interval = 0.5;           // Шаг тепловой модели [с] (не чаще медленного шага)
+    double ambient_temperature = 25.0;      // Воздух [°C]
+    double brake_bias_front = 0.58;         // Доля тормозного тепла на передней оси
+    double tire_load_front = 0.46;          // Доля работы шин на передней оси
+    
+    // Тормоза (диск с колодками, на угол)
+    double brake_heat_capacity = 1000.0;    // [Дж/°C]
+    double brake_cooling = 5.0;             // Теплоотдача стоя [Вт/°C]
+    double brake_cooling_per_speed = 0.6;   // Прирост теплоотдачи [Вт/°C на м/с]
+    double brake_initial_temperature = 300.0; // [°C]
+    double brake_warm_temperature = 400.0;  // Ниже - холодные, эффективность падает к brake_cold_efficiency
+    double brake_cold_efficiency = 0.8;     // Эффективность при температуре воздуха
+    double brake_fade_temperature = 1000.0; // Выше - перегрев, эффективность падает
+    double brake_fade_end_temperature = 1200.0;
+    double brake_fade_efficiency = 0.6;     // Эффективность при brake_fade_end_temperature и выше
+    
+    // Шины (на угол)
+    double tire_slip_heat = 0.08;           // Доля работы в пятне контакта, уходящая в тепло
+    double tire_heat_capacity = 12000.0;    // [Дж/°C]
+    double tire_cooling = 20.0;             // Теплоотдача стоя [Вт/°C]
+    double tire_cooling_per_speed = 1.0;    // Прирост теплоотдачи [Вт/°C на м/с]
+    double tire_initial_temperature = 80.0; // Из грелок [°C]
+    double tire_optimal_temperature = 100.0;
+    double tire_window = 30.0;              // Отклонение, при котором μ теряет tire_window_loss
+    double tire_window_loss = 0.08;
+    double tire_min_grip_factor = 0.7;      // Нижняя граница множителя μ
+};
+
+struct ThermalState {
+    std::array<double, 4> brake_temperature{};  // [°C]
+    std::array<double, 4> tire_temperature{};   // [°C]
+    double grip_factor = 1.0;           // Множитель μ шин (средний по нагрузке осей)
+    double brake_efficiency = 1.0;      // Множитель тормозной силы (средний по балансу)
+    
+    // Накоплено с прошлого теплового шага
+    double pending_brake_work = 0.0;    // Работа тормозов [Дж]
+    double pending_tire_work = 0.0;     // Работа в пятне контакта [Дж]
+    double pending_distance = 0.0;      // Путь [м] (для средней скорости охлаждения)
+    double pending_time = 0.0;          // [с]
+};
+
+// Начальные температуры (машина с грелками на стартовой решетке)
+void resetThermal(ThermalState& state, const ThermalParameters& params);
+
+// Новые шины - температура из грелок, тормоза не меняются
+void resetTireTemperatures(ThermalState& state, const ThermalParameters& params);
+
+// Вклад медленного шага: работа тормозов и шин за него, путь и время
+inline void accumulateThermal(ThermalState& state, double brake_work, double tire_work,
+                              double distance, double elapsed) {
+    state.pending_brake_work += brake_work;
+    state.pending_tire_work += tire_work;
+    state.pending_distance += distance;
+    state.pending_time += elapsed;
+}
+
+// Тепловой шаг, если накопилось update_interval: пересчитывает температуры,
+// grip_factor и brake_efficiency. false - еще рано, ничего не изменилось
+bool updateThermal(ThermalState& state, const ThermalParameters& params);
+
+#endif // F1_THERMAL_H
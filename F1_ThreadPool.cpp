@@ -0,0 +1,149 @@
+#include "F1_ThreadPool.h"
+#include <algorithm>
+#include <memory>
+
+namespace {
+    // Остаток диапазона одного потока (на своей кэш-линии, чтобы потоки не мешали друг другу)
+    struct alignas(64) WorkerRange {
+        std::mutex mutex;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+}
+
+// Один parallelFor: диапазоны потоков и тело цикла
+struct WorkStealingPool::Job {
+    std::unique_ptr<WorkerRange[]> ranges;
+    int workers = 0;
+    std::size_t grain = 1;
+    const std::function<void(std::size_t, std::size_t, int)>* body = nullptr;
+    
+    // Цикл потока self: свои куски, затем кража, пока работа есть у кого-то
+    void run(int self) {
+        while (true) {
+            std::size_t begin = 0, end = 0;
+            
+            // 1. Свой кусок с начала остатка
+            {
+                std::lock_guard<std::mutex> lock(ranges[self].mutex);
+                if (ranges[self].begin < ranges[self].end) {
+                    begin = ranges[self].begin;
+                    end = std::min(ranges[self].end, begin + grain);
+                    ranges[self].begin = end;
+                }
+            }
+            
+            // 2. Свое кончилось - крадем половину чужого остатка
+            if (begin == end) {
+                for (int i = 1; i < workers && begin == end; i++) {
+                    int victim = (self + i) % workers;
+                    std::lock_guard<std::mutex> lock(ranges[victim].mutex);
+                    std::size_t remaining = ranges[victim].end - ranges[victim].begin;
+                    if (remaining == 0) {
+                        continue;
+                    }
+                    std::size_t mid = ranges[victim].begin + remaining / 2;
+                    begin = mid;
+                    end = ranges[victim].end;
+                    ranges[victim].end = mid;
+                }
+                if (begin == end) {
+                    return;  // Работы не осталось ни у кого
+                }
+                
+                // Украденное кладем себе, первый кусок выполняем сразу
+                std::lock_guard<std::mutex> lock(ranges[self].mutex);
+                ranges[self].begin = std::min(end, begin + grain);
+                ranges[self].end = end;
+                end = ranges[self].begin;
+            }
+            
+            (*body)(begin, end, self);
+        }
+    }
+};
+
+WorkStealingPool::WorkStealingPool(int thread_count) : thread_count(thread_count) {
+    if (this->thread_count <= 0) {
+        this->thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    helpers.reserve(this->thread_count - 1);
+    for (int w = 1; w < this->thread_count; w++) {
+        helpers.emplace_back(&WorkStealingPool::helperMain, this, w);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : helpers) {
+        t.join();
+    }
+}
+
+void WorkStealingPool::helperMain(int self) {
+    std::uint64_t seen = 0;
+    while (true) {
+        Job* current;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+            current = job;
+        }
+        
+        // Кусков меньше, чем потоков: лишние помощники только отмечаются
+        if (self < current->workers) {
+            current->run(self);
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busy == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+void WorkStealingPool::parallelFor(std::size_t count, std::size_t grain,
+                                   const std::function<void(std::size_t, std::size_t, int)>& body) {
+    if (count == 0) {
+        return;
+    }
+    Job current;
+    current.grain = std::max<std::size_t>(1, grain);
+    current.workers = static_cast<int>(std::min<std::size_t>(thread_count, (count + current.grain - 1) / current.grain));
+    current.body = &body;
+    
+    // Начальная раздача поровну
+    current.ranges.reset(new WorkerRange[current.workers]);
+    for (int w = 0; w < current.workers; w++) {
+        current.ranges[w].begin = count * w / current.workers;
+        current.ranges[w].end = count * (w + 1) / current.workers;
+    }
+    
+    // Один поток - без пробуждения помощников
+    if (current.workers == 1) {
+        current.run(0);
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &current;
+        busy = static_cast<int>(helpers.size());
+        generation++;
+    }
+    wake.notify_all();
+    current.run(0);
+    
+    // Диапазоны и тело живут на этом стеке - ждем всех помощников
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&] { return busy == 0; });
+    job = nullptr;
+}
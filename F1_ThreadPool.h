@@ -0,0 +1,53 @@
+#ifndef F1_THREAD_POOL_H
+#define F1_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул с кражей работы для параллельных циклов по индексам.
+// Каждый поток начинает со своей части диапазона и берет из нее куски по grain
+// с начала; освободившийся поток забирает у соседа вторую половину его остатка.
+// Тяжелые и легкие элементы так выравниваются без центральной очереди.
+//
+// Потоки живут, пока жив пул: между циклами спят на условной переменной,
+// и повторный parallelFor не создает потоков. Поток, вызвавший parallelFor,
+// работает как поток 0. Цикл за раз один: parallelFor - из одного потока.
+class WorkStealingPool {
+public:
+    // 0 - по числу аппаратных потоков
+    explicit WorkStealingPool(int thread_count = 0);
+    ~WorkStealingPool();
+    
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    
+    int threadCount() const { return thread_count; }
+    
+    // Вызывает body(begin, end, worker) для кусков [0, count); возвращается, когда все выполнено.
+    // worker - номер потока [0, threadCount()), удобен для потоковых накопителей.
+    void parallelFor(std::size_t count, std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t, int)>& body);
+
+private:
+    struct Job;
+    
+    void helperMain(int self);
+    
+    int thread_count;
+    std::vector<std::thread> helpers;   // Потоки 1..thread_count-1
+    
+    std::mutex mutex;
+    std::condition_variable wake;       // Новый цикл или остановка
+    std::condition_variable finished;   // Последний помощник закончил цикл
+    Job* job = nullptr;                 // Текущий цикл (живет на стеке parallelFor)
+    std::uint64_t generation = 0;       // Номер цикла: помощник берет каждый один раз
+    int busy = 0;                       // Помощников, еще не закончивших цикл
+    bool stopping = false;
+};
+
+#endif // F1_THREAD_POOL_H
@@ -0,0 +1,223 @@
+#include "F1_TopSpeed.h"
+#include "F1_PhysicsCore.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+using f1core::RAD_S_TO_RPM;
+
+namespace {
+    constexpr int SCAN_SEGMENTS = 64;       // Грубый проход до первой смены знака
+    constexpr int MAX_ITERATIONS = 100;
+    constexpr double SPEED_TOLERANCE = 1e-9; // [м/с]
+    
+    // Обороты коленвала на скорости speed при замкнутом сцеплении
+    double engineRpm(const F1PhysicsEngine::CarParameters& car, double gear_factor, double speed) {
+        return speed / car.wheel_radius * gear_factor * RAD_S_TO_RPM;
+    }
+    
+    double speedAtRpm(const F1PhysicsEngine::CarParameters& car, double gear_factor, double rpm) {
+        return rpm / RAD_S_TO_RPM * car.wheel_radius / gear_factor;
+    }
+    
+    // Тяга минус сопротивление, как в шаге движка на полном газу при замкнутом
+    // сцеплении. rev_limiter = false - кривая момента продолжается за max_rpm
+    // (до нуля момента): так находится баланс тяги и сопротивления
+    double netForce(const F1PhysicsEngine::CarParameters& car, double gear_factor, double speed,
+                    const EquilibriumConfig& config, bool rev_limiter) {
+        double rpm = engineRpm(car, gear_factor, speed);
+        double engine_torque = 0.0;
+        if (rpm >= car.null_rpm && !(rev_limiter && rpm >= car.max_rpm)) {
+            engine_torque = std::max(0.0, f1core::torqueCurve(rpm, car.peak_rpm, car.max_rpm, car.max_torque));
+        }
+        double friction_torque = car.engine_friction_torque * rpm / car.max_rpm;
+        
+        double ers_torque = 0.0;
+        if (config.ers_deploy && rpm > 0) {
+            ers_torque = std::min(car.ers.mguk_max_torque, car.ers.mguk_max_power / (rpm / RAD_S_TO_RPM));
+        }
+        
+        // Лимит сцепления с прижимом (прижимная сила отрицательная)
+        double down_force = f1core::aeroForce(0.5 * car.air_density * car.downforce_coefficient * car.frontal_area,
+                                              speed);
+        double max_traction = car.tire_friction * ((car.mass + config.fuel_mass) * 9.81 - down_force);
+        double traction = (engine_torque - friction_torque + ers_torque) * gear_factor / car.wheel_radius;
+        traction = std::clamp(traction, -max_traction, max_traction);
+        
+        double drag = f1core::aeroForce(0.5 * car.air_density * car.drag_coefficient * car.frontal_area, speed);
+        return traction - drag;
+    }
+    
+    // Первый корень netForce выше lo (f(lo) > 0): до него машина разгоняется
+    // с lo, на нем останавливается. Смена знака внутри одного отрезка грубого
+    // прохода туда и обратно пропускается - у гладкой кривой момента ее нет.
+    // 0 - сопротивление не догоняет тягу до hi
+    double firstRoot(const F1PhysicsEngine::CarParameters& car, double gear_factor, double lo, double hi,
+                     const EquilibriumConfig& config) {
+        auto f = [&](double v) { return netForce(car, gear_factor, v, config, false); };
+        
+        double a = lo;
+        double fa = f(a);
+        double b = a;
+        double fb = fa;
+        for (int i = 1; i <= SCAN_SEGMENTS && fb > 0; i++) {
+            a = b;
+            fa = fb;
+            b = lo + (hi - lo) * i / SCAN_SEGMENTS;
+            fb = f(b);
+        }
+        if (fb > 0) {
+            return 0.0;
+        }
+        
+        // Регула фальси с правкой Иллинойс: у конца, который держится два
+        // шага подряд, значение делится пополам - скобка сходится с двух сторон
+        int kept = 0;                   // +1 - дважды сдвигался b, -1 - a
+        double c = b;
+        for (int iteration = 0; iteration < MAX_ITERATIONS && b - a > SPEED_TOLERANCE; iteration++) {
+            c = (a * fb - b * fa) / (fb - fa);
+            double fc = f(c);
+            if (fc == 0.0) {
+                return c;
+            }
+            if (fc > 0) {
+                a = c;
+                fa = fc;
+                if (kept == -1) {
+                    fb *= 0.5;
+                }
+                kept = -1;
+            } else {
+                b = c;
+                fb = fc;
+                if (kept == 1) {
+                    fa *= 0.5;
+                }
+                kept = 1;
+            }
+        }
+        return 0.5 * (a + b);
+    }
+    
+    // 64-битный FNV-1a
+    std::uint64_t fnv1a(const void* data, std::size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        std::uint64_t hash = 14695981039346656037ull;
+        for (std::size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+}
+
+// === РЕШЕНИЕ ===
+
+double equilibriumNetForce(const F1PhysicsEngine::CarParameters& car, int gear, double speed,
+                           const EquilibriumConfig& config) {
+    double gear_factor = car.gear_ratios[gear - 1] * car.final_drive;
+    return netForce(car, gear_factor, speed, config, true);
+}
+
+GearLimit solveGearLimit(const F1PhysicsEngine::CarParameters& car, int gear, const EquilibriumConfig& config) {
+    GearLimit limit;
+    limit.gear = gear;
+    double gear_factor = car.gear_ratios[gear - 1] * car.final_drive;
+    limit.min_speed = speedAtRpm(car, gear_factor, car.null_rpm);
+    limit.rev_limit_speed = speedAtRpm(car, gear_factor, car.max_rpm);
+    
+    // Верх скобки: момент по кривой уходит в ноль; если MGU-K тянет и дальше,
+    // отодвигаем, пока сопротивление (растет как v²) не перевесит
+    double zero_torque_rpm = car.peak_rpm + (car.max_rpm - car.peak_rpm) / 0.4;
+    double hi = speedAtRpm(car, gear_factor, zero_torque_rpm);
+    for (int i = 0; i < 30 && netForce(car, gear_factor, hi, config, false) > 0; i++) {
+        hi *= 2.0;
+    }
+    
+    if (netForce(car, gear_factor, limit.min_speed, config, false) > 0) {
+        limit.balance_speed = firstRoot(car, gear_factor, limit.min_speed, hi, config);
+    }
+    if (limit.balance_speed <= 0) {
+        return limit;                   // Передача не тянет: скорость падает ниже min_speed
+    }
+    
+    limit.rev_limited = limit.balance_speed >= limit.rev_limit_speed;
+    limit.top_speed = limit.rev_limited ? limit.rev_limit_speed : limit.balance_speed;
+    limit.top_speed_rpm = engineRpm(car, gear_factor, limit.top_speed);
+    return limit;
+}
+
+TopSpeedResult solveTopSpeed(const F1PhysicsEngine::CarParameters& car, const EquilibriumConfig& config) {
+    TopSpeedResult result;
+    result.gear_count = std::min(car.gear_count, static_cast<int>(result.gears.size()));
+    for (int gear = 1; gear <= result.gear_count; gear++) {
+        GearLimit& limit = result.gears[gear - 1];
+        limit = solveGearLimit(car, gear, config);
+        if (limit.top_speed > result.top_speed) {
+            result.top_speed = limit.top_speed;
+            result.top_speed_rpm = limit.top_speed_rpm;
+            result.top_gear = gear;
+        }
+    }
+    return result;
+}
+
+// === КЭШ ===
+
+const TopSpeedResult& TopSpeedCache::solve(const F1PhysicsEngine::CarParameters& car,
+                                           const EquilibriumConfig& config) {
+    Key key = makeKey(car, config);
+    auto found = results.find(key);
+    if (found != results.end()) {
+        hit_count++;
+        return found->second;
+    }
+    miss_count++;
+    return results.emplace(key, solveTopSpeed(car, config)).first->second;
+}
+
+void TopSpeedCache::clear() {
+    results.clear();
+    hit_count = 0;
+    miss_count = 0;
+}
+
+std::size_t TopSpeedCache::KeyHash::operator()(const Key& key) const {
+    return static_cast<std::size_t>(fnv1a(key.data(), sizeof(Key)));
+}
+
+bool TopSpeedCache::KeyEqual::operator()(const Key& a, const Key& b) const {
+    // Побайтово, как хэш: -0.0 и 0.0 - разные ключи, NaN равен себе
+    return std::memcmp(a.data(), b.data(), sizeof(Key)) == 0;
+}
+
+TopSpeedCache::Key TopSpeedCache::makeKey(const F1PhysicsEngine::CarParameters& car,
+                                          const EquilibriumConfig& config) {
+    int gear_count = std::min(car.gear_count, static_cast<int>(car.gear_ratios.size()));
+    Key key{};
+    std::size_t n = 0;
+    for (int gear = 0; gear < gear_count; gear++) {
+        key[n + gear] = car.gear_ratios[gear];
+    }
+    n += car.gear_ratios.size();
+    key[n++] = gear_count;
+    key[n++] = car.final_drive;
+    key[n++] = car.wheel_radius;
+    key[n++] = car.mass;
+    key[n++] = car.max_rpm;
+    key[n++] = car.max_torque;
+    key[n++] = car.peak_rpm;
+    key[n++] = car.null_rpm;
+    key[n++] = car.engine_friction_torque;
+    key[n++] = car.drag_coefficient;
+    key[n++] = car.frontal_area;
+    key[n++] = car.air_density;
+    key[n++] = car.downforce_coefficient;
+    key[n++] = car.tire_friction;
+    key[n++] = car.ers.mguk_max_power;
+    key[n++] = car.ers.mguk_max_torque;
+    key[n++] = config.ers_deploy ? 1.0 : 0.0;
+    key[n++] = config.fuel_mass;
+    return key;
+}
@@ -0,0 +1,89 @@
+#ifndef F1_TOP_SPEED_H
+#define F1_TOP_SPEED_H
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include "F1_Physics_build_2.h"
+
+// Максимальная скорость без прогона движка. На установившейся скорости
+// сцепление замкнуто, ускорение ноль, и скорость - корень уравнения
+// тяга(v) = сопротивление(v) на передаче: тяга - по кривой момента f1core
+// через gear_ratios, final_drive и wheel_radius за вычетом трения ДВС,
+// с MGU-K и лимитом сцепления (с прижимом), сопротивление - та же
+// квадратичная формула, что у движка. Корень ищется на отрезке оборотов
+// передачи: грубый проход до первой смены знака и уточнение регула фальси.
+//
+// Аэродинамика - постоянные коэффициенты (без карты, DRS и слипстрима),
+// шины новые. Отсечка: на max_rpm момент пропадает, и скорость передачи
+// упирается в обороты (движок колеблется в пределах гистерезиса ниже).
+
+struct EquilibriumConfig {
+    bool ers_deploy = true;             // MGU-K на полной отдаче (батарея не кончается)
+    double fuel_mass = 0.0;             // Топливо [кг] (влияет только на лимит сцепления)
+};
+
+// Предел одной передачи
+struct GearLimit {
+    int gear = 0;
+    double min_speed = 0.0;             // Скорость на null_rpm (ниже сцепление размыкается) [м/с]
+    double rev_limit_speed = 0.0;       // Скорость на max_rpm [м/с]
+    double balance_speed = 0.0;         // Тяга = сопротивление (кривая момента продолжена за отсечку);
+                                        // 0 - тяги не хватает уже на min_speed
+    double top_speed = 0.0;             // Установившаяся скорость: min(отсечка, баланс) [м/с]
+    double top_speed_rpm = 0.0;         // Обороты на ней
+    bool rev_limited = false;           // Уперлась в отсечку, запас тяги остался
+};
+
+struct TopSpeedResult {
+    std::array<GearLimit, 8> gears{};   // Первые gear_count
+    int gear_count = 0;
+    double top_speed = 0.0;             // Лучшая из передач [м/с]
+    double top_speed_rpm = 0.0;
+    int top_gear = 0;                   // 0 - ни на одной передаче машина не едет
+};
+
+// Продольная сила на установившейся скорости: тяга минус сопротивление [Н]
+// (с отсечкой; rpm вне диапазона передачи не проверяются)
+double equilibriumNetForce(const F1PhysicsEngine::CarParameters& car, int gear, double speed,
+                           const EquilibriumConfig& config = EquilibriumConfig());
+
+GearLimit solveGearLimit(const F1PhysicsEngine::CarParameters& car, int gear,
+                         const EquilibriumConfig& config = EquilibriumConfig());
+TopSpeedResult solveTopSpeed(const F1PhysicsEngine::CarParameters& car,
+                             const EquilibriumConfig& config = EquilibriumConfig());
+
+// Кэш решений по параметрам машины: ключ - только поля, от которых зависит
+// равновесие (развертка по расходу топлива или износу попадает в кэш),
+// неиспользуемые передаточные числа обнуляются. Хэш FNV-1a по байтам
+// ключа, сравнение побайтовое. Не потокобезопасен: кэш на поток.
+class TopSpeedCache {
+public:
+    // Ссылка действительна до clear()
+    const TopSpeedResult& solve(const F1PhysicsEngine::CarParameters& car,
+                                const EquilibriumConfig& config = EquilibriumConfig());
+    
+    std::size_t hits() const { return hit_count; }
+    std::size_t misses() const { return miss_count; }
+    std::size_t size() const { return results.size(); }
+    void clear();
+
+private:
+    static constexpr std::size_t KEY_SIZE = 26;
+    using Key = std::array<double, KEY_SIZE>;
+    
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+    struct KeyEqual {
+        bool operator()(const Key& a, const Key& b) const;
+    };
+    
+    static Key makeKey(const F1PhysicsEngine::CarParameters& car, const EquilibriumConfig& config);
+    
+    std::unordered_map<Key, TopSpeedResult, KeyHash, KeyEqual> results;
+    std::size_t hit_count = 0;
+    std::size_t miss_count = 0;
+};
+
+#endif // F1_TOP_SPEED_H
@@ -0,0 +1,16 @@
+#include "F1_Track.h"
+
+Track Track::demoCircuit() {
+    Track track;
+    track.name = "Demo Circuit";
+    track.length = 5000.0;
+    track.corners = {
+        {  600.0, 100.0,  25.0 },   // Шпилька после старта
+        { 1400.0, 150.0, 120.0 },
+        { 2300.0,  80.0,  40.0 },
+        { 3100.0, 200.0, 250.0 },   // Скоростная дуга
+        { 4000.0, 120.0,  60.0 },
+        { 4600.0, 100.0,  80.0 },   // Выход на стартовую прямую
+    };
+    return track;
+}
@@ -0,0 +1,59 @@
+#ifndef F1_TRACK_H
+#define F1_TRACK_H
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+// Поворот трассы (в 1D модели - участок с ограничением скорости)
+struct TrackCorner {
+    double distance;    // Начало поворота от линии старта [м]
+    double length;      // Длина дуги [м]
+    double radius;      // Радиус [м]
+};
+
+// Кольцевая трасса: длина круга и повороты по порядку дистанции
+struct Track {
+    std::string name;
+    double length = 5000.0;             // Длина круга [м]
+    std::vector<TrackCorner> corners;
+    
+    // Предельная скорость в повороте при данном сцеплении: v = sqrt(μ·g·R)
+    double cornerSpeed(int corner, double grip) const {
+        return std::sqrt(grip * 9.81 * corners[corner].radius);
+    }
+    
+    // Ближайший поворот, который еще не пройден (после последнего - первый следующего круга)
+    int nextCorner(double lap_distance) const {
+        for (int i = 0; i < static_cast<int>(corners.size()); i++) {
+            if (lap_distance < corners[i].distance + corners[i].length) {
+                return i;
+            }
+        }
+        return 0;
+    }
+    
+    // Дистанция до начала поворота с учетом перехода через линию (0 - уже в повороте)
+    double distanceTo(int corner, double lap_distance) const {
+        double d = corners[corner].distance - lap_distance;
+        if (d < -corners[corner].length) {
+            d += length;
+        }
+        return d > 0 ? d : 0.0;
+    }
+    
+    // Машина в дуге поворота (дистанция - от линии старта, в пределах круга)
+    bool inCorner(double lap_distance) const {
+        for (const TrackCorner& corner : corners) {
+            if (lap_distance >= corner.distance && lap_distance < corner.distance + corner.length) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    // Тестовая трасса на 5 км с шестью поворотами разной скорости
+    static Track demoCircuit();
+};
+
+#endif // F1_TRACK_H
@@ -0,0 +1,693 @@
+#include "F1_Tuning.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "F1_Dual.h"
+#include "F1_PhysicsCore.h"
+
+using CarParameters = F1PhysicsEngine::CarParameters;
+
+// === ПАРАМЕТРЫ ===
+
+const char* tuningParameterName(int parameter) {
+    static const char* const names[TUNE_PARAMETER_COUNT] = {
+        "final_drive", "max_torque", "peak_rpm", "null_rpm", "mass",
+        "drag_coefficient", "downforce_coefficient", "frontal_area", "tire_friction", "max_brake_force"
+    };
+    return parameter >= 0 && parameter < TUNE_PARAMETER_COUNT ? names[parameter] : "?";
+}
+
+double& tuningParameter(CarParameters& car, int parameter) {
+    switch (parameter) {
+        case TUNE_FINAL_DRIVE:           return car.final_drive;
+        case TUNE_MAX_TORQUE:            return car.max_torque;
+        case TUNE_PEAK_RPM:              return car.peak_rpm;
+        case TUNE_NULL_RPM:              return car.null_rpm;
+        case TUNE_MASS:                  return car.mass;
+        case TUNE_DRAG_COEFFICIENT:      return car.drag_coefficient;
+        case TUNE_DOWNFORCE_COEFFICIENT: return car.downforce_coefficient;
+        case TUNE_FRONTAL_AREA:          return car.frontal_area;
+        case TUNE_TIRE_FRICTION:         return car.tire_friction;
+        default:                         return car.max_brake_force;   // TUNE_MAX_BRAKE_FORCE
+    }
+}
+
+double tuningParameter(const CarParameters& car, int parameter) {
+    return tuningParameter(const_cast<CarParameters&>(car), parameter);
+}
+
+// === ДВИЖОК НА СКАЛЯРЕ T ===
+
+namespace {
+    constexpr double GRAVITY = 9.81;
+    
+    // Настраиваемый параметр на скаляре T: для Dual - переменная номер slot
+    // (slot < 0 - константа), для double - само значение
+    template <typename T>
+    struct Seed {
+        static T make(double value, int) { return value; }
+    };
+    
+    template <int N>
+    struct Seed<Dual<N>> {
+        static Dual<N> make(double value, int slot) {
+            return slot >= 0 ? Dual<N>::variable(value, slot) : Dual<N>(value);
+        }
+    };
+    
+    using Slots = std::array<int, TUNE_PARAMETER_COUNT>;    // Номер производной параметра (-1 - без нее)
+    
+    // Сопротивление по поляре: одна формула для движка на double и на Dual
+    template <typename T>
+    T polarDrag(const T& drag, const T& lift, double induced_drag) {
+        return drag + lift * lift * induced_drag;
+    }
+    
+    // Поля CarParameters, которые читают f1core::step и пилот: настраиваемые - T
+    template <typename T>
+    struct ScalarParameters {
+        double wheel_radius;
+        T mass;
+        double max_rpm;
+        T max_torque;
+        T peak_rpm;
+        T null_rpm;
+        double engine_inertia;
+        double engine_friction_torque;
+        double rev_limiter_hysteresis;
+        double clutch_max_torque;
+        double launch_rpm;
+        double clutch_lock_rpm;
+        std::array<double, 8> gear_ratios;
+        int gear_count;
+        T final_drive;
+        T drag_coefficient;             // С индуктивной частью поляры
+        T frontal_area;
+        double air_density;
+        T downforce_coefficient;
+        T tire_friction;
+        T max_brake_force;
+        double brake_factor_coef;
+        ErsParameters ers;
+        double fuel_initial_mass;
+        double fuel_work_per_kg;
+        double tire_wear_per_joule;
+        double tire_grip_loss;
+        double slow_update_interval;
+        double track_length;
+    };
+    
+    template <typename T>
+    ScalarParameters<T> makeParameters(const CarParameters& car, const TuningConfig& config, const Slots& slots) {
+        auto tuned = [&](int parameter) { return Seed<T>::make(tuningParameter(car, parameter), slots[parameter]); };
+        ScalarParameters<T> p{};
+        p.wheel_radius = car.wheel_radius;
+        p.mass = tuned(TUNE_MASS);
+        p.max_rpm = car.max_rpm;
+        p.max_torque = tuned(TUNE_MAX_TORQUE);
+        p.peak_rpm = tuned(TUNE_PEAK_RPM);
+        p.null_rpm = tuned(TUNE_NULL_RPM);
+        p.engine_inertia = car.engine_inertia;
+        p.engine_friction_torque = car.engine_friction_torque;
+        p.rev_limiter_hysteresis = car.rev_limiter_hysteresis;
+        p.clutch_max_torque = car.clutch_max_torque;
+        p.launch_rpm = car.launch_rpm;
+        p.clutch_lock_rpm = car.clutch_lock_rpm;
+        p.gear_ratios = car.gear_ratios;
+        p.gear_count = car.gear_count;
+        p.final_drive = tuned(TUNE_FINAL_DRIVE);
+        p.downforce_coefficient = tuned(TUNE_DOWNFORCE_COEFFICIENT);
+        p.drag_coefficient = polarDrag(tuned(TUNE_DRAG_COEFFICIENT), p.downforce_coefficient, config.induced_drag);
+        p.frontal_area = tuned(TUNE_FRONTAL_AREA);
+        p.air_density = car.air_density;
+        p.tire_friction = tuned(TUNE_TIRE_FRICTION);
+        p.max_brake_force = tuned(TUNE_MAX_BRAKE_FORCE);
+        p.brake_factor_coef = car.brake_factor_coef;
+        p.ers = car.ers;
+        p.fuel_initial_mass = car.fuel_initial_mass;
+        p.fuel_work_per_kg = car.fuel_work_per_kg;
+        p.tire_wear_per_joule = car.tire_wear_per_joule;
+        p.tire_grip_loss = car.tire_grip_loss;
+        p.slow_update_interval = car.slow_update_interval;
+        p.track_length = car.track_length;
+        return p;
+    }
+    
+    // Машина для настоящего F1PhysicsEngine: поляра - в drag_coefficient,
+    // температуры выключены (как у движка на Dual)
+    CarParameters engineParameters(const CarParameters& car, const TuningConfig& config) {
+        CarParameters engine_car = car;
+        engine_car.drag_coefficient = polarDrag(car.drag_coefficient, car.downforce_coefficient, config.induced_drag);
+        engine_car.thermal.enabled = false;
+        return engine_car;
+    }
+    
+    // F1PhysicsEngine на скаляре T: поля CarState/SlowState/ForceBreakdown
+    // на T (поля float движка - T, округленные storeNarrow) и политика машины
+    // для f1core::step без карт, слипстрима и температур. Интерфейс прогона -
+    // как у F1PhysicsEngine, чтобы один код гонял оба.
+    template <typename T>
+    class ScalarEngine {
+    public:
+        struct Axis {
+            T x = 0.0;
+        };
+        
+        struct CarState {
+            Axis position;
+            Axis velocity;
+            T engine_rpm = 0.0;
+            T down_force = 0.0;
+            T battery_energy = 0.0;
+            double time = 0.0;
+            T lap_distance = 0.0;
+            T mass = 0.0;
+            T tire_grip = 0.0;
+            double slow_timer = 0.0;
+            T brake_factor = 0.0;           // float в CarState
+            T lap_deployed_energy = 0.0;    // float
+            T lap_harvested_energy = 0.0;   // float
+            T pending_engine_work = 0.0;    // float
+            T pending_tire_work = 0.0;      // float
+            int lap = 0;
+            int current_gear = 1;
+            bool clutch_locked = false;
+            bool rev_limiter_active = false;
+            bool out_of_fuel = false;
+        };
+        
+        struct SlowState {
+            T fuel_mass = 0.0;
+            T tire_wear = 0.0;
+            double lap_start_time = 0.0;
+            double last_lap_time = 0.0;
+        };
+        
+        struct ForceBreakdown {
+            T engine_torque = 0.0;
+            T clutch_torque = 0.0;
+            T ers_torque = 0.0;
+            T wheel_torque = 0.0;
+            T traction_force = 0.0;
+            T drag_force = 0.0;
+            T brake_force = 0.0;
+            T down_force = 0.0;
+            T acceleration = 0.0;
+        };
+        
+        explicit ScalarEngine(const ScalarParameters<T>& parameters) : p(parameters) {
+            // Передаточные числа и приведенная инерция - как F1PhysicsEngine::updateGearCache
+            for (int g = 0; g < p.gear_count; g++) {
+                gear_factor[g] = p.gear_ratios[g] * p.final_drive;
+                T ratio_per_radius = gear_factor[g] / p.wheel_radius;
+                inertia_mass[g] = p.engine_inertia * ratio_per_radius * ratio_per_radius;
+            }
+            
+            // F1PhysicsEngine::reset
+            state.engine_rpm = p.null_rpm;
+            state.battery_energy = p.ers.battery_initial_energy;
+            slow.fuel_mass = p.fuel_initial_mass;
+            f1core::slowStage(*this, state);
+        }
+        
+        void update(double dt, const T& throttle, const T& brake) {
+            last_step = {dt, throttle, brake, state.engine_rpm};
+            ForceBreakdown forces;
+            f1core::NoStageClock clock;
+            f1core::step(*this, state, forces, throttle, brake, dt, clock);
+        }
+        
+        // Переключение по порогу оборотов (direction: +1 вверх, -1 вниз).
+        // Движок переключает на границе шага, а порог обороты прошли внутри
+        // прошлого шага, за долю late до его конца. Значения остаются как у
+        // F1PhysicsEngine, а производным нужен сдвиг момента переключения -
+        // без него время по final_drive выглядит как ступеньки по dt. Скорость
+        // получает (a_новая - a_старая)·dt·(late - значение late): ноль по
+        // значению, производная - как у переключения внутри шага
+        void shiftAt(int direction, double threshold_rpm) {
+            const int gear = state.current_gear;
+            const T rpm = state.engine_rpm;
+            if (direction > 0) {
+                shiftUp();
+            } else {
+                shiftDown();
+            }
+            if (state.current_gear == gear || last_step.dt <= 0) {
+                return;
+            }
+            
+            T late = 1.0;
+            T change = rpm - last_step.start_rpm;
+            if (scalarValue(change) != 0.0) {
+                late = f1core::clampTo<T>((rpm - threshold_rpm) / change, 0.0, 1.0);
+            }
+            T gained = accelerationInGear(state.current_gear) - accelerationInGear(gear);
+            state.velocity.x += gained * last_step.dt * (late - scalarValue(late));
+        }
+        
+        // Как F1PhysicsEngine::shiftUp/shiftDown
+        void shiftUp() {
+            if (state.current_gear < p.gear_count) {
+                state.current_gear++;
+                if (state.clutch_locked) {
+                    state.engine_rpm = f1core::wheelRpm(p, state) * gear_factor[state.current_gear - 1];
+                }
+            }
+        }
+        
+        void shiftDown() {
+            if (state.current_gear > 1) {
+                T new_gear_factor = p.gear_ratios[state.current_gear - 2] * p.final_drive;
+                if (f1core::wheelRpm(p, state) * new_gear_factor <= p.max_rpm) {
+                    state.current_gear--;
+                    if (state.clutch_locked) {
+                        state.engine_rpm = f1core::wheelRpm(p, state) * gear_factor[state.current_gear - 1];
+                    }
+                }
+            }
+        }
+        
+        const CarState& getState() const { return state; }
+        
+        // Ускорение следующего шага на передаче gear с педалями прошлого (на копии)
+        T accelerationInGear(int gear) const {
+            ScalarEngine copy = *this;
+            copy.state.current_gear = gear;
+            if (copy.state.clutch_locked) {
+                copy.state.engine_rpm = f1core::wheelRpm(p, copy.state) * gear_factor[gear - 1];
+            }
+            ForceBreakdown forces;
+            f1core::NoStageClock clock;
+            f1core::step(copy, copy.state, forces, last_step.throttle, last_step.brake, last_step.dt, clock);
+            return forces.acceleration;
+        }
+        
+        // === ПОЛИТИКА МАШИНЫ ДЛЯ f1core::step ===
+        
+        const ScalarParameters<T>& p;
+        SlowState slow;
+        
+        const T& gearFactor(int gear) const { return gear_factor[gear]; }
+        const T& inertiaMass(int gear) const { return inertia_mass[gear]; }
+        const T& brakeForceLimit() const { return p.max_brake_force; }
+        double deployFraction(const CarState&) const { return 1.0; }
+        void aeroCoefficients(const CarState&, ForceBreakdown&, T&, T&) const {}
+        double dragFactor() const { return 1.0; }
+        double downforceFactor() const { return 1.0; }
+        void brakeWork(const T&) const {}
+        void travel(const T&) const {}
+        void recordForces(const ForceBreakdown&) const {}
+        void updateBrakes(CarState&) const {}
+    
+    private:
+        struct StepInputs {
+            double dt = 0.0;
+            T throttle = 0.0;
+            T brake = 0.0;
+            T start_rpm = 0.0;          // Обороты в начале шага
+        };
+        
+        CarState state;
+        std::array<T, 8> gear_factor{};
+        std::array<T, 8> inertia_mass{};
+        StepInputs last_step;
+    };
+    
+    // === ПИЛОТ ===
+    
+    // SpeedProfile::fromTrack и SpeedProfileDriver на скаляре T: скорости
+    // профиля несут производные по параметрам машины. Отличия - только те, что
+    // делают время круга гладким: без них выход из поворота - ступенька цели на
+    // одном узле, а заморозка интеграла - скачок, и производные по Dual шумят
+    // на порядок сильнее реального наклона
+    template <typename T>
+    class ScalarDriver {
+    public:
+        ScalarDriver(const Track& track, const ScalarParameters<T>& p, const TuningConfig& config)
+            : config(config.driver) {
+            using std::sqrt;
+            const SpeedProfileConfig& profile = config.profile;
+            count = std::max(1, static_cast<int>(std::ceil(track.length / profile.spacing)));
+            double spacing = track.length / count;
+            inv_spacing = count / track.length;
+            speeds.assign(count, T(profile.max_speed));
+            
+            // 1. Повороты: m·v²/R = μ·(m·g - k·v²), k = 0.5·ρ·C_l·A (C_l < 0 - вниз).
+            // Знаменатель не больше нуля - прижим растет быстрее, предела нет
+            T full_mass = p.mass + p.fuel_initial_mass;
+            T down_k = 0.5 * p.air_density * p.downforce_coefficient * p.frontal_area;
+            for (const TrackCorner& corner : track.corners) {
+                T denominator = full_mass / corner.radius + p.tire_friction * down_k;
+                if (denominator <= 0) {
+                    continue;
+                }
+                T limit = profile.corner_margin * sqrt(p.tire_friction * full_mass * GRAVITY / denominator);
+                int first = static_cast<int>(std::floor(corner.distance / spacing));
+                int last = static_cast<int>(std::ceil((corner.distance + corner.length) / spacing));
+                for (int i = first; i <= last; i++) {
+                    T& v = speeds[i % count];
+                    v = f1core::minOf(v, limit);
+                }
+            }
+            
+            // 2. Торможение назад, два круга - как в SpeedProfile::fromTrack
+            T decel = profile.braking_margin * f1core::minOf<T>(p.tire_friction * GRAVITY, p.max_brake_force / full_mass);
+            for (int k = 2 * count; k-- > 0;) {
+                const T& next = speeds[(k + 1) % count];
+                T& v = speeds[k % count];
+                v = f1core::minOf<T>(v, sqrt(next * next + 2.0 * spacing * decel));
+            }
+            
+            // 3. Разгон вперед с μ·g: цель на выходе из поворота растет плавно
+            T accel = p.tire_friction * GRAVITY;
+            for (int k = 1; k <= 2 * count; k++) {
+                const T& previous = speeds[(k - 1) % count];
+                T& v = speeds[k % count];
+                v = f1core::minOf<T>(v, sqrt(previous * previous + 2.0 * spacing * accel));
+            }
+            speeds.push_back(speeds[0]);
+        }
+        
+        // SpeedProfile::at
+        T at(const T& lap_distance) const {
+            T x = lap_distance * inv_spacing;
+            x = x >= count ? x - count : x;
+            x = f1core::clampTo<T>(x, 0.0, static_cast<double>(count));
+            int i = std::min(static_cast<int>(scalarValue(x)), count - 1);
+            return speeds[i] + (speeds[i + 1] - speeds[i]) * (x - i);
+        }
+        
+        // SpeedProfileDriver::control: газ и тормоз, переключение (+1/-1/0).
+        // Интеграл ограничен ±1 без заморозки - он непрерывен по параметрам
+        template <typename State>
+        int control(const State& s, T& integral, double dt, T& throttle, T& brake) const {
+            T velocity = s.velocity.x;
+            T target = f1core::minOf(at(s.lap_distance), at(s.lap_distance + velocity * config.preview_time));
+            T error = target - velocity;
+            
+            T proportional = config.kp * error;
+            integral = f1core::clampTo<T>(integral + config.ki * error * dt, -1.0, 1.0);
+            T output = proportional + integral;
+            
+            throttle = f1core::clampTo<T>(output, 0.0, 1.0);
+            brake = f1core::clampTo<T>(-output, 0.0, 1.0);
+            if (s.clutch_locked && s.engine_rpm < config.downshift_rpm) {
+                return -1;
+            }
+            return s.engine_rpm > config.upshift_rpm ? 1 : 0;
+        }
+    
+    private:
+        DriverConfig config;
+        std::vector<T> speeds;          // count + 1 узлов: последний повторяет первый
+        double inv_spacing = 0.0;
+        int count = 0;
+    };
+    
+    // === ПРОГОНЫ (Engine - F1PhysicsEngine на double или ScalarEngine<T>) ===
+    
+    void shiftAt(F1PhysicsEngine& engine, int direction, double) {
+        if (direction > 0) {
+            engine.shiftUp();
+        } else {
+            engine.shiftDown();
+        }
+    }
+    
+    template <typename T>
+    void shiftAt(ScalarEngine<T>& engine, int direction, double threshold_rpm) {
+        engine.shiftAt(direction, threshold_rpm);
+    }
+    
+    // Разгон с места на полном газу до target_speed
+    template <typename T, typename Engine>
+    T runAcceleration(Engine& engine, const TuningConfig& config) {
+        const auto& s = engine.getState();
+        int steps = static_cast<int>(std::ceil(config.max_time / config.dt));
+        T previous_velocity = 0.0;
+        for (int step = 0; step < steps; step++) {
+            if (s.engine_rpm > config.driver.upshift_rpm) {
+                shiftAt(engine, 1, config.driver.upshift_rpm);
+            }
+            engine.update(config.dt, T(1.0), T(0.0));
+            
+            // Пересечение цели - линейная интерполяция внутри шага, чтобы время
+            // (и производные) не были ступенькой по dt
+            if (s.velocity.x >= config.target_speed) {
+                T fraction = (config.target_speed - previous_velocity) / (s.velocity.x - previous_velocity);
+                return s.time - config.dt + fraction * config.dt;
+            }
+            previous_velocity = s.velocity.x;
+        }
+        return T(config.max_time);
+    }
+    
+    // Время второго круга с места: пересечение линии внутри шага - по скорости
+    template <typename T, typename Engine>
+    T runFlyingLap(Engine& engine, const ScalarDriver<T>& driver, const TuningConfig& config) {
+        const auto& s = engine.getState();
+        int steps = static_cast<int>(std::ceil(2.0 * config.max_lap_time / config.dt));
+        T integral = 0.0;
+        T throttle;
+        T brake;
+        T line_time = 0.0;
+        for (int step = 0; step < steps; step++) {
+            int shift = driver.control(s, integral, config.dt, throttle, brake);
+            if (shift != 0) {
+                shiftAt(engine, shift, shift > 0 ? config.driver.upshift_rpm : config.driver.downshift_rpm);
+            }
+            
+            int lap = s.lap;
+            engine.update(config.dt, throttle, brake);
+            if (s.lap != lap) {
+                T crossing = s.time - s.lap_distance / s.velocity.x;
+                if (s.lap == 2) {
+                    return crossing - line_time;
+                }
+                line_time = crossing;
+            }
+        }
+        return T(config.max_lap_time);
+    }
+    
+    // Номера производных: parameters по порядку, пустой - все параметры
+    Slots makeSlots(const std::vector<int>& parameters, int width) {
+        Slots slots;
+        slots.fill(-1);
+        int next = 0;
+        for (int p = 0; p < TUNE_PARAMETER_COUNT; p++) {
+            bool wanted = parameters.empty()
+                          || std::find(parameters.begin(), parameters.end(), p) != parameters.end();
+            if (wanted && next < width) {
+                slots[p] = next++;
+            }
+        }
+        return slots;
+    }
+    
+    template <int N>
+    TimeGradient toTimeGradient(const Dual<N>& time, const Slots& slots) {
+        TimeGradient result;
+        result.time = time.value;
+        for (int p = 0; p < TUNE_PARAMETER_COUNT; p++) {
+            if (slots[p] >= 0) {
+                result.gradient[p] = time.grad[slots[p]];
+            }
+        }
+        return result;
+    }
+    
+    template <int N>
+    TimeGradient accelerationGradient(const CarParameters& car, const TuningConfig& config,
+                                      const std::vector<int>& parameters) {
+        Slots slots = makeSlots(parameters, N);
+        ScalarParameters<Dual<N>> p = makeParameters<Dual<N>>(car, config, slots);
+        ScalarEngine<Dual<N>> engine(p);
+        return toTimeGradient(runAcceleration<Dual<N>>(engine, config), slots);
+    }
+    
+    template <int N>
+    TimeGradient lapGradient(const Track& track, const CarParameters& car, const TuningConfig& config,
+                             const std::vector<int>& parameters) {
+        Slots slots = makeSlots(parameters, N);
+        ScalarParameters<Dual<N>> p = makeParameters<Dual<N>>(car, config, slots);
+        p.track_length = track.length;
+        ScalarEngine<Dual<N>> engine(p);
+        ScalarDriver<Dual<N>> driver(track, p, config);
+        return toTimeGradient(runFlyingLap<Dual<N>>(engine, driver, config), slots);
+    }
+    
+    // Короткий Dual - быстрее: ширина по числу параметров (один, два или все)
+    int dualWidth(const std::vector<int>& parameters) {
+        return parameters.empty() ? TUNE_PARAMETER_COUNT : static_cast<int>(parameters.size());
+    }
+}
+
+// === ЦЕЛЕВЫЕ ФУНКЦИИ ===
+
+double accelerationTime(const CarParameters& car, const TuningConfig& config) {
+    F1PhysicsEngine engine(engineParameters(car, config));
+    return runAcceleration<double>(engine, config);
+}
+
+TimeGradient accelerationTimeGradient(const CarParameters& car, const TuningConfig& config,
+                                      const std::vector<int>& parameters) {
+    switch (dualWidth(parameters)) {
+        case 1: return accelerationGradient<1>(car, config, parameters);
+        case 2: return accelerationGradient<2>(car, config, parameters);
+        default: return accelerationGradient<TUNE_PARAMETER_COUNT>(car, config, parameters);
+    }
+}
+
+double lapTime(const Track& track, const CarParameters& car, const TuningConfig& config) {
+    CarParameters engine_car = engineParameters(car, config);
+    engine_car.track_length = track.length;
+    F1PhysicsEngine engine(engine_car);
+    Slots constants;
+    constants.fill(-1);
+    ScalarDriver<double> driver(track, makeParameters<double>(car, config, constants), config);
+    return runFlyingLap<double>(engine, driver, config);
+}
+
+TimeGradient lapTimeGradient(const Track& track, const CarParameters& car, const TuningConfig& config,
+                             const std::vector<int>& parameters) {
+    switch (dualWidth(parameters)) {
+        case 1: return lapGradient<1>(track, car, config, parameters);
+        case 2: return lapGradient<2>(track, car, config, parameters);
+        default: return lapGradient<TUNE_PARAMETER_COUNT>(track, car, config, parameters);
+    }
+}
+
+// === ОПТИМИЗАЦИЯ ===
+
+namespace {
+    // Точка в нормированных координатах -> машина
+    CarParameters carAt(const CarParameters& start, const std::vector<TuningBound>& bounds,
+                        const std::vector<double>& point) {
+        CarParameters car = start;
+        for (size_t i = 0; i < bounds.size(); i++) {
+            const TuningBound& b = bounds[i];
+            tuningParameter(car, b.parameter) = b.lower + point[i] * (b.upper - b.lower);
+        }
+        return car;
+    }
+    
+    // Градиент в нормированных координатах: dT/dx = dT/dp · (upper - lower)
+    void normalizedGradient(const TimeGradient& time, const std::vector<TuningBound>& bounds,
+                            std::vector<double>& gradient) {
+        for (size_t i = 0; i < bounds.size(); i++) {
+            const TuningBound& b = bounds[i];
+            gradient[i] = time.gradient[b.parameter] * (b.upper - b.lower);
+        }
+    }
+}
+
+TuningResult optimizeSetup(const TuningObjective& objective, const CarParameters& start,
+                           const std::vector<TuningBound>& bounds, const OptimizerConfig& config) {
+    size_t n = bounds.size();
+    std::vector<double> x(n), gradient(n), next_x(n), next_gradient(n);
+    for (size_t i = 0; i < n; i++) {
+        const TuningBound& b = bounds[i];
+        x[i] = std::clamp((tuningParameter(start, b.parameter) - b.lower) / (b.upper - b.lower), 0.0, 1.0);
+    }
+    
+    TuningResult result;
+    TimeGradient current = objective(carAt(start, bounds, x));
+    result.evaluations = 1;
+    normalizedGradient(current, bounds, gradient);
+    
+    // Первый шаг сдвигает самую крутую координату на initial_step диапазона
+    double steepest = 0.0;
+    for (double g : gradient) {
+        steepest = std::max(steepest, std::abs(g));
+    }
+    double step = steepest > 0 ? config.initial_step / steepest : 0.0;
+    
+    while (step > 0 && result.iterations < config.max_iterations) {
+        result.iterations++;
+        
+        // Линейный поиск Армихо вдоль проекции антиградиента на диапазоны
+        TimeGradient candidate;
+        bool accepted = false;
+        double moved = 0.0;
+        while (true) {
+            double decrease = 0.0;
+            moved = 0.0;
+            for (size_t i = 0; i < n; i++) {
+                next_x[i] = std::clamp(x[i] - step * gradient[i], 0.0, 1.0);
+                decrease += gradient[i] * (next_x[i] - x[i]);
+                moved = std::max(moved, std::abs(next_x[i] - x[i]));
+            }
+            if (moved < config.step_tolerance) {
+                break;  // Проекционный шаг выродился - стационарная точка (или угол диапазона)
+            }
+            candidate = objective(carAt(start, bounds, next_x));
+            result.evaluations++;
+            if (candidate.time <= current.time + config.armijo * decrease) {
+                accepted = true;
+                break;
+            }
+            step *= 0.5;
+        }
+        if (!accepted) {
+            result.converged = true;
+            break;
+        }
+        
+        // Шаг Барзилаи-Борвейна s·s / s·y: кривизна вдоль последнего шага
+        normalizedGradient(candidate, bounds, next_gradient);
+        double ss = 0.0;
+        double sy = 0.0;
+        for (size_t i = 0; i < n; i++) {
+            double s = next_x[i] - x[i];
+            ss += s * s;
+            sy += s * (next_gradient[i] - gradient[i]);
+        }
+        step = sy > 0 ? ss / sy : step * 2.0;
+        
+        x.swap(next_x);
+        gradient.swap(next_gradient);
+        current = candidate;
+    }
+    
+    result.car = carAt(start, bounds, x);
+    result.time = current.time;
+    return result;
+}
+
+TuningResult sweepSetup(const TuningTimeObjective& objective, const CarParameters& start,
+                        const std::vector<TuningBound>& bounds, int points_per_axis) {
+    points_per_axis = std::max(points_per_axis, 2);
+    TuningResult result;
+    result.car = start;
+    result.time = std::numeric_limits<double>::infinity();
+    
+    std::vector<int> index(bounds.size(), 0);
+    CarParameters car = start;
+    while (true) {
+        for (size_t i = 0; i < bounds.size(); i++) {
+            const TuningBound& b = bounds[i];
+            tuningParameter(car, b.parameter) = b.lower + (b.upper - b.lower) * index[i] / (points_per_axis - 1);
+        }
+        double time = objective(car);
+        result.evaluations++;
+        if (time < result.time) {
+            result.time = time;
+            result.car = car;
+        }
+        
+        // Следующий узел сетки: счетчик по основанию points_per_axis
+        size_t axis = 0;
+        while (axis < index.size() && ++index[axis] == points_per_axis) {
+            index[axis] = 0;
+            axis++;
+        }
+        if (axis == index.size()) {
+            break;
+        }
+    }
+    
+    result.iterations = result.evaluations;
+    result.converged = true;
+    return result;
+}
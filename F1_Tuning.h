@@ -0,0 +1,116 @@
+#ifndef F1_TUNING_H
+#define F1_TUNING_H
+
+#include <array>
+#include <functional>
+#include <vector>
+#include "F1_Driver.h"
+#include "F1_Physics_build_2.h"
+#include "F1_Track.h"
+
+// Градиентная настройка машины. Время считает тот же шаг f1core::step, что
+// и F1PhysicsEngine::update, только на дуальных числах Dual<N>: один проход
+// дает время и его производные по всем параметрам из TuningParameter.
+// Значения на Dual совпадают с double бит в бит, поэтому время из градиента
+// равно времени настоящего F1PhysicsEngine на тех же параметрах, а
+// accelerationTime/lapTime - это прогон самого движка.
+//
+// Производные - у ветвей, которые выбрал прогон. Излом кривой момента на
+// peak_rpm обороты проходят во времени, и интеграл по траектории остается
+// гладким; момент переключения передачи привязан к шагу dt, и его сдвиг
+// производные не видят - время по final_drive слегка волнистое, поэтому
+// поиск в optimizeSetup принимает шаг по значению времени, а не по градиенту.
+// Температуры (thermal) не моделируются: прогон идет с выключенными.
+
+// Параметры CarParameters, по которым считаются производные (индекс в градиенте)
+enum TuningParameter {
+    TUNE_FINAL_DRIVE,
+    TUNE_MAX_TORQUE,
+    TUNE_PEAK_RPM,
+    TUNE_NULL_RPM,
+    TUNE_MASS,
+    TUNE_DRAG_COEFFICIENT,
+    TUNE_DOWNFORCE_COEFFICIENT,
+    TUNE_FRONTAL_AREA,
+    TUNE_TIRE_FRICTION,
+    TUNE_MAX_BRAKE_FORCE,
+    TUNE_PARAMETER_COUNT
+};
+
+const char* tuningParameterName(int parameter);
+double& tuningParameter(F1PhysicsEngine::CarParameters& car, int parameter);
+double tuningParameter(const F1PhysicsEngine::CarParameters& car, int parameter);
+
+struct TuningConfig {
+    double dt = 0.01;                   // Шаг движка [с]
+    double target_speed = 200.0 / 3.6;  // Разгон до этой скорости [м/с]
+    double max_time = 30.0;             // Предел времени разгона [с]
+    double max_lap_time = 300.0;        // Предел времени круга [с] (машина не доехала)
+    double induced_drag = 0.0;          // Поляра: C_d = drag_coefficient + induced_drag·C_l²
+    SpeedProfileConfig profile;         // Профиль пилота на круге (повороты - с прижимом)
+    DriverConfig driver;                // Регулятор пилота и обороты переключений
+};
+
+// Время и его производные по параметрам [с / единица параметра]
+struct TimeGradient {
+    double time = 0.0;
+    std::array<double, TUNE_PARAMETER_COUNT> gradient{};
+};
+
+// Разгон с места на полном газу до target_speed: переключение вверх выше
+// driver.upshift_rpm, пересечение target_speed интерполируется внутри шага.
+// parameters - по каким TuningParameter считать производные (пусто - по всем;
+// остальные в gradient - 0). Чем их меньше, тем короче Dual и быстрее проход.
+double accelerationTime(const F1PhysicsEngine::CarParameters& car, const TuningConfig& config);
+TimeGradient accelerationTimeGradient(const F1PhysicsEngine::CarParameters& car, const TuningConfig& config,
+                                      const std::vector<int>& parameters = std::vector<int>());
+
+// Быстрый круг: старт с места, пилот SpeedProfileDriver по профилю трассы,
+// время второго (летящего) круга между пересечениями линии (внутри шага -
+// по скорости). Профиль - как SpeedProfile::fromTrack, но предел поворота
+// считает прижим: m·v²/R = μ·(m·g + прижим), так что прижим дает скорость в
+// поворотах, а сопротивление отнимает ее на прямых. Чтобы время было гладким
+// по параметрам, выход из поворота в профиле - разгон с μ·g, а не ступенька до
+// max_speed, и интеграл ПИ просто ограничен ±1 (без заморозки при насыщении).
+double lapTime(const Track& track, const F1PhysicsEngine::CarParameters& car, const TuningConfig& config);
+TimeGradient lapTimeGradient(const Track& track, const F1PhysicsEngine::CarParameters& car,
+                             const TuningConfig& config, const std::vector<int>& parameters = std::vector<int>());
+
+// === ОПТИМИЗАЦИЯ ===
+
+// Настраиваемый параметр и его допустимый диапазон
+struct TuningBound {
+    int parameter;                      // TuningParameter
+    double lower;
+    double upper;
+};
+
+struct OptimizerConfig {
+    int max_iterations = 50;
+    double step_tolerance = 1e-3;       // Остановка: шаг меньше этой доли диапазона
+    double armijo = 1e-4;               // Достаточное убывание в линейном поиске
+    double initial_step = 0.1;          // Первый шаг - доля диапазона
+};
+
+struct TuningResult {
+    F1PhysicsEngine::CarParameters car;
+    double time = 0.0;
+    int evaluations = 0;                // Вызовов целевой функции
+    int iterations = 0;
+    bool converged = false;
+};
+
+using TuningObjective = std::function<TimeGradient(const F1PhysicsEngine::CarParameters&)>;
+using TuningTimeObjective = std::function<double(const F1PhysicsEngine::CarParameters&)>;
+
+// Проекционный градиентный спуск в нормированных координатах (каждый
+// диапазон -> [0, 1]) с шагом Барзилаи-Борвейна и поиском Армихо.
+// Каждое вычисление - один проход движка на дуальных числах.
+TuningResult optimizeSetup(const TuningObjective& objective, const F1PhysicsEngine::CarParameters& start,
+                           const std::vector<TuningBound>& bounds, const OptimizerConfig& config = OptimizerConfig());
+
+// Перебор по сетке points_per_axis^bounds.size() - для сравнения
+TuningResult sweepSetup(const TuningTimeObjective& objective, const F1PhysicsEngine::CarParameters& start,
+                        const std::vector<TuningBound>& bounds, int points_per_axis);
+
+#endif // F1_TUNING_H
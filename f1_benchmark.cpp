@@ -0,0 +1,45 @@
+#include "F1_Benchmark.h"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+// Бенчмарки движка. Запуск: f1_benchmark [шагов]
+int main(int argc, char** argv) {
+    long steps = argc > 1 ? std::atol(argv[1]) : 5000000;
+    
+    std::cout << "=== F1 ENGINE BENCHMARK (" << steps << " шагов) ===" << std::endl;
+    std::vector<BenchmarkResult> results = runEngineBenchmarks(steps);
+    
+    std::cout << std::fixed << std::setprecision(2);
+    for (const BenchmarkResult& r : results) {
+        std::cout << std::left << std::setw(32) << r.name << std::right
+                  << std::setw(10) << r.ns_per_op << " нс/шаг" << std::endl;
+    }
+    
+    // Выигрыш специализированного движка
+    if (results.size() >= 3 && results[2].ns_per_op > 0) {
+        std::cout << "Ускорение специализации: x" << results[0].ns_per_op / results[2].ns_per_op << std::endl;
+    }
+    
+    // Короткие прогоны: куча против арены
+    std::cout << std::endl << "=== SCENARIO RUNS (20000 x 500 шагов) ===" << std::endl;
+    for (const ScenarioBenchmarkResult& r : runScenarioBenchmarks()) {
+        std::cout << std::left << std::setw(24) << r.name << std::right
+                  << std::setw(10) << r.ns_per_run / 1000.0 << " мкс/прогон"
+                  << std::setw(8) << r.ns_per_step << " нс/шаг"
+                  << "  куча: " << std::setw(6) << r.allocations_per_run << " на прогон, "
+                  << r.step_allocations << " на шагах" << std::endl;
+    }
+    
+    // Кодек телеметрии на трассах движка
+    std::cout << std::endl << "=== TELEMETRY CODEC (600 с трассы) ===" << std::endl;
+    for (const CodecBenchmarkResult& r : runCodecBenchmarks()) {
+        std::cout << std::left << std::setw(24) << r.name << std::right
+                  << std::setw(10) << r.encoded_bytes / 1024 << " КБ"
+                  << "  сжатие x" << std::setw(5) << r.ratio
+                  << "  кодер " << std::setw(8) << r.encode_mb_per_s << " МБ/с"
+                  << "  декодер " << std::setw(8) << r.decode_mb_per_s << " МБ/с"
+                  << (r.lossless ? "" : "  ОШИБКА ДЕКОДИРОВАНИЯ") << std::endl;
+    }
+    return 0;
+}
@@ -4,7 +4,7 @@
 #include <thread>
 #include <atomic>
 #include <ncurses.h>
-#include <vector>
+#include <array>
 
 struct f1_car_inside {
 private:
@@ -21,7 +21,7 @@ private:
     
     const double dt = 0.01;
     
-    const std::vector<double> gear_ratios = {
+    const std::array<double, 8> gear_ratios = {
         3.0,   // 1-я
         2.4,   // 2-я
         2.0,   // 3-я  
@@ -0,0 +1,118 @@
+#include "F1_Conformance.h"
+#include "F1_Behaviour.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace {
+    constexpr int EXIT_MISMATCH = 1;
+    constexpr int EXIT_ERROR = 2;
+    
+    // Эталон в репозитории (записан f1_conformance record); путь - от корня
+    constexpr const char* DEFAULT_CORPUS = "f1_conformance.f1gold";
+    
+    // Таблица: максимум расхождения по каналам, время шага, вердикт; затем
+    // сводка скорости вариантов по всему корпусу. true - все в допуске
+    bool printReport(const std::vector<ConformanceResult>& results) {
+        // Ширины заголовка - в символах, а printf считает байты UTF-8
+        std::printf("Вариант              Трасса        ");
+        for (int c = 0; c < CONF_CHANNEL_COUNT; c++) {
+            std::printf(" %14s", conformanceChannelName(c));
+        }
+        std::printf("    нс/шаг\n");
+        
+        bool all_passed = true;
+        std::map<std::string, double> total_ns;
+        std::vector<std::string> order;
+        for (const ConformanceResult& r : results) {
+            std::printf("%-20s %-14s", r.variant.c_str(), r.trace.c_str());
+            for (int c = 0; c < CONF_CHANNEL_COUNT; c++) {
+                std::printf(" %14.3g", r.max_error[c]);
+            }
+            std::printf(" %9.1f", r.ns_per_step);
+            if (!r.passed()) {
+                int c = r.worstChannel();
+                std::printf("  ВНЕ ДОПУСКА: %s %.3g > %.3g (t=%.1f с)", conformanceChannelName(c),
+                            r.max_error[c], r.tolerance[c], r.error_time[c]);
+                all_passed = false;
+            }
+            std::printf("\n");
+            if (total_ns.find(r.variant) == total_ns.end()) {
+                order.push_back(r.variant);
+            }
+            total_ns[r.variant] += r.ns_per_step;
+        }
+        
+        std::printf("\nСкорость по корпусу (сумма нс/шаг по трассам, ускорение к engine):\n");
+        double reference = total_ns.count("engine") ? total_ns["engine"] : 0.0;
+        for (const std::string& variant : order) {
+            std::printf("  %-20s %9.1f", variant.c_str(), total_ns[variant]);
+            if (reference > 0.0) {
+                std::printf("  x%.2f", reference / total_ns[variant]);
+            }
+            std::printf("\n");
+        }
+        std::printf("%s\n", all_passed ? "Все варианты в допуске" : "ЕСТЬ РАСХОЖДЕНИЯ");
+        return all_passed;
+    }
+    
+    // Проверки поведения: по строке на проверку. true - все прошли
+    bool printBehaviour(const std::vector<BehaviourResult>& results) {
+        std::printf("\nПоведение:\n");
+        bool all_passed = true;
+        for (const BehaviourResult& r : results) {
+            // Ширины - в символах, а printf считает байты UTF-8
+            std::printf("  %-24s %s %s\n", r.name.c_str(), r.passed ? "ок    " : "ОШИБКА", r.detail.c_str());
+            all_passed = all_passed && r.passed;
+        }
+        return all_passed;
+    }
+}
+
+// Соответствие вариантов движка эталону на корпусе скриптов.
+// Без аргументов - check по эталону из репозитория (запуск из корня)
+int main(int argc, char** argv) {
+    std::string command = argc > 1 ? argv[1] : "check";
+    std::string corpus_path = argc > 2 ? argv[2] : DEFAULT_CORPUS;
+    std::vector<GoldenTrace> corpus;
+    int repeats = 3;
+    
+    if (command == "record" && argc > 2) {
+        corpus = makeConformanceCorpus();
+        if (!writeGoldenTraces(argv[2], corpus)) {
+            std::cerr << "Не удалось записать " << argv[2] << std::endl;
+            return EXIT_ERROR;
+        }
+        std::cout << "Корпус: " << corpus.size() << " трасс -> " << argv[2] << std::endl;
+        return 0;
+    }
+    if (command == "behaviour") {
+        return printBehaviour(runBehaviourChecks()) ? 0 : EXIT_MISMATCH;
+    }
+    if (command == "check") {
+        if (!readGoldenTraces(corpus_path, corpus)) {
+            std::cerr << "Не удалось прочитать корпус " << corpus_path
+                      << (argc > 2 ? "" : " (запуск - из корня репозитория)") << std::endl;
+            return EXIT_ERROR;
+        }
+        repeats = argc > 3 ? std::max(1, std::atoi(argv[3])) : repeats;
+    } else if (command == "self" && argc == 2) {
+        corpus = makeConformanceCorpus();
+    } else {
+        std::cerr << "Использование:\n"
+                  << "  f1_conformance                           check " << DEFAULT_CORPUS << "\n"
+                  << "  f1_conformance record <корпус.f1gold>    записать скрипты и эталонные трассы\n"
+                  << "  f1_conformance check <корпус.f1gold> [повторов=3]\n"
+                  << "  f1_conformance self                      корпус заново, эталон сверяется сам с собой\n"
+                  << "  f1_conformance behaviour                 только проверки поведения\n"
+                  << "Выход: 0 - все в допуске, 1 - расхождения, 2 - ошибка" << std::endl;
+        return EXIT_ERROR;
+    }
+    
+    bool conforms = printReport(runConformance(corpus, repeats));
+    bool behaves = printBehaviour(runBehaviourChecks());
+    return conforms && behaves ? 0 : EXIT_MISMATCH;
+}
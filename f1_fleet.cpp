@@ -0,0 +1,29 @@
+#include "F1_Fleet.h"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+// Отчет о точности float-парка против double-эталона.
+// Запуск: f1_fleet [машин] [секунд] [допуск, м]
+int main(int argc, char** argv) {
+    std::size_t cars = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 64;
+    double duration = argc > 2 ? std::atof(argv[2]) : 5400.0;
+    double tolerance = argc > 3 ? std::atof(argv[3]) : 0.01;
+    
+    std::cout << "=== FLEET DRIFT: FLOAT vs DOUBLE ===" << std::endl;
+    std::cout << cars << " машин, " << duration << " с, допуск " << tolerance << " м" << std::endl;
+    
+    FleetDriftReport r = runFleetDriftReport(cars, duration, 0.01, tolerance);
+    
+    std::cout << std::setprecision(4);
+    std::cout << "Позиция, макс.:        " << r.max_position_error << " м" << std::endl;
+    std::cout << "Позиция, в конце:      " << r.final_position_error << " м" << std::endl;
+    std::cout << "Скорость, макс.:       " << r.max_velocity_error << " м/с" << std::endl;
+    std::cout << "Батарея, макс.:        " << r.max_battery_error << " Дж" << std::endl;
+    std::cout << "Топливо, макс.:        " << r.max_fuel_error << " кг" << std::endl;
+    std::cout << "Время круга, макс.:    " << r.max_lap_time_error << " с" << std::endl;
+    std::cout << "Разошлось число кругов: " << r.lap_count_mismatches << " машин" << std::endl;
+    std::cout << "В допуске до:          " << r.safe_horizon << " с" << std::endl;
+    std::cout << (r.safe() ? "float безопасен для этого прогона" : "float НЕ укладывается в допуск") << std::endl;
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "F1_PerfGate.h"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace {
+    // Коды выхода: 0 - регрессий нет, 1 - есть регрессии, 2 - ошибка
+    constexpr int EXIT_REGRESSION = 1;
+    constexpr int EXIT_ERROR = 2;
+    
+    PerfReport run(const PerfGateConfig& config) {
+        std::cout << "Прогонов: " << config.runs << ", шагов движка: " << config.steps << "..." << std::endl;
+        return runPerfSuite(config);
+    }
+    
+    bool save(const std::string& path, const PerfReport& report) {
+        if (!writePerfReport(path, report)) {
+            std::cerr << "Не удалось записать " << path << std::endl;
+            return false;
+        }
+        std::cout << "Отчет: " << path << std::endl;
+        return true;
+    }
+    
+    int compare(const PerfReport& baseline, const PerfReport& current, double threshold) {
+        bool ok = printPerfComparison(std::cout, comparePerfReports(baseline, current, threshold), threshold);
+        return ok ? 0 : EXIT_REGRESSION;
+    }
+    
+    bool load(const std::string& path, PerfReport& report) {
+        if (!readPerfReport(path, report)) {
+            std::cerr << "Не удалось прочитать отчет " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+}
+
+// Порог регрессий: набор бенчмарков несколько раз, сравнение с базовым JSON
+int main(int argc, char** argv) {
+    std::string command = argc > 1 ? argv[1] : "";
+    PerfGateConfig config;
+    
+    if (command == "record" && argc > 2) {
+        config.runs = argc > 3 ? std::atoi(argv[3]) : config.runs;
+        config.steps = argc > 4 ? std::atol(argv[4]) : config.steps;
+        return save(argv[2], run(config)) ? 0 : EXIT_ERROR;
+    }
+    if (command == "check" && argc > 2) {
+        double threshold = argc > 3 ? std::atof(argv[3]) / 100.0 : 0.03;
+        config.runs = argc > 4 ? std::atoi(argv[4]) : config.runs;
+        config.steps = argc > 5 ? std::atol(argv[5]) : config.steps;
+        PerfReport baseline;
+        if (!load(argv[2], baseline)) {
+            return EXIT_ERROR;
+        }
+        PerfReport current = run(config);
+        if (argc > 6 && !save(argv[6], current)) {
+            return EXIT_ERROR;
+        }
+        return compare(baseline, current, threshold);
+    }
+    if (command == "diff" && argc > 3) {
+        double threshold = argc > 4 ? std::atof(argv[4]) / 100.0 : 0.03;
+        PerfReport baseline, current;
+        if (!load(argv[2], baseline) || !load(argv[3], current)) {
+            return EXIT_ERROR;
+        }
+        return compare(baseline, current, threshold);
+    }
+    
+    std::cerr << "Использование:\n"
+              << "  f1_perfgate record <отчет.json> [прогонов=7] [шагов=1000000]\n"
+              << "  f1_perfgate check <база.json> [порог, %=3] [прогонов=7] [шагов=1000000] [отчет.json]\n"
+              << "  f1_perfgate diff <база.json> <отчет.json> [порог, %=3]\n"
+              << "Выход: 0 - без регрессий, 1 - регрессии, 2 - ошибка" << std::endl;
+    return EXIT_ERROR;
+}
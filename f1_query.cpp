@@ -0,0 +1,242 @@
+#include "F1_Driver.h"
+#include "F1_TelemetryLog.h"
+#include "F1_TelemetryQuery.h"
+#include "F1_Track.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Запросы к логам телеметрии.
+//   f1_query record <лог> [круги=5] [запас торможения=0.6]  - заезд автопилота по демо-трассе (100 Гц)
+//   f1_query laps <лог> [канал=velocity] [фильтр: канал:мин:макс] [потоков=0]
+//   f1_query delta <лог A> <лог B> [шаг, м=10] [потоков=0]
+//   f1_query stats <лог> [потоков=0]                         - потоковая статистика всех каналов
+
+namespace {
+    int record(const std::string& path, int laps, double braking_margin) {
+        Track track = Track::demoCircuit();
+        F1PhysicsEngine::CarParameters params;
+        params.track_length = track.length;
+        F1PhysicsEngine car(params);
+        
+        SpeedProfileConfig profile_config;
+        profile_config.braking_margin = braking_margin;
+        SpeedProfile profile = SpeedProfile::fromTrack(track, params, profile_config);
+        SpeedProfileDriver driver(profile);
+        DriverState driver_state;
+        ErsDeploymentMap deployment_map = buildDeploymentMap(profile, params);
+        car.setDeploymentMap(&deployment_map);
+        
+        TelemetryLogWriter writer;
+        if (!writer.openCarLog(path, track.length)) {
+            std::cerr << "Не удалось создать " << path << std::endl;
+            return 1;
+        }
+        
+        const double dt = 0.01;
+        int last_lap = car.getState().lap;
+        while (car.getState().lap < laps && car.getState().time < laps * 250.0) {
+            driver.drive(car, driver_state, dt);
+            
+            const F1PhysicsEngine::CarState& s = car.getState();
+            if (s.lap != last_lap) {
+                std::cout << "Круг " << last_lap << ": " << car.getSlowState().last_lap_time << " с" << std::endl;
+                last_lap = s.lap;
+            }
+            writer.appendFrame(makeTelemetryFrame(car));
+        }
+        if (!writer.close()) {
+            std::cerr << "Ошибка записи " << path << std::endl;
+            return 1;
+        }
+        std::cout << "Записано " << laps << " кругов, " << car.getState().time << " с" << std::endl;
+        return 0;
+    }
+    
+    int laps(const std::string& path, const std::string& channel, const std::string& filter, int threads) {
+        TelemetryLog log;
+        if (!log.open(path)) {
+            std::cerr << "Не удалось открыть лог " << path << std::endl;
+            return 1;
+        }
+        
+        LapQuery query;
+        query.channel = channel;
+        query.threads = threads;
+        Track track = Track::demoCircuit();
+        if (std::abs(log.trackLength() - track.length) < 1e-6) {
+            query.track = &track;
+        }
+        
+        // Фильтр "канал:мин:макс"
+        if (!filter.empty()) {
+            std::size_t first = filter.find(':');
+            std::size_t second = filter.find(':', first + 1);
+            if (first == std::string::npos || second == std::string::npos) {
+                std::cerr << "Фильтр задается как канал:мин:макс" << std::endl;
+                return 1;
+            }
+            query.filter_channel = filter.substr(0, first);
+            query.filter_min = std::atof(filter.substr(first + 1, second - first - 1).c_str());
+            query.filter_max = std::atof(filter.substr(second + 1).c_str());
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        std::vector<LapReport> reports = queryLaps(log, query);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (reports.empty()) {
+            std::cerr << "В логе нет нужных каналов (lap, lap_distance, velocity, " << channel << ")" << std::endl;
+            return 1;
+        }
+        
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "Круг      Время    Секторы                        " << channel
+                  << ": min / mean / max" << std::endl;
+        for (const LapReport& r : reports) {
+            std::cout << std::setw(4) << r.lap << "  ";
+            if (r.complete) {
+                std::cout << std::setw(9) << r.lap_time;
+            } else {
+                std::cout << std::setw(9) << "-";
+            }
+            std::cout << "  ";
+            for (double s : r.sector_times) {
+                if (std::isnan(s)) {
+                    std::cout << " " << std::setw(9) << "-";
+                } else {
+                    std::cout << " " << std::setw(9) << s;
+                }
+            }
+            if (r.stats.count > 0) {
+                std::cout << "    " << r.stats.min << " / " << r.stats.mean() << " / " << r.stats.max;
+            } else {
+                std::cout << "    нет отсчетов";
+            }
+            std::cout << std::endl;
+            
+            if (!r.corner_min_speed.empty()) {
+                std::cout << "      мин. в поворотах, км/ч:";
+                for (double v : r.corner_min_speed) {
+                    if (std::isnan(v)) {
+                        std::cout << "      -";
+                    } else {
+                        std::cout << std::setw(7) << std::setprecision(1) << v * 3.6;
+                    }
+                }
+                std::cout << std::setprecision(3) << std::endl;
+            }
+        }
+        std::cout << "Отсчетов: " << log.sampleCount() << ", блоков: " << log.blocks().size()
+                  << ", запрос: " << std::setprecision(1) << ms << " мс" << std::endl;
+        return 0;
+    }
+    
+    int delta(const std::string& path_a, const std::string& path_b, double step, int threads) {
+        TelemetryLog a, b;
+        if (!a.open(path_a) || !b.open(path_b)) {
+            std::cerr << "Не удалось открыть логи" << std::endl;
+            return 1;
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        std::vector<DeltaPoint> points = queryDelta(a, b, step, threads);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (points.empty()) {
+            std::cerr << "Нет общей дистанции (или канала position)" << std::endl;
+            return 1;
+        }
+        
+        // Сводка: итог и экстремумы; полная кривая - каждые ~500 м
+        auto worst = std::max_element(points.begin(), points.end(),
+                                      [](const DeltaPoint& x, const DeltaPoint& y) { return x.delta < y.delta; });
+        auto best = std::min_element(points.begin(), points.end(),
+                                     [](const DeltaPoint& x, const DeltaPoint& y) { return x.delta < y.delta; });
+        std::size_t stride = std::max<std::size_t>(1, static_cast<std::size_t>(500.0 / step));
+        
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "Дистанция [м]    A [с]      B [с]    Дельта B-A [с]" << std::endl;
+        for (std::size_t i = 0; i < points.size(); i += stride) {
+            const DeltaPoint& p = points[i];
+            std::cout << std::setw(12) << std::setprecision(0) << p.distance << std::setprecision(3)
+                      << std::setw(11) << p.time_a << std::setw(11) << p.time_b
+                      << std::setw(14) << p.delta << std::endl;
+        }
+        const DeltaPoint& last = points.back();
+        std::cout << "Итог на " << std::setprecision(0) << last.distance << " м: " << std::setprecision(3)
+                  << last.delta << " с; max " << worst->delta << " с (" << std::setprecision(0) << worst->distance
+                  << " м), min " << std::setprecision(3) << best->delta << " с (" << std::setprecision(0)
+                  << best->distance << " м)" << std::endl;
+        std::cout << "Точек: " << points.size() << ", запрос: " << std::setprecision(1) << ms << " мс" << std::endl;
+        return 0;
+    }
+    
+    int stats(const std::string& path, int threads) {
+        TelemetryLog log;
+        if (!log.open(path)) {
+            std::cerr << "Не удалось открыть лог " << path << std::endl;
+            return 1;
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        std::vector<StreamingStats> channels = queryChannelStats(log, StreamStatsConfig(), threads);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (channels.size() != log.channelNames().size()) {
+            std::cerr << "Лог испорчен" << std::endl;
+            return 1;
+        }
+        
+        std::cout << std::fixed << std::setprecision(3);
+        std::cout << "Канал           "      // setw считает байты UTF-8
+                  << std::setw(14) << "mean" << std::setw(14) << "std" << std::setw(14) << "min"
+                  << std::setw(14) << "p1" << std::setw(14) << "p50" << std::setw(14) << "p99"
+                  << std::setw(14) << "max" << std::endl;
+        for (std::size_t c = 0; c < channels.size(); c++) {
+            const StreamingStats& s = channels[c];
+            std::cout << std::left << std::setw(16) << log.channelNames()[c] << std::right
+                      << std::setw(14) << s.mean() << std::setw(14) << s.stddev() << std::setw(14) << s.min()
+                      << std::setw(14) << s.quantile(0.01) << std::setw(14) << s.quantile(0.5)
+                      << std::setw(14) << s.quantile(0.99) << std::setw(14) << s.max() << std::endl;
+        }
+        std::cout << "Отсчетов: " << log.sampleCount() << ", блоков: " << log.blocks().size()
+                  << ", квантили +-" << std::setprecision(0) << StreamStatsConfig().relative_accuracy * 100
+                  << "%, запрос: " << std::setprecision(1) << ms << " мс" << std::endl;
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string command = argc > 1 ? argv[1] : "";
+    
+    if (command == "record" && argc > 2) {
+        int lap_count = argc > 3 ? std::atoi(argv[3]) : 5;
+        double braking_margin = argc > 4 ? std::atof(argv[4]) : 0.6;
+        return record(argv[2], lap_count, braking_margin);
+    }
+    if (command == "laps" && argc > 2) {
+        std::string channel = argc > 3 ? argv[3] : "velocity";
+        std::string filter = argc > 4 ? argv[4] : "";
+        int threads = argc > 5 ? std::atoi(argv[5]) : 0;
+        return laps(argv[2], channel, filter, threads);
+    }
+    if (command == "delta" && argc > 3) {
+        double step = argc > 4 ? std::atof(argv[4]) : 10.0;
+        int threads = argc > 5 ? std::atoi(argv[5]) : 0;
+        return delta(argv[2], argv[3], step, threads);
+    }
+    if (command == "stats" && argc > 2) {
+        int threads = argc > 3 ? std::atoi(argv[3]) : 0;
+        return stats(argv[2], threads);
+    }
+    
+    std::cerr << "Использование:\n"
+              << "  f1_query record <лог> [круги=5] [запас торможения=0.6]\n"
+              << "  f1_query laps <лог> [канал=velocity] [канал:мин:макс] [потоков=0]\n"
+              << "  f1_query delta <лог A> <лог B> [шаг, м=10] [потоков=0]\n"
+              << "  f1_query stats <лог> [потоков=0]" << std::endl;
+    return 1;
+}
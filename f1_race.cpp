@@ -0,0 +1,75 @@
+#include "F1_Race.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+// Гонка машин под автопилотами на демо-трассе: слипстрим, грязный воздух,
+// DRS с аэрокартой, блокировки и обгоны. В конце - протокол и скорость счета
+// против реального времени.
+// Запуск: f1_race [машин=20] [кругов=3]
+int main(int argc, char** argv) {
+    int car_count = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20;
+    int laps = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+    const double dt = 0.01;
+    
+    Track track = Track::demoCircuit();
+    F1PhysicsEngine::CarParameters params;
+    params.track_length = track.length;
+    ErsDeploymentMap deployment_map = buildDeploymentMap(SpeedProfile::fromTrack(track, params), params);
+    
+    F1Race race(car_count, RaceParameters(), params);
+    race.setDeploymentMap(&deployment_map);
+    race.setTrack(&track);
+    RaceDrivers drivers(track, params, car_count);
+    std::vector<F1Race::CarControl> controls;
+    
+    std::vector<double> best_lap(car_count, std::numeric_limits<double>::infinity());
+    std::vector<int> last_lap(car_count);
+    for (int i = 0; i < car_count; i++) {
+        last_lap[i] = race.car(i).getState().lap;
+    }
+    long steps = 0;
+    long slipstream_steps = 0;          // Машино-шаги с drag_factor < 1
+    long drs_steps = 0;
+    
+    std::printf("=== ГОНКА: %s, %d машин, %d кругов ===\n", track.name.c_str(), car_count, laps);
+    auto start = std::chrono::steady_clock::now();
+    double max_time = laps * 250.0;
+    while (race.car(race.classification()[0]).getState().lap < laps && race.car(0).getState().time < max_time) {
+        drivers.control(race, dt, controls);
+        race.step(dt, controls);
+        steps++;
+        
+        for (int i = 0; i < car_count; i++) {
+            const F1PhysicsEngine& car = race.car(i);
+            slipstream_steps += car.getSlipstreamDragFactor() < 1.0;
+            drs_steps += car.isDrsOpen();
+            if (car.getState().lap != last_lap[i]) {
+                last_lap[i] = car.getState().lap;
+                if (last_lap[i] > 1) {      // Первый круг - со старта с места
+                    best_lap[i] = std::min(best_lap[i], car.getSlowState().last_lap_time);
+                }
+            }
+        }
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::printf("Поз  Машина  Круг   Отставание [м]   Лучший круг [с]\n");
+    const std::vector<int>& order = race.classification();
+    for (int k = 0; k < car_count; k++) {
+        int i = order[k];
+        std::printf("%3d  %6d  %4d   %14.1f   %15.3f\n", k + 1, i, race.car(i).getState().lap, race.gapAhead(i),
+                    best_lap[i]);
+    }
+    
+    double sim_time = steps * dt;
+    double car_steps = static_cast<double>(steps) * car_count;
+    std::printf("Обгонов: %d; в слипстриме %.1f%% машино-шагов, с открытым DRS %.1f%%\n", race.overtakeCount(),
+                100.0 * slipstream_steps / car_steps, 100.0 * drs_steps / car_steps);
+    std::printf("Время гонки %.1f с за %.3f с счета: x%.0f к реальному времени, %.1f нс на машино-шаг\n",
+                sim_time, elapsed, sim_time / elapsed, elapsed * 1e9 / car_steps);
+    return 0;
+}
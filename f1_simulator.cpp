@@ -1,42 +1,469 @@
 #include "F1_Physics_build_2.h"
+#include "F1_Driver.h"
+#include "F1_Ghost.h"
+#include "F1_Input.h"
+#include "F1_PerfCounters.h"
+#include "F1_Replay.h"
+#include "F1_Telemetry.h"
+#include "F1_TelemetryLog.h"
 #include <ncurses.h>
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <cmath>
 #include <thread>
 #include <chrono>
 #include <iostream>
+#include <string>
 
-int main() {
-    // Инициализация ncurses
+namespace {
+    // Скорости воспроизведения
+    constexpr double REPLAY_SPEEDS[] = {0.1, 0.25, 0.5, 1.0, 2.0, 5.0, 10.0, 25.0, 50.0, 100.0};
+    constexpr int REPLAY_SPEED_COUNT = sizeof(REPLAY_SPEEDS) / sizeof(REPLAY_SPEEDS[0]);
+    
+    // Панель производительности: под основной панелью (с PERF_BELOW_ROW) или
+    // справа от нее (с PERF_SIDE_COLUMN), размер - с задержкой ввода рядом
+    constexpr int PERF_BELOW_ROW = 39;
+    constexpr int PERF_SIDE_COLUMN = 90;
+    constexpr int PERF_PANEL_ROWS = 7 + PERF_RENDER;    // Заголовок, 6 строк, стадии шага
+    constexpr int PERF_PANEL_WIDTH = 50;
+    
+    // Все, что показывает панель, за один шаг физики. Физический поток пишет
+    // его в SnapshotSlot после шага, поток вывода читает только его
+    struct DashboardFrame {
+        TelemetryFrame telemetry;       // Дистанция и время круга - для призрака
+        F1PhysicsEngine::CarState state;
+        F1PhysicsEngine::SlowState slow;
+        F1PhysicsEngine::ForceBreakdown forces;
+        std::array<F1PhysicsEngine::Point2D, 4> wheels;
+        double wheel_rpm;
+        double battery_soc;
+        double speed;
+        double ride_height;
+        double aero_balance;
+        bool drs_open;
+        bool gas;
+        bool brake;
+    };
+    
+    DashboardFrame makeDashboardFrame(const F1PhysicsEngine& engine, const TelemetryFrame& telemetry,
+                                      bool gas, bool brake) {
+        DashboardFrame frame;
+        frame.telemetry = telemetry;
+        frame.state = engine.getState();
+        frame.slow = engine.getSlowState();
+        frame.forces = engine.getForces();
+        frame.wheels = engine.getWheelPositions();
+        frame.wheel_rpm = engine.getWheelRPM();
+        frame.battery_soc = engine.getBatterySOC();
+        frame.speed = engine.getSpeed();
+        frame.ride_height = engine.getRideHeight();
+        frame.aero_balance = engine.getAeroBalance();
+        frame.drs_open = engine.isDrsOpen();
+        frame.gas = gas;
+        frame.brake = brake;
+        return frame;
+    }
+    
+    // Просмотр записанного заезда: та же панель по каналам лога, время
+    // воспроизведения идет со скоростью 0.1x-100x, перемотка - поиском в логе.
+    // Физика не считается; в кадр попадает один интерполированный отсчет
+    int runReplay(const std::string& path) {
+        TelemetryReplay replay;
+        if (!replay.open(path)) {
+            std::cerr << "Не удалось открыть лог " << path << std::endl;
+            return 1;
+        }
+        const TelemetryLog& log = replay.log();
+        std::vector<double> values(replay.channelCount());
+        auto channel = [&](const char* name) {
+            int index = log.channelIndex(name);
+            return index >= 0 ? values[index] : 0.0;
+        };
+        const double battery_capacity = F1PhysicsEngine::CarParameters().ers.battery_capacity;
+        const double duration = (replay.endTime() - replay.startTime()) / 1e9;
+        
+        initscr();
+        cbreak();
+        noecho();
+        curs_set(0);
+        
+        InputEventQueue input_events;
+        KeyboardInput keyboard(input_events);
+        keyboard.start();
+        
+        std::int64_t position_ns = replay.startTime();
+        int speed = 3;                  // 1x
+        bool paused = false;
+        bool running = true;
+        std::int64_t last_frame_ns = KeyboardInput::nowNs();
+        double lookup_us = 0.0;
+        
+        while (running) {
+            std::int64_t frame_start_ns = KeyboardInput::nowNs();
+            if (!paused) {
+                position_ns += static_cast<std::int64_t>((frame_start_ns - last_frame_ns) * REPLAY_SPEEDS[speed]);
+            }
+            last_frame_ns = frame_start_ns;
+            
+            InputEvent event;
+            while (input_events.pop(event)) {
+                if (event.type == InputEvent::Release) {
+                    continue;
+                }
+                bool press = event.type == InputEvent::Press;
+                switch (event.key) {
+                    case ' ': // Пробел - пауза (в конце записи - заново с начала)
+                        if (press) {
+                            paused = !paused;
+                            if (!paused && position_ns >= replay.endTime()) {
+                                position_ns = replay.startTime();
+                            }
+                        }
+                        break;
+                    
+                    case InputKey::Up: // Стрелки вверх/вниз - скорость
+                        if (press) speed = std::min(speed + 1, REPLAY_SPEED_COUNT - 1);
+                        break;
+                    
+                    case InputKey::Down:
+                        if (press) speed = std::max(speed - 1, 0);
+                        break;
+                    
+                    case InputKey::Left: // Стрелки влево/вправо - 5 с назад/вперед (с автоповтором)
+                        position_ns -= 5000000000LL;
+                        break;
+                    
+                    case InputKey::Right:
+                        position_ns += 5000000000LL;
+                        break;
+                    
+                    case ',': // , и . - минута назад/вперед
+                        position_ns -= 60000000000LL;
+                        break;
+                    
+                    case '.':
+                        position_ns += 60000000000LL;
+                        break;
+                    
+                    case InputKey::Escape: // ESC - выход
+                        running = false;
+                        break;
+                    
+                    default: // 0-9 - переход на 0%-90% записи
+                        if (press && event.key >= '0' && event.key <= '9') {
+                            position_ns = replay.startTime()
+                                        + (replay.endTime() - replay.startTime()) / 10 * (event.key - '0');
+                        }
+                        break;
+                }
+            }
+            position_ns = std::min(std::max(position_ns, replay.startTime()), replay.endTime());
+            if (position_ns == replay.endTime()) {
+                paused = true;
+            }
+            
+            std::int64_t lookup_start_ns = KeyboardInput::nowNs();
+            bool sampled = replay.sample(position_ns, values.data());
+            lookup_us = (KeyboardInput::nowNs() - lookup_start_ns) / 1e3;
+            
+            clear();
+            mvprintw(0, 0, "=== FORMULA 1 TELEMETRY REPLAY ===");
+            mvprintw(1, 0, "===================================");
+            
+            // Воспроизведение
+            double time = (position_ns - replay.startTime()) / 1e9;
+            mvprintw(2, 0, "PLAYBACK: %s", path.c_str());
+            mvprintw(3, 2, "Time: %.2f / %.2f s  %s", time, duration, paused ? "[PAUSED]" : "");
+            mvprintw(4, 2, "Speed: %gx", REPLAY_SPEEDS[speed]);
+            int bar_width = 60;
+            int filled = duration > 0.0 ? static_cast<int>(time / duration * bar_width) : bar_width;
+            mvprintw(5, 2, "[");
+            for (int i = 0; i < bar_width; i++) {
+                addch(i < filled ? '=' : ' ');
+            }
+            printw("]");
+            mvprintw(6, 2, "Lookup: %.1f us, blocks decoded: %llu (log has %zu)%s", lookup_us,
+                     static_cast<unsigned long long>(replay.blockDecodes()), log.blocks().size(),
+                     sampled ? "" : "  [CORRUPT BLOCK]");
+            
+            // Двигатель и трансмиссия
+            mvprintw(8, 0, "ENGINE AND TRANSMISSION:");
+            mvprintw(9, 2, "Current Gear: %.0f", channel("gear"));
+            mvprintw(10, 2, "Engine RPM: %.0f", channel("engine_rpm"));
+            
+            // Система рекуперации
+            mvprintw(8, 45, "ERS:");
+            mvprintw(9, 47, "Battery: %.0f%%", channel("battery_energy") / battery_capacity * 100.0);
+            mvprintw(10, 47, "Energy: %.2f MJ", channel("battery_energy") / 1e6);
+            
+            // Скорость и движение
+            mvprintw(12, 0, "SPEED AND MOTION:");
+            mvprintw(13, 2, "Speed: %.1f km/h", channel("velocity") * 3.6);
+            mvprintw(14, 2, "Position X: %.1f m", channel("position"));
+            mvprintw(15, 2, "Lap: %.0f", channel("lap"));
+            mvprintw(16, 2, "Lap Distance: %.1f m", channel("lap_distance"));
+            
+            // Топливо и шины
+            mvprintw(12, 45, "FUEL AND TIRES:");
+            mvprintw(13, 47, "Fuel: %.1f kg", channel("fuel_mass"));
+            mvprintw(14, 47, "Mass: %.1f kg", channel("mass"));
+            mvprintw(15, 47, "Tire Wear: %.1f%%  Grip: %.3f", channel("tire_wear") * 100.0, channel("tire_grip"));
+            
+            // Силы
+            mvprintw(18, 0, "FORCES:");
+            mvprintw(19, 2, "Down Force: %.1f N", channel("down_force"));
+            mvprintw(20, 2, "Brake Factor: %.2f", channel("brake_factor"));
+            
+            // Прогресс оборотов
+            double rpm_progress = (channel("engine_rpm") / 15000.0) * 100;
+            mvprintw(22, 0, "RPM PROGRESS: %.1f%%", rpm_progress);
+            int rpm_filled = (rpm_progress / 100.0) * 40;
+            mvprintw(23, 0, "[");
+            for (int i = 0; i < 40; i++) {
+                addch(i < rpm_filled ? '|' : ' ');
+            }
+            printw("]");
+            
+            // Управление
+            mvprintw(25, 0, "CONTROLS:");
+            mvprintw(26, 2, "SPACE - Pause");
+            mvprintw(27, 2, "UP/DOWN Arrow - Faster/slower (0.1x-100x)");
+            mvprintw(28, 2, "LEFT/RIGHT Arrow - Seek -/+5 s");
+            mvprintw(29, 2, ", / . - Seek -/+60 s");
+            mvprintw(30, 2, "0-9 - Jump to 0%%-90%%");
+            mvprintw(31, 2, "ESC - Exit");
+            
+            refresh();
+            std::this_thread::sleep_for(std::chrono::milliseconds(33)); // ~30 FPS
+        }
+        
+        keyboard.stop();
+        endwin();
+        return 0;
+    }
+}
+
+// f1_simulator [шина телеметрии=/f1_telemetry] - кадры каждого шага для f1_telemetry_view
+// f1_simulator ... record <лог>  - еще и лог машины (кадр на шаг) для просмотра и призрака
+// f1_simulator ... ghost <лог>   - разница с самым быстрым кругом лога на панели
+// f1_simulator replay <лог>      - просмотр лога: 0.1x-100x, пауза, перемотка
+int main(int argc, char** argv) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    if (mode == "replay") {
+        if (argc < 3) {
+            std::cerr << "Использование: f1_simulator replay <лог>" << std::endl;
+            return 1;
+        }
+        return runReplay(argv[2]);
+    }
+    
+    // Имя шины - только первым и с '/', как у shm_open; остальное - ключевые
+    // слова с путем. Неизвестное - ошибка, а не имя шины
+    std::string telemetry_bus_name = "/f1_telemetry";
+    std::string log_path;
+    std::string ghost_path;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "record" && i + 1 < argc) {
+            log_path = argv[++i];
+        } else if (arg == "ghost" && i + 1 < argc) {
+            ghost_path = argv[++i];
+        } else if (i == 1 && arg.size() > 1 && arg[0] == '/') {
+            telemetry_bus_name = arg;
+        } else {
+            std::cerr << "Неизвестный аргумент: " << arg << "\n"
+                      << "Использование: f1_simulator [/шина] [record <лог>] [ghost <лог>]\n"
+                      << "               f1_simulator replay <лог>" << std::endl;
+            return 1;
+        }
+    }
+    
+    // Опорный круг: лог должен быть записан на трассе той же длины
+    GhostLap ghost;
+    if (!ghost_path.empty()) {
+        if (!ghost.load(ghost_path)) {
+            std::cerr << "Нет опорного круга: " << ghost_path << " - не лог или в нем нет полного круга" << std::endl;
+            return 1;
+        }
+        if (std::abs(ghost.trackLength() - Track::demoCircuit().length) > 1e-6) {
+            std::cerr << "Лог " << ghost_path << " записан на трассе " << ghost.trackLength() << " м" << std::endl;
+            return 1;
+        }
+    }
+    
+    // Инициализация ncurses (только вывод - клавиатуру читает поток ввода)
     initscr();
     cbreak();
     noecho();
-    keypad(stdscr, TRUE);
-    nodelay(stdscr, TRUE);
     curs_set(0);
     
-    // Создаем физический движок F1
-    F1PhysicsEngine f1_engine;
+    // Создаем физический движок F1 на демо-трассе: карта отдачи ERS - по ее
+    // профилю скорости, аэродинамика - по карте граунд-эффекта (с DRS),
+    // температуры тормозов и шин включены
+    Track track = Track::demoCircuit();
+    F1PhysicsEngine::CarParameters car_params;
+    car_params.track_length = track.length;
+    car_params.thermal.enabled = true;
+    ErsDeploymentMap deployment_map = buildDeploymentMap(SpeedProfile::fromTrack(track, car_params), car_params);
+    AeroMap aero_map = AeroMap::groundEffectCar(car_params.drag_coefficient, car_params.downforce_coefficient);
+    F1PhysicsEngine f1_engine(car_params);
+    f1_engine.setDeploymentMap(&deployment_map);
+    f1_engine.setAeroMap(&aero_map);
+    f1_engine.enableForceBreakdown(true);  // Панель сил читает разбивку каждого кадра
     
     std::atomic<bool> running(true);
-    std::atomic<bool> gas_pressed(false);
-    std::atomic<bool> brake_pressed(false);
+    std::atomic<bool> show_perf(true);
     double steering = 0.0;
     
-    // Поток для обновления физики
+    // Здоровье самого симулятора: пишут потоки физики и вывода, читает панель
+    SimulatorPerfCounters perf;
+    
+    // Шина телеметрии для внешних процессов; без нее симулятор работает как обычно
+    TelemetryPublisher telemetry;
+    bool telemetry_open = telemetry.open(telemetry_bus_name);
+    
+    // Снимок для панели: поток вывода не трогает машину, которую шагает физика
+    SnapshotSlot<DashboardFrame> dashboard;
+    
+    // Лог машины для f1_simulator replay. Время лога - сумма шагов: сброс
+    // машины не должен вести время назад
+    TelemetryLogWriter telemetry_log;
+    bool log_open = !log_path.empty()
+                    && telemetry_log.openCarLog(log_path, f1_engine.getParameters().track_length);
+    
+    // Поток ввода: сырой режим терминала один раз, ожидание в poll()
+    InputEventQueue input_events;
+    LatencyHistogram input_latency;
+    KeyboardInput keyboard(input_events);
+    keyboard.start();
+    
+    // Поток для обновления физики. Все изменения машины - только здесь:
+    // события клавиатуры применяются в начале шага.
     std::thread physics_thread([&]() {
+        const double dt = 0.01;
+        const auto tick = std::chrono::microseconds(10000);
+        auto next_tick = std::chrono::steady_clock::now();
+        bool gas = false;
+        bool brake = false;
+        double log_time = 0.0;
+        
+        // Время нажатий, попавших в этот шаг (для гистограммы задержки)
+        std::int64_t press_times[32];
+        int press_count = 0;
+        
         while (running) {
+            std::int64_t step_start_ns = KeyboardInput::nowNs();
+            InputEvent event;
+            while (input_events.pop(event)) {
+                bool down = event.type != InputEvent::Release;
+                bool press = event.type == InputEvent::Press;
+                
+                switch (event.key) {
+                    case 'w': // W - педаль газа
+                    case 'W':
+                        gas = down;
+                        break;
+                    
+                    case 's': // S - тормоз
+                    case 'S':
+                        brake = down;
+                        break;
+                    
+                    case InputKey::Left: // Стрелка влево - понижение передачи
+                        if (press) f1_engine.shiftDown();
+                        break;
+                    
+                    case InputKey::Right: // Стрелка вправо - повышение передачи
+                        if (press) f1_engine.shiftUp();
+                        break;
+                    
+                    case 'r': // R - сброс
+                    case 'R':
+                        if (press) f1_engine.reset();
+                        break;
+                    
+                    case 'd': // D - DRS открыть/закрыть
+                    case 'D':
+                        if (press) f1_engine.setDrs(!f1_engine.isDrsOpen());
+                        break;
+                    
+                    case 'p': // P - панель производительности
+                    case 'P':
+                        if (press) show_perf = !show_perf;
+                        break;
+                    
+                    case InputKey::Escape: // ESC - выход
+                        running = false;
+                        break;
+                }
+                
+                if (press && press_count < 32) {
+                    press_times[press_count++] = event.timestamp_ns;
+                }
+            }
+            
+            std::int64_t input_done_ns = KeyboardInput::nowNs();
+            
             // Обновляем физику с временным шагом 0.01 секунды
-            f1_engine.update(0.01, gas_pressed, brake_pressed, steering);
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            f1_engine.update(dt, gas, brake, steering);
+            std::int64_t physics_done_ns = KeyboardInput::nowNs();
+            TelemetryFrame frame = makeTelemetryFrame(f1_engine);
+            telemetry.publish(frame);
+            dashboard.store(makeDashboardFrame(f1_engine, frame, gas, brake));
+            if (log_open) {
+                log_time += dt;
+                frame.time = log_time;
+                telemetry_log.appendFrame(frame);
+            }
+            // Нажатие дошло до физики, когда шаг с ним посчитан
+            std::int64_t now_ns = KeyboardInput::nowNs();
+            perf.stages[PERF_INPUT].record(input_done_ns - step_start_ns);
+            perf.stages[PERF_PHYSICS].record(physics_done_ns - input_done_ns);
+            perf.stages[PERF_TELEMETRY].record(now_ns - physics_done_ns);
+            perf.steps.fetch_add(1, std::memory_order_relaxed);
+            perf.simulated_ns.fetch_add(static_cast<std::int64_t>(dt * 1e9), std::memory_order_relaxed);
+            for (int i = 0; i < press_count; i++) {
+                input_latency.record(now_ns - press_times[i]);
+            }
+            press_count = 0;
+            
+            // Шаги по абсолютному расписанию: время расчета не копится в отставание.
+            // После долгой паузы (остановка процесса) догонять не пытаемся.
+            next_tick += tick;
+            auto now = std::chrono::steady_clock::now();
+            if (now > next_tick) {
+                perf.late_steps.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (now - next_tick > std::chrono::milliseconds(100)) {
+                perf.dropped_steps.fetch_add((now - next_tick) / tick, std::memory_order_relaxed);
+                next_tick = now;
+            }
+            std::this_thread::sleep_until(next_tick);
         }
     });
     
-    // Основной цикл обработки ввода и вывода
+    // Основной цикл вывода. Окно панели производительности - полсекунды
+    PerfSampler perf_sampler(100.0);
+    PerfSnapshot perf_window;
+    std::int64_t next_perf_sample_ns = 0;
+    DashboardFrame frame{};
+    bool have_frame = false;
     while (running) {
+        std::int64_t frame_start_ns = KeyboardInput::nowNs();
+        if (frame_start_ns >= next_perf_sample_ns) {
+            perf_sampler.sample(perf, frame_start_ns, perf_window);
+            next_perf_sample_ns = frame_start_ns + 500000000;
+        }
         clear();
         
-        // Получаем текущее состояние автомобиля
-        auto state = f1_engine.getState();
+        // Состояние автомобиля - из снимка одного шага. Не прочитался (писатель
+        // занимал слот) - остается прошлый кадр; до первого шага - нули
+        have_frame = dashboard.load(frame) || have_frame;
+        const auto& state = frame.state;
+        const auto& slow = frame.slow;
+        const auto& forces = frame.forces;
+        const auto& wheels = frame.wheels;
         
         // Выводим информацию
         mvprintw(0, 0, "=== FORMULA 1 PHYSICS SIMULATION ===");
@@ -46,48 +473,89 @@ int main() {
         mvprintw(2, 0, "ENGINE AND TRANSMISSION:");
         mvprintw(3, 2, "Current Gear: %d", state.current_gear);
         mvprintw(4, 2, "Engine RPM: %.0f", state.engine_rpm);
-        mvprintw(5, 2, "Engine Torque: %.1f Nm", state.engine_torque);
-        mvprintw(6, 2, "Wheel RPM: %.1f", state.wheel_rpm);
-        mvprintw(7, 2, "Wheel Torque: %.1f Nm", state.wheel_torque);
+        mvprintw(5, 2, "Engine Torque: %.1f Nm", forces.engine_torque);
+        mvprintw(6, 2, "Wheel RPM: %.1f", frame.wheel_rpm);
+        mvprintw(7, 2, "Wheel Torque: %.1f Nm", forces.wheel_torque);
+        mvprintw(8, 2, "Clutch: %s%s", state.clutch_locked ? "LOCKED" : "SLIPPING",
+                 state.rev_limiter_active ? "  [REV LIMITER]" : "");
+        
+        // Система рекуперации
+        mvprintw(2, 45, "ERS:");
+        mvprintw(3, 47, "Battery: %.0f%%", frame.battery_soc * 100.0);
+        mvprintw(4, 47, "MGU-K Torque: %.1f Nm", forces.ers_torque);
+        mvprintw(5, 47, "Lap %d Deployed: %.2f MJ", state.lap, state.lap_deployed_energy / 1e6);
+        mvprintw(6, 47, "Lap %d Harvested: %.2f MJ", state.lap, state.lap_harvested_energy / 1e6);
+        
+        // Топливо и шины
+        mvprintw(9, 45, "FUEL AND TIRES:");
+        mvprintw(10, 47, "Fuel: %.1f kg%s", slow.fuel_mass, state.out_of_fuel ? "  [EMPTY]" : "");
+        mvprintw(11, 47, "Mass: %.1f kg", state.mass);
+        mvprintw(12, 47, "Tire Wear: %.1f%%  Grip: %.3f", slow.tire_wear * 100.0, state.tire_grip);
+        
+        // Температуры по углам (0=FL, 1=FR, 2=RL, 3=RR) и их множители
+        const ThermalState& thermal = slow.thermal;
+        mvprintw(14, 45, "TEMPERATURES (C):");
+        mvprintw(15, 47, "Brakes FL/FR: %.0f / %.0f", thermal.brake_temperature[0], thermal.brake_temperature[1]);
+        mvprintw(16, 47, "Brakes RL/RR: %.0f / %.0f", thermal.brake_temperature[2], thermal.brake_temperature[3]);
+        mvprintw(17, 47, "Tires FL/FR: %.0f / %.0f", thermal.tire_temperature[0], thermal.tire_temperature[1]);
+        mvprintw(18, 47, "Tires RL/RR: %.0f / %.0f", thermal.tire_temperature[2], thermal.tire_temperature[3]);
+        mvprintw(19, 47, "Brake Efficiency: %.2f  Grip: x%.3f", thermal.brake_efficiency, thermal.grip_factor);
         
         // Скорость и движение
         mvprintw(9, 0, "SPEED AND MOTION:");
-        mvprintw(10, 2, "Speed: %.1f km/h", state.speed * 3.6);
+        mvprintw(10, 2, "Speed: %.1f km/h", frame.speed * 3.6);
         mvprintw(11, 2, "Position X: %.1f m", state.position.x);
-        mvprintw(12, 2, "Acceleration: %.1f m/s²", state.acceleration.x);
+        mvprintw(12, 2, "Acceleration: %.1f m/s²", forces.acceleration);
         
         // Силы
         mvprintw(14, 0, "FORCES:");
-        mvprintw(15, 2, "Traction Force: %.1f N", state.traction_force);
-        mvprintw(16, 2, "Drag Force: %.1f N", state.drag_force);
-        mvprintw(17, 2, "Brake Force: %.1f N", state.brake_force);
-        mvprintw(18, 2, "Down Force: %.1f N", state.down_force);
+        mvprintw(15, 2, "Traction Force: %.1f N", forces.traction_force);
+        mvprintw(16, 2, "Drag Force: %.1f N", forces.drag_force);
+        mvprintw(17, 2, "Brake Force: %.1f N", forces.brake_force);
+        mvprintw(18, 2, "Down Force: %.1f N", forces.down_force);
         mvprintw(19, 2, "Brake Factor: %.2f", state.brake_factor);
+        mvprintw(20, 2, "DRS: %s  Ride Height: %.1f mm  Balance: %.1f%%", frame.drs_open ? "OPEN" : "CLOSED",
+                 frame.ride_height * 1000.0, frame.aero_balance * 100.0);
         
         // Координаты колес
         mvprintw(21, 0, "WHEEL POSITIONS:");
-        mvprintw(22, 2, "FL: (%.1f, %.1f)", state.wheel_positions[0].x, state.wheel_positions[0].y);
-        mvprintw(23, 2, "FR: (%.1f, %.1f)", state.wheel_positions[1].x, state.wheel_positions[1].y);
-        mvprintw(24, 2, "RL: (%.1f, %.1f)", state.wheel_positions[2].x, state.wheel_positions[2].y);
-        mvprintw(25, 2, "RR: (%.1f, %.1f)", state.wheel_positions[3].x, state.wheel_positions[3].y);
+        mvprintw(22, 2, "FL: (%.1f, %.1f)", wheels[0].x, wheels[0].y);
+        mvprintw(23, 2, "FR: (%.1f, %.1f)", wheels[1].x, wheels[1].y);
+        mvprintw(24, 2, "RL: (%.1f, %.1f)", wheels[2].x, wheels[2].y);
+        mvprintw(25, 2, "RR: (%.1f, %.1f)", wheels[3].x, wheels[3].y);
         
         // Управление
         mvprintw(27, 0, "CONTROLS:");
-        mvprintw(28, 2, "W - Gas: %s", gas_pressed ? "PRESSED" : "RELEASED");
-        mvprintw(29, 2, "S - Brake: %s", brake_pressed ? "PRESSED" : "RELEASED");
+        mvprintw(28, 2, "W - Gas: %s", frame.gas ? "PRESSED" : "RELEASED");
+        mvprintw(29, 2, "S - Brake: %s", frame.brake ? "PRESSED" : "RELEASED");
         mvprintw(30, 2, "LEFT Arrow - Shift down");
         mvprintw(31, 2, "RIGHT Arrow - Shift up");
         mvprintw(32, 2, "R - Reset");
-        mvprintw(33, 2, "ESC - Exit");
+        mvprintw(33, 2, "D - DRS");
+        mvprintw(34, 2, "P - Perf panel");
+        mvprintw(35, 2, "ESC - Exit");
+        
+        mvprintw(27, 45, "TELEMETRY BUS: %s", telemetry_open ? telemetry_bus_name.c_str() : "off");
+        mvprintw(28, 45, "TELEMETRY LOG: %s", log_open ? log_path.c_str() : "off");
+        
+        // Призрак считается здесь, по кадру панели: физический поток о нем не знает
+        const TelemetryFrame& ghost_frame = frame.telemetry;
+        if (ghost.loaded() && have_frame) {
+            GhostDelta delta = ghost.compare(ghost_frame.lap_distance, ghost_frame.lap_time, ghost_frame.velocity);
+            mvprintw(30, 45, "GHOST: lap %d, %.2f s", ghost.lap(), ghost.lapTime());
+            mvprintw(31, 47, "Delta: %+.3f s %s", delta.delta_time, delta.delta_time > 0 ? "(behind)" : "(ahead)");
+            mvprintw(32, 47, "Speed diff: %+.1f km/h", delta.velocity_delta * 3.6);
+            mvprintw(33, 47, "Ghost speed: %.1f km/h", delta.ghost_velocity * 3.6);
+        }
         
         // Прогресс оборотов
         double rpm_progress = (state.engine_rpm / 15000.0) * 100;
-        mvprintw(35, 0, "RPM PROGRESS: %.1f%%", rpm_progress);
+        mvprintw(36, 0, "RPM PROGRESS: %.1f%%", rpm_progress);
         
         // Простая текстовая шкала прогресса
         int bar_width = 40;
         int filled = (rpm_progress / 100.0) * bar_width;
-        mvprintw(36, 0, "[");
+        mvprintw(37, 0, "[");
         for (int i = 0; i < bar_width; i++) {
             if (i < filled) {
                 addch('|');
@@ -97,50 +565,60 @@ int main() {
         }
         printw("]");
         
-        // Обработка ввода
-        int ch = getch();
-        
-        switch (ch) {
-            case 'w': // W - педаль газа
-            case 'W':
-                gas_pressed = true;
-                break;
-                
-            case 's': // S - тормоз
-            case 'S':
-                brake_pressed = true;
-                break;
-                
-            case KEY_LEFT: // Стрелка влево - понижение передачи
-                f1_engine.shiftDown();
-                break;
-                
-            case KEY_RIGHT: // Стрелка вправо - повышение передачи
-                f1_engine.shiftUp();
-                break;
-                
-            case 'r': // R - сброс
-            case 'R':
-                f1_engine.reset();
-                gas_pressed = false;
-                brake_pressed = false;
-                break;
-                
-            case 27: // ESC - выход
-                running = false;
-                break;
-        }
-        
-        // Если клавиши отпущены
-        if (ch != 'w' && ch != 'W') {
-            gas_pressed = false;
-        }
-        
-        if (ch != 's' && ch != 'S') {
-            brake_pressed = false;
+        // Панель производительности: окно perf_window, задержка ввода - с начала.
+        // Место - по размеру терминала: под основной панелью, справа от нее или,
+        // если не влезает ни так, ни так, одной строкой в самом низу экрана
+        int screen_rows = 0;
+        int screen_cols = 0;
+        getmaxyx(stdscr, screen_rows, screen_cols);
+        bool perf_below = screen_rows >= PERF_BELOW_ROW + PERF_PANEL_ROWS;
+        bool perf_side = screen_cols >= PERF_SIDE_COLUMN + PERF_PANEL_WIDTH;
+        if (!show_perf) {
+            mvprintw(std::min(PERF_BELOW_ROW, screen_rows - 1), 0, "PERFORMANCE: hidden (P - show)");
+        } else if (perf_below || perf_side) {
+            int row = perf_below ? PERF_BELOW_ROW : 2;
+            int col = perf_below ? 0 : PERF_SIDE_COLUMN;
+            mvprintw(row, col, "PERFORMANCE (window %.1f s):", perf_window.interval);
+            mvprintw(row + 1, col + 2, "Steps/s: %.1f / %.0f target", perf_window.steps_per_second,
+                     perf_window.target_steps_per_second);
+            mvprintw(row + 2, col + 2, "Real-time factor: %.3fx", perf_window.real_time_factor);
+            mvprintw(row + 3, col + 2, "Late steps: %llu (total %llu)",
+                     static_cast<unsigned long long>(perf_window.late_steps),
+                     static_cast<unsigned long long>(perf_window.total_late_steps));
+            mvprintw(row + 4, col + 2, "Dropped steps: %llu (total %llu)",
+                     static_cast<unsigned long long>(perf_window.dropped_steps),
+                     static_cast<unsigned long long>(perf_window.total_dropped_steps));
+            mvprintw(row + 5, col + 2, "Render: %.1f FPS, frame %.2f ms (max %.2f ms)",
+                     perf_window.frames_per_second, perf_window.average_us[PERF_RENDER] / 1e3,
+                     perf_window.max_us[PERF_RENDER] / 1e3);
+            mvprintw(row + 6, col + 2, "Step cost, us (avg / max):");
+            for (int stage = PERF_INPUT; stage < PERF_RENDER; stage++) {
+                mvprintw(row + 7 + stage, col + 4, "%-10s %8.2f / %8.2f", perfStageName(stage),
+                         perf_window.average_us[stage], perf_window.max_us[stage]);
+            }
+            
+            // Задержка ввода: снизу - соседней колонкой, справа - под панелью
+            int latency_row = perf_below ? row : row + PERF_PANEL_ROWS + 1;
+            int latency_col = perf_below ? 45 : col;
+            mvprintw(latency_row, latency_col, "INPUT LATENCY (key -> physics):");
+            mvprintw(latency_row + 1, latency_col + 2, "Presses: %llu",
+                     static_cast<unsigned long long>(input_latency.count()));
+            mvprintw(latency_row + 2, latency_col + 2, "P50: <= %.2f ms", input_latency.percentileMs(0.5));
+            mvprintw(latency_row + 3, latency_col + 2, "P99: <= %.2f ms", input_latency.percentileMs(0.99));
+            mvprintw(latency_row + 4, latency_col + 2, "Max: %.2f ms", input_latency.maxNs() / 1e6);
+            mvprintw(latency_row + 5, latency_col + 2, "Dropped key events: %llu",
+                     static_cast<unsigned long long>(keyboard.droppedEvents()));
+        } else {
+            mvprintw(screen_rows - 1, 0, "PERF: %.0f steps/s, x%.3f real time, late %llu, dropped %llu, "
+                     "%.1f FPS, key P99 <= %.2f ms", perf_window.steps_per_second, perf_window.real_time_factor,
+                     static_cast<unsigned long long>(perf_window.late_steps),
+                     static_cast<unsigned long long>(perf_window.dropped_steps), perf_window.frames_per_second,
+                     input_latency.percentileMs(0.99));
         }
         
         refresh();
+        perf.stages[PERF_RENDER].record(KeyboardInput::nowNs() - frame_start_ns);
+        perf.frames.fetch_add(1, std::memory_order_relaxed);
         std::this_thread::sleep_for(std::chrono::milliseconds(33)); // ~30 FPS
     }
     
@@ -150,8 +628,18 @@ int main() {
         physics_thread.join();
     }
     
+    keyboard.stop();
+    telemetry.close();
+    bool log_written = log_open && telemetry_log.close();
     endwin();
     std::cout << "F1 Physics simulation stopped." << std::endl;
+    if (!telemetry_open) {
+        std::cout << "Telemetry bus " << telemetry_bus_name << " was not available." << std::endl;
+    }
+    if (!log_path.empty()) {
+        std::cout << (log_written ? "Telemetry log written: " : "Telemetry log failed: ") << log_path << std::endl;
+    }
+    input_latency.print(std::cout);
     
     return 0;
 }
@@ -0,0 +1,56 @@
+#include "F1_MonteCarlo.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+// Сравнение стратегий пит-стопов методом Монте-Карло.
+// Запуск: f1_strategy [выборок] [потоков] [кругов] [seed]
+int main(int argc, char** argv) {
+    MonteCarloConfig config;
+    config.samples = argc > 1 ? std::atoi(argv[1]) : 1000;
+    config.threads = argc > 2 ? std::atoi(argv[2]) : 0;
+    config.laps = argc > 3 ? std::atoi(argv[3]) : 50;
+    config.seed = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 1;
+    
+    Track track = Track::demoCircuit();
+    F1PhysicsEngine::CarParameters car;
+    
+    int third = config.laps / 3;
+    std::vector<PitStrategy> strategies = {
+        { "1 stop",  { config.laps / 2 } },
+        { "2 stops", { third, 2 * third } },
+        { "no stop", { } },
+    };
+    
+    std::cout << "=== MONTE CARLO: СТРАТЕГИИ ПИТ-СТОПОВ ===" << std::endl;
+    std::cout << track.name << ", " << config.laps << " кругов, "
+              << config.samples << " гонок на стратегию, seed " << config.seed << std::endl;
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<StrategyResult> results = runMonteCarlo(track, car, strategies, config);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "+------------+------------+------------+------------+------------+------------+------------+\n";
+    std::cout << "| Стратегия  |  Среднее   |   Сигма    |    P10     |    P50     |    P90     |   Сходы    |\n";
+    std::cout << "+------------+------------+------------+------------+------------+------------+------------+\n";
+    for (const StrategyResult& r : results) {
+        std::cout << "| " << std::setw(10) << r.strategy.name << " | "
+                  << std::setw(10) << r.race_time.mean() << " | "
+                  << std::setw(10) << r.race_time.stddev() << " | "
+                  << std::setw(10) << r.race_time.quantile(0.1) << " | "
+                  << std::setw(10) << r.race_time.quantile(0.5) << " | "
+                  << std::setw(10) << r.race_time.quantile(0.9) << " | "
+                  << std::setw(10) << r.dnf << " |\n";
+    }
+    std::cout << "+------------+------------+------------+------------+------------+------------+------------+\n";
+    
+    for (const StrategyResult& r : results) {
+        std::cout << r.strategy.name << ": круг " << r.lap_time.min() << " .. " << r.lap_time.max()
+                  << " с, медиана " << r.lap_time.quantile(0.5) << " с" << std::endl;
+    }
+    
+    std::cout << "Время расчета: " << elapsed << " с" << std::endl;
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "F1_Sweep.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Развертка стратегий пит-стопов на несколько процессов.
+// Запуск:
+//   f1_sweep coordinator [выборок] [воркеров] [кругов] [seed] [пачка] [сокет] [контрольная точка]
+//       воркеров - сколько запустить самому (0 - только внешние)
+//   f1_sweep worker [сокет] [обрыв на пачке]
+//       обрыв на пачке - оборвать соединение посреди N-й пачки (проверка восстановления)
+int main(int argc, char** argv) {
+    Track track = Track::demoCircuit();
+    F1PhysicsEngine::CarParameters car;
+    std::string mode = argc > 1 ? argv[1] : "";
+    
+    if (mode == "worker") {
+        std::string socket_path = argc > 2 ? argv[2] : SweepConfig().socket_path;
+        int crash_after = argc > 3 ? std::atoi(argv[3]) : -1;
+        return runSweepWorker(track, car, socket_path, crash_after) ? 0 : 1;
+    }
+    if (mode != "coordinator") {
+        std::cerr << "Использование: f1_sweep coordinator|worker ..." << std::endl;
+        return 2;
+    }
+    
+    MonteCarloConfig config;
+    SweepConfig sweep;
+    config.samples = argc > 2 ? std::atoi(argv[2]) : 1000;
+    sweep.local_workers = argc > 3 ? std::atoi(argv[3]) : 0;
+    config.laps = argc > 4 ? std::atoi(argv[4]) : 50;
+    config.seed = argc > 5 ? std::strtoull(argv[5], nullptr, 10) : 1;
+    sweep.batch_size = argc > 6 ? std::atoi(argv[6]) : 8;
+    if (argc > 7) {
+        sweep.socket_path = argv[7];
+    }
+    if (argc > 8) {
+        sweep.checkpoint_path = argv[8];
+    }
+    
+    // Те же стратегии, что у f1_strategy
+    int third = config.laps / 3;
+    std::vector<PitStrategy> strategies = {
+        { "1 stop",  { config.laps / 2 } },
+        { "2 stops", { third, 2 * third } },
+        { "no stop", { } },
+    };
+    
+    std::cout << "=== SWEEP: СТРАТЕГИИ ПИТ-СТОПОВ ===" << std::endl;
+    std::cout << track.name << ", " << config.laps << " кругов, " << config.samples
+              << " гонок на стратегию, seed " << config.seed << ", пачки по " << sweep.batch_size
+              << ", сокет " << sweep.socket_path << std::endl;
+    
+    auto start = std::chrono::steady_clock::now();
+    std::vector<StrategyResult> results;
+    SweepStats stats;
+    if (!runSweepCoordinator(track, car, strategies, config, sweep, results, &stats)) {
+        std::cerr << "Ошибка координатора: сокет " << sweep.socket_path << " или контрольная точка "
+                  << sweep.checkpoint_path << " (от другой задачи?)" << std::endl;
+        return 1;
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "+------------+------------+------------+------------+------------+------------+------------+\n";
+    std::cout << "| Стратегия  |  Среднее   |   Сигма    |    P10     |    P50     |    P90     |   Сходы    |\n";
+    std::cout << "+------------+------------+------------+------------+------------+------------+------------+\n";
+    for (const StrategyResult& r : results) {
+        std::cout << "| " << std::setw(10) << r.strategy.name << " | "
+                  << std::setw(10) << r.race_time.mean() << " | "
+                  << std::setw(10) << r.race_time.stddev() << " | "
+                  << std::setw(10) << r.race_time.quantile(0.1) << " | "
+                  << std::setw(10) << r.race_time.quantile(0.5) << " | "
+                  << std::setw(10) << r.race_time.quantile(0.9) << " | "
+                  << std::setw(10) << r.dnf << " |\n";
+    }
+    std::cout << "+------------+------------+------------+------------+------------+------------+------------+\n";
+    
+    std::cout << "Пачек: " << stats.batches << ", из контрольной точки " << stats.restored_batches
+              << ", переназначено " << stats.reassigned_batches << ", подключений " << stats.workers_seen
+              << ", результатов " << stats.result_bytes / 1024 << " КБ" << std::endl;
+    std::cout << "Время расчета: " << elapsed << " с" << std::endl;
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "F1_Telemetry.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+
+// Пример читателя шины телеметрии: подключается к работающему f1_simulator
+// (или любому издателю) и переподключается, если издатель перезапущен.
+//   f1_telemetry_view [шина=/f1_telemetry]        - сводка 10 раз в секунду
+//   f1_telemetry_view [шина=/f1_telemetry] csv    - каждый кадр строкой CSV
+int main(int argc, char** argv) {
+    std::string bus = argc > 1 ? argv[1] : "/f1_telemetry";
+    bool csv = argc > 2 && std::strcmp(argv[2], "csv") == 0;
+    
+    TelemetryReader reader;
+    TelemetryFrame frame;
+    
+    if (csv) {
+        std::printf("sequence,car,time,position_x,velocity,engine_rpm,gear,battery_energy,fuel_mass,tire_wear,lap,lap_distance\n");
+    }
+    
+    while (true) {
+        // Ожидание издателя
+        if (!reader.isAttached() || reader.writerGone()) {
+            reader.detach();
+            if (!reader.attach(bus)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+                continue;
+            }
+            std::fprintf(stderr, "Подключено к %s\n", bus.c_str());
+        }
+        
+        if (csv) {
+            // Все кадры по порядку; очередь пуста - короткий сон
+            bool any = false;
+            while (reader.next(frame)) {
+                any = true;
+                std::printf("%llu,%u,%.4f,%.3f,%.3f,%.0f,%d,%.0f,%.3f,%.5f,%d,%.3f\n",
+                            static_cast<unsigned long long>(frame.sequence), frame.car_id, frame.time,
+                            frame.position_x, frame.velocity, frame.engine_rpm, frame.gear,
+                            frame.battery_energy, frame.fuel_mass, frame.tire_wear, frame.lap,
+                            frame.lap_distance);
+            }
+            if (!any) {
+                std::fflush(stdout);
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            }
+            continue;
+        }
+        
+        // Сводка: только последний кадр, промежуточные не нужны
+        if (reader.latest(frame)) {
+            std::printf("\r[%8llu] t=%8.2f s  v=%6.1f km/h  rpm=%6.0f  gear=%d  lap=%d  %6.0f m  fuel=%5.1f kg%s%s   ",
+                        static_cast<unsigned long long>(frame.sequence), frame.time, frame.velocity * 3.6,
+                        frame.engine_rpm, frame.gear, frame.lap, frame.lap_distance, frame.fuel_mass,
+                        (frame.flags & TelemetryFrame::FLAG_REV_LIMITER) ? " LIMIT" : "",
+                        (frame.flags & TelemetryFrame::FLAG_OUT_OF_FUEL) ? " EMPTY" : "");
+            std::fflush(stdout);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+}
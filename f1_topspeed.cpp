@@ -0,0 +1,139 @@
+#include "F1_TopSpeed.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    // Максимум скорости за секунду: установившаяся - когда он от секунды к
+    // секунде больше не меняется, или передача дошла до отсечки (дальше
+    // скорость колеблется в ее гистерезисе и не растет)
+    constexpr double SETTLE_TOLERANCE = 1e-4;   // [м/с за секунду]
+    
+    struct SimulatedTopSpeed {
+        double speed = 0.0;             // [м/с]
+        double time = 0.0;              // Когда установилась (или кончился прогон) [с]
+        bool settled = false;
+    };
+    
+    // Прогон движка, как раньше отвечали на вопрос: полный газ, переключения
+    // вверх до передачи gear (на 13500 об/мин или когда разгон почти кончился -
+    // длинные передачи выше 13500 не раскручиваются), дальше она держится.
+    // Длинные передачи включаются выше своего баланса (короткая на отсечке
+    // быстрее) и оттуда медленно, почти по экспоненте, сползают к нему - поэтому
+    // прогон идет до установления, а не фиксированное время
+    SimulatedTopSpeed simulatedTopSpeed(const F1PhysicsEngine::CarParameters& car, int gear, double max_duration,
+                                        double dt) {
+        F1PhysicsEngine engine(car);
+        SimulatedTopSpeed result;
+        double window_max = 0.0;
+        bool window_limiter = false;
+        double window_end = 1.0;
+        double previous_max = -1.0;
+        int steps = static_cast<int>(max_duration / dt);
+        for (int i = 0; i < steps; i++) {
+            double previous_speed = engine.getState().velocity.x;
+            engine.update(dt, 1.0, 0.0);
+            const F1PhysicsEngine::CarState& s = engine.getState();
+            double acceleration = (s.velocity.x - previous_speed) / dt;
+            if (s.current_gear < gear && s.clutch_locked && (s.engine_rpm > 13500.0 || acceleration < 0.5)) {
+                engine.shiftUp();
+            }
+            window_max = std::max(window_max, s.velocity.x);
+            window_limiter = window_limiter || s.rev_limiter_active;
+            if (s.time >= window_end) {
+                result.speed = window_max;
+                result.time = s.time;
+                if (s.current_gear == gear
+                    && (window_limiter || std::abs(window_max - previous_max) < SETTLE_TOLERANCE)) {
+                    result.settled = true;
+                    break;
+                }
+                previous_max = window_max;
+                window_max = 0.0;
+                window_limiter = false;
+                window_end += 1.0;
+            }
+        }
+        return result;
+    }
+}
+
+// Максимальная скорость по передачам: корень тяга = сопротивление против
+// прогона движка до установления, и развертка по главной передаче через кэш.
+// Запуск: f1_topspeed [предел прогона на передачу, с]
+int main(int argc, char** argv) {
+    double duration = argc > 1 ? std::atof(argv[1]) : 1200.0;
+    
+    // Без MGU-K: у движка батарея кончается, и установившейся скорости с ним нет
+    F1PhysicsEngine::CarParameters car;
+    car.ers.mguk_max_power = 0.0;
+    car.ers.mguk_max_torque = 0.0;
+    EquilibriumConfig config;
+    config.fuel_mass = car.fuel_initial_mass;
+    
+    auto start = std::chrono::steady_clock::now();
+    TopSpeedResult analytic = solveTopSpeed(car, config);
+    double analytic_time = secondsSince(start);
+    
+    std::cout << "=== МАКСИМАЛЬНАЯ СКОРОСТЬ ПО ПЕРЕДАЧАМ (без MGU-K) ===" << std::endl;
+    std::cout << std::fixed;
+    std::cout << "+----------+------------+------------+------------+------------+------------+----------+\n";
+    std::cout << "| Передача |  Баланс    |  Отсечка   |  Предел    |  Обороты   |  Прогон    |  Время   |\n";
+    std::cout << "|          |  (км/ч)    |  (км/ч)    |  (км/ч)    |  (об/мин)  |  (км/ч)    |  (с)     |\n";
+    std::cout << "+----------+------------+------------+------------+------------+------------+----------+\n";
+    start = std::chrono::steady_clock::now();
+    double simulated_seconds = 0.0;
+    for (int gear = 1; gear <= analytic.gear_count; gear++) {
+        const GearLimit& limit = analytic.gears[gear - 1];
+        SimulatedTopSpeed simulated = simulatedTopSpeed(car, gear, duration, 0.01);
+        simulated_seconds += simulated.time;
+        std::cout << "| " << std::setw(8) << gear << " | " << std::setprecision(2)
+                  << std::setw(10) << limit.balance_speed * 3.6 << " | "
+                  << std::setw(10) << limit.rev_limit_speed * 3.6 << " | "
+                  << std::setw(10) << limit.top_speed * 3.6 << " | " << std::setprecision(0)
+                  << std::setw(10) << limit.top_speed_rpm << " | " << std::setprecision(2)
+                  << std::setw(10) << simulated.speed * 3.6 << " | " << std::setprecision(0)
+                  << std::setw(8) << simulated.time << " |" << (limit.rev_limited ? " отсечка" : "")
+                  << (simulated.settled ? "" : " не установилась") << "\n";
+    }
+    double simulated_time = secondsSince(start);
+    std::cout << "+----------+------------+------------+------------+------------+------------+----------+\n";
+    std::cout << "Максимум: " << std::setprecision(2) << analytic.top_speed * 3.6 << " км/ч на "
+              << analytic.top_gear << "-й передаче, " << std::setprecision(0) << analytic.top_speed_rpm
+              << " об/мин" << std::endl;
+    std::cout << "Корни: " << std::setprecision(1) << analytic_time * 1e6 << " мкс, прогон "
+              << analytic.gear_count << " передач, " << std::setprecision(0) << simulated_seconds << " с: "
+              << std::setprecision(1) << simulated_time * 1000.0 << " мс" << std::endl;
+    
+    // Развертка по главной передаче дважды: второй проход целиком из кэша
+    std::cout << "\n=== РАЗВЕРТКА ПО ГЛАВНОЙ ПЕРЕДАЧЕ (с MGU-K) ===" << std::endl;
+    config.ers_deploy = true;
+    F1PhysicsEngine::CarParameters swept;
+    TopSpeedCache cache;
+    for (int pass = 0; pass < 2; pass++) {
+        start = std::chrono::steady_clock::now();
+        double best_speed = 0.0;
+        double best_final_drive = 0.0;
+        for (int i = 0; i <= 150; i++) {
+            swept.final_drive = 3.0 + 0.01 * i;
+            const TopSpeedResult& r = cache.solve(swept, config);
+            if (r.top_speed > best_speed) {
+                best_speed = r.top_speed;
+                best_final_drive = swept.final_drive;
+            }
+        }
+        std::cout << "Проход " << pass + 1 << ": " << std::setprecision(2) << best_speed * 3.6
+                  << " км/ч при final_drive = " << best_final_drive << ", " << std::setprecision(1)
+                  << secondsSince(start) * 1e6 << " мкс (попаданий " << cache.hits() << ", промахов "
+                  << cache.misses() << ")" << std::endl;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "F1_Tuning.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    void printResult(const char* method, const TuningResult& r, const std::vector<TuningBound>& bounds,
+                     double elapsed) {
+        std::cout << method << ": " << std::setprecision(4) << r.time << " с за " << r.evaluations
+                  << " вычислений (" << std::setprecision(1) << elapsed * 1000.0 << " мс)";
+        for (const TuningBound& b : bounds) {
+            std::cout << ", " << tuningParameterName(b.parameter) << " = " << std::setprecision(3)
+                      << tuningParameter(r.car, b.parameter);
+        }
+        std::cout << std::endl;
+    }
+    
+    double secondsSince(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    
+    // Градиентный спуск против перебора по сетке на одной задаче. Сетка считает
+    // время настоящим F1PhysicsEngine, спуск - тем же шагом на Dual; итог спуска
+    // перепроверяется движком. Спуск локальный:
+    // время круга по главной передаче волнистое (передачи ложатся на повороты
+    // по-разному), поэтому он стартует из нескольких значений final_drive
+    void compare(const char* title, const TuningObjective& gradient, const TuningTimeObjective& time,
+                 const F1PhysicsEngine::CarParameters& car, const std::vector<TuningBound>& bounds, int grid,
+                 const std::vector<double>& final_drive_starts) {
+        std::cout << "\n--- " << title << " ---" << std::endl;
+        std::cout << std::fixed;
+        
+        auto start = std::chrono::steady_clock::now();
+        TuningResult sweep = sweepSetup(time, car, bounds, grid);
+        printResult("сетка", sweep, bounds, secondsSince(start));
+        
+        start = std::chrono::steady_clock::now();
+        TuningResult best;
+        int evaluations = 0;
+        for (double final_drive : final_drive_starts) {
+            F1PhysicsEngine::CarParameters from = car;
+            from.final_drive = final_drive;
+            TuningResult r = optimizeSetup(gradient, from, bounds);
+            evaluations += r.evaluations;
+            if (evaluations == r.evaluations || r.time < best.time) {
+                best = r;
+            }
+            if (!r.converged) {
+                std::cout << "  (старт " << std::setprecision(2) << final_drive << " не сошелся за "
+                          << r.iterations << " итераций)" << std::endl;
+            }
+        }
+        best.evaluations = evaluations;
+        printResult("градиент", best, bounds, secondsSince(start));
+        
+        double engine_time = time(best.car);
+        std::cout << "F1PhysicsEngine на настройке спуска: " << std::setprecision(4) << engine_time
+                  << " с (отличие от Dual " << std::scientific << std::setprecision(1) << engine_time - best.time
+                  << " с)" << std::fixed << std::endl;
+    }
+}
+
+// Градиентная настройка: чувствительности времени к параметрам машины
+// (дуальные числа, один проход) и подбор настроек спуском против сетки.
+// Запуск: f1_tune [точек сетки на ось]
+int main(int argc, char** argv) {
+    int grid = argc > 1 ? std::atoi(argv[1]) : 21;
+    
+    Track track = Track::demoCircuit();
+    F1PhysicsEngine::CarParameters car;
+    TuningConfig config;
+    
+    std::cout << "=== ЧУВСТВИТЕЛЬНОСТИ (один проход движка на Dual<" << TUNE_PARAMETER_COUNT << ">) ===" << std::endl;
+    TimeGradient acceleration = accelerationTimeGradient(car, config);
+    TimeGradient lap = lapTimeGradient(track, car, config);
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "0-200 км/ч: " << acceleration.time << " с, круг " << track.name << ": " << lap.time << " с\n";
+    std::cout << "+------------------------+--------------+--------------+\n";
+    std::cout << "| Параметр (+1%)         |  0-200 [мс]  |   Круг [мс]  |\n";
+    std::cout << "+------------------------+--------------+--------------+\n";
+    for (int p = 0; p < TUNE_PARAMETER_COUNT; p++) {
+        double one_percent = 0.01 * tuningParameter(car, p);
+        std::cout << "| " << std::left << std::setw(22) << tuningParameterName(p) << std::right << " | "
+                  << std::setw(12) << acceleration.gradient[p] * one_percent * 1000.0 << " | "
+                  << std::setw(12) << lap.gradient[p] * one_percent * 1000.0 << " |\n";
+    }
+    std::cout << "+------------------------+--------------+--------------+\n";
+    
+    // Разгон: только главная передача (Dual<1>)
+    std::vector<int> final_drive = { TUNE_FINAL_DRIVE };
+    compare("0-200 км/ч: главная передача",
+            [&](const F1PhysicsEngine::CarParameters& c) { return accelerationTimeGradient(c, config, final_drive); },
+            [&](const F1PhysicsEngine::CarParameters& c) { return accelerationTime(c, config); },
+            car, { { TUNE_FINAL_DRIVE, 2.5, 5.0 } }, grid * grid, { car.final_drive });
+    
+    // Круг: прижим стоит сопротивления (поляра C_d = 0.45 + 0.05·C_l², на C_l = -3 - как по умолчанию)
+    TuningConfig lap_config = config;
+    lap_config.induced_drag = 0.05;
+    F1PhysicsEngine::CarParameters lap_car = car;
+    lap_car.drag_coefficient = 0.45;
+    std::vector<int> lap_parameters = { TUNE_FINAL_DRIVE, TUNE_DOWNFORCE_COEFFICIENT };
+    compare("круг: главная передача и прижим",
+            [&](const F1PhysicsEngine::CarParameters& c) {
+                return lapTimeGradient(track, c, lap_config, lap_parameters);
+            },
+            [&](const F1PhysicsEngine::CarParameters& c) { return lapTime(track, c, lap_config); },
+            lap_car, { { TUNE_FINAL_DRIVE, 2.5, 5.0 }, { TUNE_DOWNFORCE_COEFFICIENT, -6.0, -1.0 } }, grid,
+            { 3.0, 3.75, 4.5 });
+    return 0;
+}